@@ -1,13 +1,20 @@
 // assets/shaders/model/model.vert
 #version 330 core
 
+// Either layout of the VBO lands in the same inputs:
+//   full:   float pos, float uv, uint16 joints, float weights
+//   packed: unorm16 pos (0..1 over the model AABB), half uv, uint8 joints, unorm8 weights
 layout(location = 0) in vec3 aPos;
 layout(location = 1) in vec2 aTex;
 
 // skinning attributes (always present in the VBO; defaults are safe)
-layout(location = 2) in uvec4 aJoints;  // uploaded as GL_UNSIGNED_SHORT via glVertexAttribIPointer
+layout(location = 2) in uvec4 aJoints;  // glVertexAttribIPointer (uint16 or uint8)
 layout(location = 3) in vec4  aWeights;
 
+// Packed position decode; offset 0 / scale 1 for the full layout.
+uniform vec3 u_PosOffset;
+uniform vec3 u_PosScale;
+
 uniform mat4 u_MVP;
 
 // skinning control
@@ -19,13 +26,88 @@ uniform int u_UseSkin;
 
 uniform mat4 u_Joints[MAX_JOINTS];
 
+// instanced path: per-instance records streamed through a texture buffer.
+// record = [model matrix][joint palette...], one mat4 = 4 RGBA32F texels (columns).
+uniform int u_Instanced;
+uniform mat4 u_ViewProj;
+uniform samplerBuffer u_InstanceData;
+uniform int u_InstanceBase;   // texel offset of instance 0's record
+uniform int u_InstanceStride; // texels per instance record
+
+// baked animation: record = [model matrix][frame A, frame B, blend, -] (8 texels); the
+// node global and joint palette come from the Model's pre-sampled frames instead.
+uniform int u_Baked;
+uniform samplerBuffer u_BakedFrames;
+uniform int u_BakedFrameStride; // texels per baked frame
+uniform int u_BakedSlotOffset;  // texel offset of this mesh slot within a frame
+
 out vec2 TexCoord;
 
+mat4 fetchMat4(int texel)
+{
+    return mat4(texelFetch(u_InstanceData, texel + 0),
+                texelFetch(u_InstanceData, texel + 1),
+                texelFetch(u_InstanceData, texel + 2),
+                texelFetch(u_InstanceData, texel + 3));
+}
+
+mat4 fetchBaked(int texel)
+{
+    return mat4(texelFetch(u_BakedFrames, texel + 0),
+                texelFetch(u_BakedFrames, texel + 1),
+                texelFetch(u_BakedFrames, texel + 2),
+                texelFetch(u_BakedFrames, texel + 3));
+}
+
+// Linear blend of the same matrix in two frames (frames are 1/30 s apart).
+mat4 fetchBakedBlend(int texelA, int texelB, float t)
+{
+    return fetchBaked(texelA) * (1.0 - t) + fetchBaked(texelB) * t;
+}
+
 void main()
 {
     TexCoord = aTex;
 
-    vec4 localPos = vec4(aPos, 1.0);
+    vec4 localPos = vec4(aPos * u_PosScale + u_PosOffset, 1.0);
+
+    if (u_Instanced == 1) {
+        int base = u_InstanceBase + gl_InstanceID * u_InstanceStride;
+
+        if (u_Baked == 1) {
+            vec4 frames = texelFetch(u_InstanceData, base + 4);
+            int a = int(frames.x) * u_BakedFrameStride + u_BakedSlotOffset;
+            int b = int(frames.y) * u_BakedFrameStride + u_BakedSlotOffset;
+            float t = frames.z;
+
+            if (u_UseSkin == 1) {
+                mat4 skinMat =
+                      aWeights.x * fetchBakedBlend(a + 4 + 4 * int(aJoints.x), b + 4 + 4 * int(aJoints.x), t)
+                    + aWeights.y * fetchBakedBlend(a + 4 + 4 * int(aJoints.y), b + 4 + 4 * int(aJoints.y), t)
+                    + aWeights.z * fetchBakedBlend(a + 4 + 4 * int(aJoints.z), b + 4 + 4 * int(aJoints.z), t)
+                    + aWeights.w * fetchBakedBlend(a + 4 + 4 * int(aJoints.w), b + 4 + 4 * int(aJoints.w), t);
+
+                localPos = skinMat * localPos;
+            }
+
+            gl_Position = u_ViewProj * fetchMat4(base) * fetchBakedBlend(a, b, t) * localPos;
+            return;
+        }
+
+        if (u_UseSkin == 1) {
+            int joints = base + 4;
+            mat4 skinMat =
+                  aWeights.x * fetchMat4(joints + 4 * int(aJoints.x))
+                + aWeights.y * fetchMat4(joints + 4 * int(aJoints.y))
+                + aWeights.z * fetchMat4(joints + 4 * int(aJoints.z))
+                + aWeights.w * fetchMat4(joints + 4 * int(aJoints.w));
+
+            localPos = skinMat * localPos;
+        }
+
+        gl_Position = u_ViewProj * fetchMat4(base) * localPos;
+        return;
+    }
 
     if (u_UseSkin == 1) {
         mat4 skinMat =
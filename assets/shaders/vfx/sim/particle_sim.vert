@@ -0,0 +1,38 @@
+// assets/shaders/vfx/sim/particle_sim.vert
+// GPU particle step (transform feedback, no rasterization). Same integration as the CPU
+// kernels (ParticleKernels.h): vel = (vel + accel * dt) * damping; pos += vel * dt.
+#version 330 core
+
+layout(location = 0) in vec3  aPos;
+layout(location = 1) in float aDeathTime;
+layout(location = 2) in vec3  aVel;
+layout(location = 3) in float aMaxLife;
+layout(location = 4) in float aSizePx;
+layout(location = 5) in float aSeed;
+layout(location = 7) in uint  aColor;
+
+uniform float u_Dt;
+uniform float u_Time;     // sim clock after this step
+uniform vec3  u_Accel;
+uniform float u_Damping;  // pow(dampingBase, dt), computed once on the CPU
+
+out vec3  vPos;
+out float vDeathTime;
+out vec3  vVel;
+out float vMaxLife;
+out float vSizePx;
+out float vSeed;
+out float vAge01;
+flat out uint vColor;
+
+void main() {
+    vVel = (aVel + u_Accel * u_Dt) * u_Damping;
+    vPos = aPos + vVel * u_Dt;
+
+    vDeathTime = aDeathTime;
+    vMaxLife   = aMaxLife;
+    vSizePx    = aSizePx;
+    vSeed      = aSeed;
+    vAge01     = clamp(1.0 - (aDeathTime - u_Time) / max(0.0001, aMaxLife), 0.0, 1.0);
+    vColor     = aColor;
+}
@@ -0,0 +1,31 @@
+// assets/shaders/vfx/tinted.frag
+// Soft round sprite tinted by the per-particle color (spores, bubbles, hit sparks).
+// Procedural only (no flipbook); outputs premultiplied alpha.
+#version 330 core
+
+in float vAge01;
+in float vSeed;
+in vec4  vColor;
+
+out vec4 FragColor;
+
+uniform float u_Time;
+
+void main() {
+    vec2 p = gl_PointCoord - vec2(0.5);
+    float r = length(p) * 2.0;
+    if (r > 1.0) discard;
+
+    // Bright core, soft edge, and a faint ring so bubbles keep an outline.
+    float core = smoothstep(1.0, 0.15, r);
+    float ring = smoothstep(0.65, 0.85, r) * smoothstep(1.0, 0.85, r);
+
+    float twinkle = 0.9 + 0.1 * sin(u_Time * 11.0 + vSeed * 43.0);
+    float fade = 1.0 - smoothstep(0.55, 1.0, vAge01);
+
+    float alpha = vColor.a * fade * twinkle * clamp(core + 0.6 * ring, 0.0, 1.0);
+    if (alpha < 0.0015) discard;
+
+    vec3 rgb = vColor.rgb * mix(1.25, 0.85, r);
+    FragColor = vec4(rgb * alpha, alpha);
+}
@@ -0,0 +1,31 @@
+// assets/shaders/vfx/tinted.vert
+#version 330 core
+
+layout(location = 0) in vec3  aPos;
+layout(location = 1) in float aAge01;
+layout(location = 2) in float aSizePx;
+layout(location = 3) in float aSeed;
+layout(location = 4) in vec4  aColor;
+
+uniform mat4  u_ViewProj;
+uniform float u_PointScale;
+
+out float vAge01;
+out float vSeed;
+out vec4  vColor;
+
+void main() {
+    vec4 clip = u_ViewProj * vec4(aPos, 1.0);
+    gl_Position = clip;
+
+    float invW = 1.0 / max(0.0001, clip.w);
+
+    // Grow a little over the lifetime so bursts read as expanding.
+    float age = clamp(aAge01, 0.0, 1.0);
+    float px = aSizePx * u_PointScale * invW * mix(0.8, 1.2, age);
+    gl_PointSize = clamp(px, 3.0, 160.0);
+
+    vAge01 = age;
+    vSeed  = aSeed;
+    vColor = aColor;
+}
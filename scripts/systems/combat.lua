@@ -132,7 +132,7 @@ local function use_charged_if_ready(id)
         emit("A critical hit!")
       end
 
-      local rem = world_apply_damage(id, tgt, dmg)
+      local rem = world_apply_damage(id, tgt, dmg, name)
 
       local eff = effectiveness(id, tgt)
       maybe_emit_effectiveness(eff)
@@ -227,7 +227,7 @@ function combat_update(dt)
               emit("A critical hit!")
             end
 
-            local rem = world_apply_damage(u.id, tgt, dmg)
+            local rem = world_apply_damage(u.id, tgt, dmg, fastName)
             world_add_energy(u.id, m.energyGain or 0)
             world_add_energy(tgt, 8)
 
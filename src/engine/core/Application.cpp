@@ -10,8 +10,12 @@
 #include "../render/Renderer.h"
 #include "../render/BoardRenderer.h"
 #include "../render/Model.h"
+#include "../render/GLStateCache.h"
+#include "../render/TextureCache.h"
+#include "../render/StreamBuffer.h"
 
 #include "../utils/ResourceManager.h"
+#include "../utils/WorkerPool.h"
 
 #include "../ui/HealthBarRenderer.h"
 #include "../ui/UIManager.h"
@@ -47,6 +51,7 @@
 #include <filesystem>
 #include <algorithm>
 #include <cmath>
+#include <cstdlib>
 #include <vector>
 
 namespace {
@@ -69,7 +74,7 @@ void Application::updateDrawableSizeAndViewport() {
     if (drawableW <= 0) drawableW = windowW;
     if (drawableH <= 0) drawableH = windowH;
 
-    glViewport(0, 0, drawableW, drawableH);
+    GLStateCache::getInstance().setViewport(0, 0, drawableW, drawableH);
 }
 
 void Application::updateMouseScale() {
@@ -147,33 +152,49 @@ void Application::preloadCommonModels() {
 
     if (!pumpPreloadEvents()) std::exit(0);
 
-    const int total = (int)modelsToPreload.size();
-    for (int i = 0; i < total; ++i) {
+    // Stream everything at once: workers parse/decode in parallel, this loop only uploads.
+    auto& resources = ResourceManager::getInstance();
+    std::vector<ModelHandle> handles;
+    handles.reserve(modelsToPreload.size());
+    for (const auto& path : modelsToPreload) handles.push_back(resources.requestModel(path));
+
+    const int total = (int)handles.size();
+    for (;;) {
         updateDrawableSizeAndViewport();
 
-        const std::string& path = modelsToPreload[i];
+        // Keep window responsive
+        if (!pumpPreloadEvents()) std::exit(0);
+
+        resources.pumpUploads(kPreloadUploadBudgetMs);
+
+        int done = 0;
+        for (const auto& h : handles) {
+            if (h.isReady() || h.isFailed()) ++done;
+        }
 
         // Option A: title progress
         window->setTitle(
             "PokemonAutochess - Loading " +
-            std::to_string(i + 1) + "/" + std::to_string(total) + "  " + path
+            std::to_string(done) + "/" + std::to_string(total)
         );
 
-        // Keep window responsive
-        if (!pumpPreloadEvents()) std::exit(0);
-
-        // Expensive load
-        ResourceManager::getInstance().getModel(path);
-
         // Update bar and present a frame
-        float progress = float(i + 1) / float(total);
+        float progress = float(done) / float(total);
         bootLoadingView.render(progress, drawableW, drawableH);
         window->swapBuffers();
+
+        if (done == total) break;
+        SDL_Delay(1);
     }
 
     window->setTitle("Pokemon Autochess");
     pumpPreloadEvents();
 
+    const auto& tex = TextureCache::getInstance().getStats();
+    std::cout << "[TextureCache] " << tex.uploads << " uploads, " << tex.hits << " shared"
+              << " | " << (tex.bytesUploaded / 1024) << " KiB uploaded, "
+              << (tex.bytesSaved / 1024) << " KiB VRAM saved\n";
+
     // --- NEW: Restore prior vsync mode for normal gameplay ---
     SDL_GL_SetSwapInterval(prevSwap);
 }
@@ -196,11 +217,19 @@ void Application::init() {
         std::exit(EXIT_FAILURE);
     }
 
+    // Seed the render state shadow copy; from here on draw paths change state through it.
+    GLStateCache::getInstance().syncFromGL();
+
+    // Before any model streams in: cache loads pick BC or RGBA8 payloads from this.
+    TextureCache::detectCompressionSupport();
+    // Particle vertex rings map persistently when GL_ARB_buffer_storage is there.
+    StreamBuffer::detectPersistentMappingSupport();
+
     // Ensure viewport matches drawable size from the start.
     updateDrawableSizeAndViewport();
     updateMouseScale();
 
-    glEnable(GL_DEPTH_TEST);
+    GLStateCache::getInstance().enable(GL_DEPTH_TEST);
 
     // NEW: create boot loading view now that GL is ready
     bootLoadingView.init();
@@ -320,6 +349,13 @@ void Application::run() {
             if (stateManager) stateManager->handleInput(event);
         }
 
+        // New frame: poses sampled during update + draw below share one cache generation.
+        Model::beginPoseCacheFrame();
+        GLStateCache::getInstance().beginFrame();
+
+        // Finish models streamed in by worker threads (units pick them up in GameWorld::update).
+        ResourceManager::getInstance().pumpUploads(kModelUploadBudgetMs);
+
         auto now = clock::now();
         double frameDt = std::chrono::duration<double>(now - previous).count();
         frameDt = std::min(frameDt, 0.25);
@@ -362,7 +398,33 @@ void Application::run() {
         static double fpsTimer = 0.0;
         fpsTimer += frameDt;
         if (fpsTimer >= 1.0) {
-            std::cout << "[FPS] " << frameCount << "\n";
+            const auto& pose = Model::getGlobalPoseCacheStats();
+            const auto& glStats = GLStateCache::getInstance().getLastFrameStats();
+            std::cout << "[FPS] " << frameCount
+                      << "  pose cache hit/miss " << pose.hits << "/" << pose.misses
+                      << "  socket chain evals " << pose.socketChainEvals
+                      << "  gl state changes/skipped per frame " << glStats.changes << "/" << glStats.skipped;
+            if (gameWorld) {
+                const auto& rq = gameWorld->getRenderStats();
+                std::cout << "  unit tris per frame " << rq.triangles << " (LOD0 " << rq.trianglesLod0 << ")";
+                const auto& cs = gameWorld->getCullStats();
+                std::cout << "  drawn/culled units " << cs.unitsDrawn << "/" << cs.unitsCulled
+                          << " bars " << cs.healthBarsDrawn << "/" << cs.healthBarsCulled
+                          << " particles " << cs.particlesDrawn << "/" << cs.particlesCulled
+                          << " (" << gameWorld->getVfxStats().drawCalls << " draws)"
+                          << " sorted " << gameWorld->getVfxStats().sorted
+                          << " (" << gameWorld->getVfxStats().sortMs << " ms)";
+                const auto& ae = gameWorld->getAnimEvalStats();
+                std::cout << "  baked/live units " << ae.baked << "/" << ae.live;
+            }
+            const auto& stream = StreamBuffer::getGlobalStats();
+            std::cout << "  particle upload " << (stream.bytesUploaded / 1024) << " KB/s"
+                      << (StreamBuffer::persistentMappingSupported() ? " (persistent)" : " (orphan)")
+                      << " stalls " << stream.stalls << " (" << stream.stallMs << " ms)"
+                      << " ring grows " << stream.reallocs;
+            std::cout << "\n";
+            Model::resetGlobalPoseCacheStats();
+            StreamBuffer::resetGlobalStats();
             frameCount = 0;
             fpsTimer = 0.0;
         }
@@ -379,9 +441,16 @@ void Application::shutdown() {
 
     UIManager::shutdown();
 
+    // Workers may still be decoding; stop them before the models (and GL) go away.
+    ResourceManager::getInstance().shutdown();
+    WorkerPool::getInstance().shutdown();
+
     stateManager.reset();
     gameWorld.reset();
     camera.reset();
+
+    // Cached models and static card frames still hold textures; they go with the context.
+    TextureCache::getInstance().shutdown();
     window.reset();
 
     SystemRegistry::getInstance().clear();
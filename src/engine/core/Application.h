@@ -37,6 +37,10 @@ private:
 
     static constexpr float TIME_STEP = 1.0f / 60.0f;
 
+    // Main-thread GL upload budget for streamed models (per frame / per boot-screen frame).
+    static constexpr double kModelUploadBudgetMs   = 2.0;
+    static constexpr double kPreloadUploadBudgetMs = 12.0;
+
     std::unique_ptr<Renderer> renderer;
     std::unique_ptr<Camera3D> camera;
     std::unique_ptr<GameStateManager> stateManager;
@@ -0,0 +1,277 @@
+// src/engine/render/AnimCompress.cpp
+
+#include "AnimCompress.h"
+
+#include <algorithm>
+#include <cmath>
+
+using pac_model_types::AnimationChannel;
+using pac_model_types::AnimationClip;
+using pac_model_types::AnimationSampler;
+using pac_model_types::ChannelPath;
+using pac_model_types::Interpolation;
+using pac_model_types::NodeTRS;
+using pac_model_types::Quat48;
+using pac_model_types::SamplerFormat;
+
+namespace pac_anim_compress {
+
+namespace {
+
+// Rotation error is the angle between the two rotations (q and -q are the same one).
+float rotationError(const glm::vec4& a, const glm::vec4& b)
+{
+    const glm::vec4 na = glm::normalize(a);
+    glm::vec4 nb = glm::normalize(b);
+    if (glm::dot(na, nb) < 0.0f) nb = -nb;
+    // The chord between unit quaternions is 2 sin(angle / 4); asin stays precise near 0.
+    const float chord = glm::length(na - nb);
+    return 4.0f * std::asin((std::min)(0.5f * chord, 1.0f));
+}
+
+float trackError(ChannelPath path, const glm::vec4& a, const glm::vec4& b)
+{
+    if (path == ChannelPath::Rotation) return rotationError(a, b);
+    return glm::length(glm::vec3(a) - glm::vec3(b));
+}
+
+// What the runtime sampler returns between two linear keys (see sampleAtKey).
+glm::vec4 lerpKeys(ChannelPath path, const glm::vec4& v0, glm::vec4 v1, float a)
+{
+    if (path != ChannelPath::Rotation) return glm::mix(v0, v1, a);
+    if (glm::dot(v0, v1) < 0.0f) v1 = -v1;
+    return glm::normalize(glm::mix(v0, v1, a));
+}
+
+glm::vec4 restValue(ChannelPath path, const NodeTRS& n)
+{
+    switch (path) {
+        case ChannelPath::Rotation: return glm::vec4(n.r.x, n.r.y, n.r.z, n.r.w);
+        case ChannelPath::Scale:    return glm::vec4(n.s, 0.0f);
+        case ChannelPath::Translation:
+        default:                    return glm::vec4(n.t, 0.0f);
+    }
+}
+
+// Keys a linear track needs: grow each segment from the last kept key until skipping the
+// keys inside it would miss one of the originals by more than tol. Between original keys
+// both curves are linear, so checking at the original keys bounds the whole segment.
+std::vector<size_t> reduceLinear(ChannelPath path, const std::vector<float>& times,
+                                 const std::vector<glm::vec4>& original,
+                                 const std::vector<glm::vec4>& quantized, float tol)
+{
+    const size_t n = times.size();
+    std::vector<size_t> keep{ 0 };
+    size_t anchor = 0;
+
+    for (size_t end = 2; end < n; ++end) {
+        const float t0 = times[anchor];
+        const float span = times[end] - t0;
+        bool fits = true;
+        for (size_t k = anchor + 1; k < end && fits; ++k) {
+            const float a = (span > 0.0f) ? (times[k] - t0) / span : 0.0f;
+            fits = trackError(path, lerpKeys(path, quantized[anchor], quantized[end], a), original[k]) <= tol;
+        }
+        if (!fits) {
+            anchor = end - 1;
+            keep.push_back(anchor);
+        }
+    }
+    if (n > 1) keep.push_back(n - 1);
+    return keep;
+}
+
+// Step tracks hold each key until the next, so a key that repeats the held value is dead.
+std::vector<size_t> reduceStep(ChannelPath path, const std::vector<glm::vec4>& original,
+                               const std::vector<glm::vec4>& quantized, float tol)
+{
+    std::vector<size_t> keep{ 0 };
+    for (size_t k = 1; k < original.size(); ++k) {
+        if (trackError(path, quantized[keep.back()], original[k]) > tol) keep.push_back(k);
+    }
+    return keep;
+}
+
+} // namespace
+
+Quat48 encodeQuat48(const glm::vec4& qIn)
+{
+    constexpr float kInvRange = 1.41421356f; // sqrt(2)
+
+    glm::vec4 q = glm::normalize(qIn);
+    int largest = 0;
+    for (int i = 1; i < 4; ++i) {
+        if (std::fabs(q[i]) > std::fabs(q[largest])) largest = i;
+    }
+    // q and -q are the same rotation; keep the dropped component positive.
+    if (q[largest] < 0.0f) q = -q;
+
+    uint64_t bits = (uint64_t)largest << 45;
+    int shift = 30;
+    for (int i = 0; i < 4; ++i) {
+        if (i == largest) continue;
+        const float unit = (std::clamp)(q[i] * kInvRange * 0.5f + 0.5f, 0.0f, 1.0f);
+        bits |= (uint64_t)std::lround(unit * 32767.0f) << shift;
+        shift -= 15;
+    }
+
+    Quat48 out;
+    out.v[0] = (uint16_t)(bits >> 32);
+    out.v[1] = (uint16_t)(bits >> 16);
+    out.v[2] = (uint16_t)bits;
+    return out;
+}
+
+uint64_t samplerBytes(const AnimationSampler& s)
+{
+    return s.inputs.size() * sizeof(float)
+         + s.outputs.size() * sizeof(glm::vec4)
+         + s.outputs3.size() * sizeof(glm::vec3)
+         + s.outputsQ.size() * sizeof(Quat48)
+         + (s.inTangents.size() + s.outTangents.size()) * sizeof(glm::vec4);
+}
+
+ClipStats compressClip(AnimationClip& clip, const std::vector<NodeTRS>& nodeDefaults,
+                       const std::vector<float>& parentScale, const Tolerances& tol)
+{
+    ClipStats st{};
+
+    // Per sampler: the path it drives and the tightest tolerance among its channels.
+    // Samplers shared between paths (or unused) are left alone.
+    struct Use {
+        int   path = -1;
+        bool  mixed = false;
+        float tol = 0.0f;
+    };
+    std::vector<Use> uses(clip.samplers.size());
+    for (const AnimationChannel& ch : clip.channels) {
+        if (ch.samplerIndex < 0 || ch.samplerIndex >= (int)clip.samplers.size()) continue;
+        Use& u = uses[(size_t)ch.samplerIndex];
+
+        float chTol = (ch.path == ChannelPath::Rotation) ? tol.rotation
+                    : (ch.path == ChannelPath::Scale)    ? tol.scale
+                                                         : tol.translation;
+        if (ch.path == ChannelPath::Translation && ch.targetNode >= 0 && ch.targetNode < (int)parentScale.size()) {
+            const float ps = parentScale[(size_t)ch.targetNode];
+            if (ps > 0.0f) chTol /= ps;
+        }
+
+        if (u.path < 0) {
+            u.path = (int)ch.path;
+            u.tol = chTol;
+        } else {
+            u.mixed |= (u.path != (int)ch.path);
+            u.tol = (std::min)(u.tol, chTol);
+        }
+    }
+
+    std::vector<char> constant(clip.samplers.size(), 0);
+    for (size_t si = 0; si < clip.samplers.size(); ++si) {
+        AnimationSampler& s = clip.samplers[si];
+        st.rawBytes   += samplerBytes(s);
+        st.keysBefore += (uint32_t)s.inputs.size();
+
+        const Use& u = uses[si];
+        const ChannelPath path = (ChannelPath)u.path;
+        const bool eligible = u.path >= 0 && !u.mixed
+                           && s.format == SamplerFormat::Vec4
+                           && s.interpolation != Interpolation::CubicSpline
+                           && !s.inputs.empty() && s.outputs.size() == s.inputs.size()
+                           && s.isVec4 == (path == ChannelPath::Rotation);
+        if (!eligible) {
+            st.keysAfter += (uint32_t)s.inputs.size();
+            continue;
+        }
+
+        // Reduce against what the runtime will actually decode, so quantization error is
+        // part of the budget.
+        std::vector<glm::vec4> quantized(s.outputs.size());
+        for (size_t k = 0; k < s.outputs.size(); ++k) {
+            quantized[k] = (path == ChannelPath::Rotation) ? decodeQuat48(encodeQuat48(s.outputs[k]))
+                                                           : s.outputs[k];
+        }
+
+        bool isConstant = true;
+        for (size_t k = 1; k < s.outputs.size() && isConstant; ++k) {
+            isConstant = trackError(path, quantized[0], s.outputs[k]) <= u.tol;
+        }
+
+        std::vector<size_t> keep;
+        if (isConstant) {
+            keep.push_back(0);
+            constant[si] = 1;
+            ++st.constantTracks;
+        } else if (s.interpolation == Interpolation::Step) {
+            keep = reduceStep(path, s.outputs, quantized, u.tol);
+        } else {
+            keep = reduceLinear(path, s.inputs, s.outputs, quantized, u.tol);
+        }
+
+        std::vector<float> inputs;
+        inputs.reserve(keep.size());
+        for (size_t k : keep) inputs.push_back(s.inputs[k]);
+
+        if (path == ChannelPath::Rotation) {
+            s.outputsQ.clear();
+            s.outputsQ.reserve(keep.size());
+            for (size_t k : keep) s.outputsQ.push_back(encodeQuat48(s.outputs[k]));
+            s.format = SamplerFormat::Quat48;
+        } else {
+            s.outputs3.clear();
+            s.outputs3.reserve(keep.size());
+            for (size_t k : keep) s.outputs3.push_back(glm::vec3(s.outputs[k]));
+            s.format = SamplerFormat::Vec3;
+        }
+        s.inputs = std::move(inputs);
+        s.outputs.clear();
+        s.outputs.shrink_to_fit();
+        st.keysAfter += (uint32_t)s.inputs.size();
+    }
+
+    // Constant channels that restate the node's rest value do nothing; drop them, then
+    // any sampler no channel references any more.
+    std::vector<AnimationChannel> channels;
+    channels.reserve(clip.channels.size());
+    for (const AnimationChannel& ch : clip.channels) {
+        const bool inRange = ch.samplerIndex >= 0 && ch.samplerIndex < (int)clip.samplers.size()
+                          && ch.targetNode >= 0 && ch.targetNode < (int)nodeDefaults.size();
+        if (inRange && constant[(size_t)ch.samplerIndex] && !nodeDefaults[(size_t)ch.targetNode].hasMatrix) {
+            const AnimationSampler& s = clip.samplers[(size_t)ch.samplerIndex];
+            const glm::vec4 v = (s.format == SamplerFormat::Quat48) ? decodeQuat48(s.outputsQ[0])
+                                                                     : glm::vec4(s.outputs3[0], 0.0f);
+            const glm::vec4 rest = restValue(ch.path, nodeDefaults[(size_t)ch.targetNode]);
+            if (trackError(ch.path, v, rest) <= uses[(size_t)ch.samplerIndex].tol) {
+                ++st.channelsRemoved;
+                continue;
+            }
+        }
+        channels.push_back(ch);
+    }
+
+    if (st.channelsRemoved > 0) {
+        std::vector<int> remap(clip.samplers.size(), -1);
+        for (const AnimationChannel& ch : channels) {
+            if (ch.samplerIndex >= 0 && ch.samplerIndex < (int)clip.samplers.size()) remap[(size_t)ch.samplerIndex] = 0;
+        }
+
+        std::vector<AnimationSampler> samplers;
+        for (size_t si = 0; si < clip.samplers.size(); ++si) {
+            if (remap[si] < 0) {
+                st.keysAfter -= (uint32_t)clip.samplers[si].inputs.size();
+                continue;
+            }
+            remap[si] = (int)samplers.size();
+            samplers.push_back(std::move(clip.samplers[si]));
+        }
+        for (AnimationChannel& ch : channels) {
+            if (ch.samplerIndex >= 0 && ch.samplerIndex < (int)remap.size()) ch.samplerIndex = remap[(size_t)ch.samplerIndex];
+        }
+        clip.samplers = std::move(samplers);
+    }
+    clip.channels = std::move(channels);
+
+    for (const AnimationSampler& s : clip.samplers) st.compressedBytes += samplerBytes(s);
+    return st;
+}
+
+} // namespace pac_anim_compress
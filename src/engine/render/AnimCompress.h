@@ -0,0 +1,67 @@
+// src/engine/render/AnimCompress.h
+//
+// Cook-time animation clip compression. CPU only.
+// Constant tracks collapse to a single key (and are dropped when they only restate the
+// node's rest value), linear/step tracks lose every key that interpolation reproduces
+// within tolerance, and what is left is re-encoded: translation/scale as vec3, rotation
+// as 48-bit smallest-three quaternions. Cubic-spline tracks are left as loaded.
+#pragma once
+
+#include "ModelAnimationTypes.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace pac_anim_compress {
+
+struct Tolerances {
+    float translation = 1e-4f; // model units (divided by the parent's scale per channel)
+    float rotation    = 5e-4f; // radians
+    float scale       = 1e-4f; // absolute, per component
+};
+
+struct ClipStats {
+    uint64_t rawBytes = 0;        // samplers as loaded (inputs, vec4 outputs, tangents)
+    uint64_t compressedBytes = 0; // samplers as written
+    uint32_t keysBefore = 0;
+    uint32_t keysAfter = 0;
+    uint32_t constantTracks = 0;
+    uint32_t channelsRemoved = 0;
+};
+
+// Compresses clip in place. nodeDefaults are the rest-pose locals; parentScale[node] is
+// the largest axis scale of the node's parent in model space (1 for roots), so translation
+// error is bounded in model units. Nodes with a matrix never lose channels.
+ClipStats compressClip(pac_model_types::AnimationClip& clip,
+                       const std::vector<pac_model_types::NodeTRS>& nodeDefaults,
+                       const std::vector<float>& parentScale,
+                       const Tolerances& tol);
+
+uint64_t samplerBytes(const pac_model_types::AnimationSampler& s);
+
+// q is x, y, z, w (the sampler output order); need not be normalized.
+pac_model_types::Quat48 encodeQuat48(const glm::vec4& q);
+
+inline glm::vec4 decodeQuat48(const pac_model_types::Quat48& q)
+{
+    constexpr float kInvMax = 1.0f / 32767.0f;
+    constexpr float kRange  = 0.70710678f; // 1/sqrt(2)
+
+    const uint64_t bits = ((uint64_t)q.v[0] << 32) | ((uint64_t)q.v[1] << 16) | (uint64_t)q.v[2];
+    const int largest = (int)((bits >> 45) & 3u);
+    const float a = ((float)((bits >> 30) & 0x7FFFu) * kInvMax * 2.0f - 1.0f) * kRange;
+    const float b = ((float)((bits >> 15) & 0x7FFFu) * kInvMax * 2.0f - 1.0f) * kRange;
+    const float c = ((float)(bits & 0x7FFFu) * kInvMax * 2.0f - 1.0f) * kRange;
+    const float d = std::sqrt((std::max)(0.0f, 1.0f - a * a - b * b - c * c));
+
+    switch (largest) {
+        case 0:  return glm::vec4(d, a, b, c);
+        case 1:  return glm::vec4(a, d, b, c);
+        case 2:  return glm::vec4(a, b, d, c);
+        default: return glm::vec4(a, b, c, d);
+    }
+}
+
+} // namespace pac_anim_compress
@@ -6,6 +6,7 @@
 #include <sstream>
 #include <iostream>
 #include "../utils/ShaderLibrary.h"
+#include "GLStateCache.h"
 
 BoardRenderer::BoardRenderer(int rows, int cols, float cellSize)
     : rows(rows), cols(cols), cellSize(cellSize)
@@ -23,7 +24,7 @@ BoardRenderer::BoardRenderer(int rows, int cols, float cellSize)
     std::vector<float> allVertices = gridVertices;
     allVertices.insert(allVertices.end(), benchVertices.begin(), benchVertices.end()); // NEW
 
-    glBindVertexArray(vao);
+    GLStateCache::getInstance().bindVertexArray(vao);
     glBindBuffer(GL_ARRAY_BUFFER, vbo);
     glBufferData(GL_ARRAY_BUFFER, allVertices.size() * sizeof(float), allVertices.data(), GL_STATIC_DRAW);
 
@@ -37,17 +38,17 @@ BoardRenderer::~BoardRenderer() {
 
 void BoardRenderer::draw(const Camera3D& camera) {
     gridShader->use();
-    glm::mat4 mvp = camera.getProjectionMatrix() * camera.getViewMatrix() * glm::mat4(1.0f);
+    const glm::mat4& mvp = camera.getViewProjectionMatrix();
     glUniformMatrix4fv(mvpLocation, 1, GL_FALSE, &mvp[0][0]);
-    glBindVertexArray(vao);
+    GLStateCache::getInstance().bindVertexArray(vao);
     glDrawArrays(GL_LINES, 0, (GLsizei)(gridVertices.size() / 3));
 }
 
 void BoardRenderer::drawBench(const Camera3D& camera) {
     gridShader->use();
-    glm::mat4 mvp = camera.getProjectionMatrix() * camera.getViewMatrix() * glm::mat4(1.0f);
+    const glm::mat4& mvp = camera.getViewProjectionMatrix();
     glUniformMatrix4fv(mvpLocation, 1, GL_FALSE, &mvp[0][0]);
-    glBindVertexArray(vao);
+    GLStateCache::getInstance().bindVertexArray(vao);
 
     size_t benchOffset = gridVertices.size() / 3;
     size_t benchCount = benchVertices.size() / 3;
@@ -56,7 +57,7 @@ void BoardRenderer::drawBench(const Camera3D& camera) {
 
 void BoardRenderer::shutdown() {
     glDeleteBuffers(1, &vbo);
-    glDeleteVertexArrays(1, &vao);
+    GLStateCache::getInstance().deleteVertexArrays(1, &vao);
     gridShader.reset();
 }
 
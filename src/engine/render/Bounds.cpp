@@ -0,0 +1,87 @@
+// src/engine/render/Bounds.cpp
+
+#include "Bounds.h"
+
+#include <cstdlib>
+#include <string>
+
+Aabb Aabb::transformed(const glm::mat4& m) const
+{
+    if (isEmpty()) return {};
+
+    // Arvo: the new half extents are |M| applied to the old ones.
+    const glm::vec3 c = glm::vec3(m * glm::vec4(center(), 1.0f));
+    const glm::vec3 e = extents();
+    glm::vec3 r(0.0f);
+    for (int col = 0; col < 3; ++col) {
+        r += glm::abs(glm::vec3(m[col])) * e[col];
+    }
+
+    Aabb out;
+    out.min = c - r;
+    out.max = c + r;
+    return out;
+}
+
+Frustum Frustum::fromViewProjection(const glm::mat4& vp)
+{
+    // Gribb/Hartmann: each plane is the fourth row plus or minus another row (GL clip space).
+    const glm::vec4 row0(vp[0][0], vp[1][0], vp[2][0], vp[3][0]);
+    const glm::vec4 row1(vp[0][1], vp[1][1], vp[2][1], vp[3][1]);
+    const glm::vec4 row2(vp[0][2], vp[1][2], vp[2][2], vp[3][2]);
+    const glm::vec4 row3(vp[0][3], vp[1][3], vp[2][3], vp[3][3]);
+
+    Frustum f;
+    f.planes[0] = row3 + row0;
+    f.planes[1] = row3 - row0;
+    f.planes[2] = row3 + row1;
+    f.planes[3] = row3 - row1;
+    f.planes[4] = row3 + row2;
+    f.planes[5] = row3 - row2;
+
+    for (auto& p : f.planes) {
+        const float len = glm::length(glm::vec3(p));
+        if (len > 0.0f) p /= len;
+    }
+    return f;
+}
+
+bool Frustum::containsPoint(const glm::vec3& p) const
+{
+    for (const auto& pl : planes) {
+        if (glm::dot(glm::vec3(pl), p) + pl.w < 0.0f) return false;
+    }
+    return true;
+}
+
+bool Frustum::intersectsSphere(const glm::vec3& center, float radius) const
+{
+    for (const auto& pl : planes) {
+        if (glm::dot(glm::vec3(pl), center) + pl.w < -radius) return false;
+    }
+    return true;
+}
+
+bool Frustum::intersectsAabb(const Aabb& box) const
+{
+    if (box.isEmpty()) return false;
+
+    // Reject when the corner furthest along a plane's normal is still behind it.
+    for (const auto& pl : planes) {
+        const glm::vec3 n(pl);
+        const glm::vec3 pv(n.x >= 0.0f ? box.max.x : box.min.x,
+                           n.y >= 0.0f ? box.max.y : box.min.y,
+                           n.z >= 0.0f ? box.max.z : box.min.z);
+        if (glm::dot(n, pv) + pl.w < 0.0f) return false;
+    }
+    return true;
+}
+
+bool Frustum::isCullingEnabled()
+{
+    static const bool enabled = [] {
+        const char* env = std::getenv("PAC_DISABLE_CULLING");
+        return !(env && *env && std::string(env) != "0");
+    }();
+    return enabled;
+}
@@ -0,0 +1,50 @@
+// src/engine/render/Bounds.h
+//
+// Axis-aligned boxes and view frustums for CPU culling. No GL.
+#pragma once
+
+#include <limits>
+
+#include <glm/glm.hpp>
+
+struct Aabb {
+    // Default-constructed boxes are empty; expanding one by a point makes it that point.
+    glm::vec3 min{ std::numeric_limits<float>::max() };
+    glm::vec3 max{ -std::numeric_limits<float>::max() };
+
+    bool isEmpty() const { return min.x > max.x; }
+
+    void expand(const glm::vec3& p)
+    {
+        min = glm::min(min, p);
+        max = glm::max(max, p);
+    }
+    void expand(const Aabb& b)
+    {
+        if (b.isEmpty()) return;
+        min = glm::min(min, b.min);
+        max = glm::max(max, b.max);
+    }
+
+    glm::vec3 center() const { return 0.5f * (min + max); }
+    glm::vec3 extents() const { return 0.5f * (max - min); }
+
+    // Box around this box after an affine transform (exact for the transformed corners).
+    Aabb transformed(const glm::mat4& m) const;
+};
+
+// Six inward-facing planes (xyz = unit normal, w = distance), extracted from a
+// view-projection matrix: left, right, bottom, top, near, far.
+struct Frustum {
+    glm::vec4 planes[6];
+
+    static Frustum fromViewProjection(const glm::mat4& viewProj);
+
+    bool containsPoint(const glm::vec3& p) const;
+    bool intersectsSphere(const glm::vec3& center, float radius) const;
+    // Conservative: a box near a frustum corner may pass while lying just outside.
+    bool intersectsAabb(const Aabb& box) const;
+
+    // CPU culling against camera frustums; PAC_DISABLE_CULLING=1 draws everything.
+    static bool isCullingEnabled();
+};
@@ -17,20 +17,24 @@ Camera3D::Camera3D(float fovDeg, float aspect, float nearPlane, float farPlane)
 
 void Camera3D::setPosition(const glm::vec3& pos) {
     position = pos;
+    matricesDirty = true;
 }
 
 void Camera3D::lookAt(const glm::vec3& tgt, const glm::vec3& up) {
     target = tgt;
     upVector = up;
+    matricesDirty = true;
 }
 
 void Camera3D::move(const glm::vec3& delta) {
     position += delta;
     target += delta;
+    matricesDirty = true;
 }
 
 void Camera3D::zoom(float delta) {
     position += glm::normalize(target - position) * delta;
+    matricesDirty = true;
 }
 
 void Camera3D::orbit(float yawDeltaRad, float pitchDeltaRad) {
@@ -61,14 +65,35 @@ void Camera3D::orbit(float yawDeltaRad, float pitchDeltaRad) {
     newOffset.y = r * sp;
 
     position = target + newOffset;
+    matricesDirty = true;
 }
 
-glm::mat4 Camera3D::getViewMatrix() const {
-    return glm::lookAt(position, target, upVector);
+void Camera3D::updateMatrices() const {
+    view = glm::lookAt(position, target, upVector);
+    projection = glm::perspective(fov, aspectRatio, nearZ, farZ);
+    viewProjection = projection * view;
+    frustum = Frustum::fromViewProjection(viewProjection);
+    matricesDirty = false;
 }
 
-glm::mat4 Camera3D::getProjectionMatrix() const {
-    return glm::perspective(fov, aspectRatio, nearZ, farZ);
+const glm::mat4& Camera3D::getViewMatrix() const {
+    if (matricesDirty) updateMatrices();
+    return view;
+}
+
+const glm::mat4& Camera3D::getProjectionMatrix() const {
+    if (matricesDirty) updateMatrices();
+    return projection;
+}
+
+const glm::mat4& Camera3D::getViewProjectionMatrix() const {
+    if (matricesDirty) updateMatrices();
+    return viewProjection;
+}
+
+const Frustum& Camera3D::getFrustum() const {
+    if (matricesDirty) updateMatrices();
+    return frustum;
 }
 
 glm::vec3 Camera3D::getDirection() const {
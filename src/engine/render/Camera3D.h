@@ -5,6 +5,8 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
+#include "Bounds.h"
+
 class Camera3D {
 public:
     Camera3D(float fovDeg, float aspect, float nearPlane, float farPlane);
@@ -20,9 +22,17 @@ public:
     // pitchDeltaRad: rotate up/down
     void orbit(float yawDeltaRad, float pitchDeltaRad);
 
-    glm::mat4 getViewMatrix() const;
-    glm::mat4 getProjectionMatrix() const;
+    // View/projection, their product and the frustum planes are rebuilt lazily, once
+    // per camera change, rather than on every call.
+    const glm::mat4& getViewMatrix() const;
+    const glm::mat4& getProjectionMatrix() const;
+    const glm::mat4& getViewProjectionMatrix() const;
+    const Frustum&   getFrustum() const;
     glm::vec3 getDirection() const;
+    const glm::vec3& getPosition() const { return position; }
+
+    float getNearPlane() const { return nearZ; }
+    float getFarPlane() const { return farZ; }
 
 private:
     glm::vec3 position;
@@ -33,4 +43,12 @@ private:
     float aspectRatio;
     float nearZ;
     float farZ;
+
+    mutable bool      matricesDirty = true;
+    mutable glm::mat4 view{1.0f};
+    mutable glm::mat4 projection{1.0f};
+    mutable glm::mat4 viewProjection{1.0f};
+    mutable Frustum   frustum{};
+
+    void updateMatrices() const;
 };
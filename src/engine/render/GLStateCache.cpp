@@ -0,0 +1,304 @@
+// src/engine/render/GLStateCache.cpp
+
+#include "GLStateCache.h"
+
+#include <initializer_list>
+
+GLStateCache& GLStateCache::getInstance()
+{
+    static GLStateCache instance;
+    return instance;
+}
+
+uint8_t GLStateCache::capBit(GLenum cap)
+{
+    switch (cap) {
+        case GL_BLEND:              return CapBlend;
+        case GL_DEPTH_TEST:         return CapDepthTest;
+        case GL_CULL_FACE:          return CapCullFace;
+        case GL_PROGRAM_POINT_SIZE: return CapPointSize;
+        default:                    return 0;
+    }
+}
+
+void GLStateCache::syncFromGL()
+{
+    state = State{};
+    known = Known{};
+
+    for (GLenum cap : { GL_BLEND, GL_DEPTH_TEST, GL_CULL_FACE, GL_PROGRAM_POINT_SIZE }) {
+        if (glIsEnabled(cap)) state.caps |= capBit(cap);
+        known.caps |= capBit(cap);
+    }
+
+    GLboolean depthWrite = GL_TRUE;
+    glGetBooleanv(GL_DEPTH_WRITEMASK, &depthWrite);
+    state.depthWrite = (depthWrite == GL_TRUE);
+    known.depthWrite = true;
+
+    GLint v = 0;
+    glGetIntegerv(GL_BLEND_SRC_RGB, &v);   state.blendSrcRGB = (GLenum)v;
+    glGetIntegerv(GL_BLEND_DST_RGB, &v);   state.blendDstRGB = (GLenum)v;
+    glGetIntegerv(GL_BLEND_SRC_ALPHA, &v); state.blendSrcA   = (GLenum)v;
+    glGetIntegerv(GL_BLEND_DST_ALPHA, &v); state.blendDstA   = (GLenum)v;
+    known.blendFunc = true;
+
+    glGetIntegerv(GL_BLEND_EQUATION_RGB, &v);   state.blendEqRGB = (GLenum)v;
+    glGetIntegerv(GL_BLEND_EQUATION_ALPHA, &v); state.blendEqA   = (GLenum)v;
+    known.blendEq = true;
+
+    glGetIntegerv(GL_ACTIVE_TEXTURE, &v);
+    state.activeUnit = v - (GLint)GL_TEXTURE0;
+    known.activeUnit = true;
+
+    glGetIntegerv(GL_CURRENT_PROGRAM, &v);      state.program = (GLuint)v; known.program = true;
+    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &v); state.vao     = (GLuint)v; known.vao     = true;
+
+    glGetIntegerv(GL_VIEWPORT, state.viewport);
+    known.viewport = true;
+
+    // Texture bindings are left unknown: the first bind per unit always reaches GL.
+}
+
+void GLStateCache::invalidate()
+{
+    known = Known{};
+}
+
+void GLStateCache::setEnabled(GLenum cap, bool enabled)
+{
+    const uint8_t bit = capBit(cap);
+    if (bit == 0) {
+        // Not tracked: pass through.
+        if (enabled) glEnable(cap);
+        else glDisable(cap);
+        ++frame.changes;
+        return;
+    }
+
+    if ((known.caps & bit) && ((state.caps & bit) != 0) == enabled) {
+        ++frame.skipped;
+        return;
+    }
+
+    if (enabled) glEnable(cap);
+    else glDisable(cap);
+
+    if (enabled) state.caps |= bit;
+    else state.caps &= (uint8_t)~bit;
+    known.caps |= bit;
+    ++frame.changes;
+}
+
+bool GLStateCache::isEnabled(GLenum cap) const
+{
+    const uint8_t bit = capBit(cap);
+    if (bit == 0 || !(known.caps & bit)) return glIsEnabled(cap) == GL_TRUE;
+    return (state.caps & bit) != 0;
+}
+
+void GLStateCache::setDepthMask(bool write)
+{
+    if (known.depthWrite && state.depthWrite == write) {
+        ++frame.skipped;
+        return;
+    }
+    glDepthMask(write ? GL_TRUE : GL_FALSE);
+    state.depthWrite = write;
+    known.depthWrite = true;
+    ++frame.changes;
+}
+
+void GLStateCache::setBlendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcA, GLenum dstA)
+{
+    if (known.blendFunc &&
+        state.blendSrcRGB == srcRGB && state.blendDstRGB == dstRGB &&
+        state.blendSrcA == srcA && state.blendDstA == dstA) {
+        ++frame.skipped;
+        return;
+    }
+    glBlendFuncSeparate(srcRGB, dstRGB, srcA, dstA);
+    state.blendSrcRGB = srcRGB;
+    state.blendDstRGB = dstRGB;
+    state.blendSrcA   = srcA;
+    state.blendDstA   = dstA;
+    known.blendFunc = true;
+    ++frame.changes;
+}
+
+void GLStateCache::setBlendEquationSeparate(GLenum modeRGB, GLenum modeA)
+{
+    if (known.blendEq && state.blendEqRGB == modeRGB && state.blendEqA == modeA) {
+        ++frame.skipped;
+        return;
+    }
+    glBlendEquationSeparate(modeRGB, modeA);
+    state.blendEqRGB = modeRGB;
+    state.blendEqA   = modeA;
+    known.blendEq = true;
+    ++frame.changes;
+}
+
+void GLStateCache::setActiveTexture(int unit)
+{
+    if (known.activeUnit && state.activeUnit == unit) {
+        ++frame.skipped;
+        return;
+    }
+    glActiveTexture((GLenum)(GL_TEXTURE0 + unit));
+    state.activeUnit = unit;
+    known.activeUnit = true;
+    ++frame.changes;
+}
+
+GLuint* GLStateCache::textureSlot(int unit, GLenum target, bool*& isKnown)
+{
+    if (unit < 0 || unit >= kMaxTextureUnits) return nullptr;
+    switch (target) {
+        case GL_TEXTURE_2D:     isKnown = &known.tex2D[unit];     return &state.tex2D[unit];
+        case GL_TEXTURE_BUFFER: isKnown = &known.texBuffer[unit]; return &state.texBuffer[unit];
+        default:                return nullptr;
+    }
+}
+
+void GLStateCache::bindTexture(GLenum target, GLuint tex)
+{
+    bool* isKnown = nullptr;
+    GLuint* slot = known.activeUnit ? textureSlot(state.activeUnit, target, isKnown) : nullptr;
+
+    if (slot && *isKnown && *slot == tex) {
+        ++frame.skipped;
+        return;
+    }
+
+    glBindTexture(target, tex);
+    if (slot) {
+        *slot = tex;
+        *isKnown = true;
+    }
+    ++frame.changes;
+}
+
+void GLStateCache::bindTexture(int unit, GLenum target, GLuint tex)
+{
+    bool* isKnown = nullptr;
+    GLuint* slot = textureSlot(unit, target, isKnown);
+    if (slot && *isKnown && *slot == tex) {
+        ++frame.skipped;
+        return;
+    }
+
+    setActiveTexture(unit);
+    bindTexture(target, tex);
+}
+
+void GLStateCache::useProgram(GLuint program)
+{
+    if (known.program && state.program == program) {
+        ++frame.skipped;
+        return;
+    }
+    glUseProgram(program);
+    state.program = program;
+    known.program = true;
+    ++frame.changes;
+}
+
+void GLStateCache::bindVertexArray(GLuint vao)
+{
+    if (known.vao && state.vao == vao) {
+        ++frame.skipped;
+        return;
+    }
+    glBindVertexArray(vao);
+    state.vao = vao;
+    known.vao = true;
+    ++frame.changes;
+}
+
+void GLStateCache::deleteTextures(GLsizei n, const GLuint* textures)
+{
+    for (GLsizei i = 0; i < n; ++i) {
+        const GLuint t = textures[i];
+        if (t == 0) continue;
+        for (int u = 0; u < kMaxTextureUnits; ++u) {
+            if (state.tex2D[u] == t)     state.tex2D[u] = 0;
+            if (state.texBuffer[u] == t) state.texBuffer[u] = 0;
+        }
+    }
+    glDeleteTextures(n, textures);
+}
+
+void GLStateCache::deleteVertexArrays(GLsizei n, const GLuint* vaos)
+{
+    for (GLsizei i = 0; i < n; ++i) {
+        if (vaos[i] != 0 && state.vao == vaos[i]) state.vao = 0;
+    }
+    glDeleteVertexArrays(n, vaos);
+}
+
+void GLStateCache::deleteProgram(GLuint program)
+{
+    // A deleted program stays in use until another one is bound, but its name can be reused.
+    if (program != 0 && state.program == program) known.program = false;
+    glDeleteProgram(program);
+}
+
+void GLStateCache::setViewport(GLint x, GLint y, GLsizei w, GLsizei h)
+{
+    if (known.viewport &&
+        state.viewport[0] == x && state.viewport[1] == y &&
+        state.viewport[2] == w && state.viewport[3] == h) {
+        ++frame.skipped;
+        return;
+    }
+    glViewport(x, y, w, h);
+    state.viewport[0] = x;
+    state.viewport[1] = y;
+    state.viewport[2] = w;
+    state.viewport[3] = h;
+    known.viewport = true;
+    ++frame.changes;
+}
+
+void GLStateCache::getViewport(GLint out[4]) const
+{
+    if (!known.viewport) {
+        glGetIntegerv(GL_VIEWPORT, out);
+        return;
+    }
+    for (int i = 0; i < 4; ++i) out[i] = state.viewport[i];
+}
+
+GLStateCache::Snapshot GLStateCache::capture() const
+{
+    Snapshot s;
+    s.caps        = state.caps;
+    s.depthWrite  = state.depthWrite;
+    s.blendSrcRGB = state.blendSrcRGB;
+    s.blendDstRGB = state.blendDstRGB;
+    s.blendSrcA   = state.blendSrcA;
+    s.blendDstA   = state.blendDstA;
+    s.blendEqRGB  = state.blendEqRGB;
+    s.blendEqA    = state.blendEqA;
+    s.activeUnit  = state.activeUnit;
+    return s;
+}
+
+void GLStateCache::restore(const Snapshot& s)
+{
+    setEnabled(GL_BLEND,              (s.caps & CapBlend) != 0);
+    setEnabled(GL_DEPTH_TEST,         (s.caps & CapDepthTest) != 0);
+    setEnabled(GL_CULL_FACE,          (s.caps & CapCullFace) != 0);
+    setEnabled(GL_PROGRAM_POINT_SIZE, (s.caps & CapPointSize) != 0);
+    setDepthMask(s.depthWrite);
+    setBlendFuncSeparate(s.blendSrcRGB, s.blendDstRGB, s.blendSrcA, s.blendDstA);
+    setBlendEquationSeparate(s.blendEqRGB, s.blendEqA);
+    setActiveTexture(s.activeUnit);
+}
+
+void GLStateCache::beginFrame()
+{
+    lastFrame = frame;
+    frame = FrameStats{};
+}
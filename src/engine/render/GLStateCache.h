@@ -0,0 +1,129 @@
+// src/engine/render/GLStateCache.h
+//
+// Shadow copy of the GL state the engine touches while drawing (caps, depth mask,
+// blend func/equation, texture bindings, program, VAO, viewport).
+//
+// Every draw path changes state through this cache instead of raw gl* calls:
+//   - redundant changes are filtered out,
+//   - "save + restore" is a Snapshot copy of the shadow state (no glGet* on hot paths).
+//
+// Anything that changes this state behind the cache's back must call invalidate().
+#pragma once
+
+#include <glad/glad.h>
+
+#include <cstdint>
+
+class GLStateCache {
+public:
+    static GLStateCache& getInstance();
+
+    // Reads the real GL state once (after the context is created) so the shadow copy is exact.
+    void syncFromGL();
+    // Forgets everything: the next set* call of each kind always reaches GL.
+    void invalidate();
+
+    // ---- Capabilities (GL_BLEND, GL_DEPTH_TEST, GL_CULL_FACE, GL_PROGRAM_POINT_SIZE) ----
+    void setEnabled(GLenum cap, bool enabled);
+    void enable(GLenum cap)  { setEnabled(cap, true); }
+    void disable(GLenum cap) { setEnabled(cap, false); }
+    bool isEnabled(GLenum cap) const;
+
+    // ---- Depth / blend ----
+    void setDepthMask(bool write);
+    bool getDepthMask() const { return state.depthWrite; }
+
+    void setBlendFunc(GLenum src, GLenum dst) { setBlendFuncSeparate(src, dst, src, dst); }
+    void setBlendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcA, GLenum dstA);
+    void setBlendEquation(GLenum mode) { setBlendEquationSeparate(mode, mode); }
+    void setBlendEquationSeparate(GLenum modeRGB, GLenum modeA);
+
+    // ---- Bindings ----
+    static constexpr int kMaxTextureUnits = 8;
+
+    void setActiveTexture(int unit);               // unit index, not GL_TEXTUREn
+    int  getActiveTexture() const { return state.activeUnit; }
+    void bindTexture(GLenum target, GLuint tex);   // on the active unit
+    void bindTexture(int unit, GLenum target, GLuint tex);
+
+    void useProgram(GLuint program);
+    void bindVertexArray(GLuint vao);
+
+    // Deleting a bound object resets that binding to 0 in GL; keep the shadow in step.
+    void deleteTextures(GLsizei n, const GLuint* textures);
+    void deleteVertexArrays(GLsizei n, const GLuint* vaos);
+    void deleteProgram(GLuint program);
+
+    // ---- Viewport ----
+    void setViewport(GLint x, GLint y, GLsizei w, GLsizei h);
+    void getViewport(GLint out[4]) const;
+
+    // ---- Save / restore without glGet ----
+    // Covers caps, depth mask, blend func/equation and the active texture unit.
+    struct Snapshot {
+        uint8_t caps = 0;
+        bool    depthWrite = true;
+        GLenum  blendSrcRGB = GL_ONE, blendDstRGB = GL_ZERO, blendSrcA = GL_ONE, blendDstA = GL_ZERO;
+        GLenum  blendEqRGB = GL_FUNC_ADD, blendEqA = GL_FUNC_ADD;
+        int     activeUnit = 0;
+    };
+    Snapshot capture() const;
+    void restore(const Snapshot& s);
+
+    // ---- Per-frame counters ----
+    struct FrameStats {
+        uint64_t changes = 0; // calls that reached GL
+        uint64_t skipped = 0; // redundant calls filtered out
+    };
+
+    // Rolls the current counters into getLastFrameStats() and starts a new frame.
+    void beginFrame();
+    const FrameStats& getFrameStats() const { return frame; }
+    const FrameStats& getLastFrameStats() const { return lastFrame; }
+
+private:
+    GLStateCache() = default;
+
+    enum CapBit : uint8_t {
+        CapBlend      = 1 << 0,
+        CapDepthTest  = 1 << 1,
+        CapCullFace   = 1 << 2,
+        CapPointSize  = 1 << 3,
+    };
+    static uint8_t capBit(GLenum cap);
+
+    struct State {
+        uint8_t caps = 0;
+        bool    depthWrite = true;
+        GLenum  blendSrcRGB = GL_ONE, blendDstRGB = GL_ZERO, blendSrcA = GL_ONE, blendDstA = GL_ZERO;
+        GLenum  blendEqRGB = GL_FUNC_ADD, blendEqA = GL_FUNC_ADD;
+        int     activeUnit = 0;
+        GLuint  tex2D[kMaxTextureUnits] = {};
+        GLuint  texBuffer[kMaxTextureUnits] = {};
+        GLuint  program = 0;
+        GLuint  vao = 0;
+        GLint   viewport[4] = {0, 0, 0, 0};
+    };
+
+    // Which parts of State are trustworthy (false after invalidate()).
+    struct Known {
+        uint8_t caps = 0;
+        bool depthWrite = false;
+        bool blendFunc = false;
+        bool blendEq = false;
+        bool activeUnit = false;
+        bool tex2D[kMaxTextureUnits] = {};
+        bool texBuffer[kMaxTextureUnits] = {};
+        bool program = false;
+        bool vao = false;
+        bool viewport = false;
+    };
+
+    GLuint* textureSlot(int unit, GLenum target, bool*& known);
+
+    State state;
+    Known known;
+
+    FrameStats frame;
+    FrameStats lastFrame;
+};
@@ -0,0 +1,192 @@
+// src/engine/render/IndexOptimizer.cpp
+
+#include "IndexOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+
+namespace pac_index_opt {
+
+namespace {
+
+constexpr int   kCacheSize         = 32; // modelled LRU size while optimizing
+constexpr float kLastTriScore      = 0.75f;
+constexpr float kCacheDecayPower   = 1.5f;
+constexpr float kValenceBoostScale = 2.0f;
+constexpr float kValenceBoostPower = 0.5f;
+
+float vertexScore(int cachePos, uint32_t remainingValence)
+{
+    if (remainingValence == 0) return -1.0f; // no triangles left to use it
+
+    float score = 0.0f;
+    if (cachePos >= 0) {
+        if (cachePos < 3) {
+            // Just used by the last triangle: fixed score so strips don't win by default.
+            score = kLastTriScore;
+        } else {
+            const float scaler = 1.0f / (float)(kCacheSize - 3);
+            score = std::pow(1.0f - (float)(cachePos - 3) * scaler, kCacheDecayPower);
+        }
+    }
+
+    // Favour vertices with few triangles left, so lone triangles don't get stranded.
+    score += kValenceBoostScale * std::pow((float)remainingValence, -kValenceBoostPower);
+    return score;
+}
+
+} // namespace
+
+void optimizeVertexCache(uint32_t* indices, size_t indexCount, size_t vertexCount)
+{
+    const size_t triCount = indexCount / 3;
+    if (triCount < 2 || vertexCount == 0) return;
+
+    // Vertex -> triangle adjacency (CSR).
+    std::vector<uint32_t> valence(vertexCount, 0);
+    for (size_t i = 0; i < triCount * 3; ++i) ++valence[indices[i]];
+
+    std::vector<uint32_t> adjStart(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; ++v) adjStart[v + 1] = adjStart[v] + valence[v];
+
+    std::vector<uint32_t> adj(triCount * 3);
+    {
+        std::vector<uint32_t> fill(adjStart.begin(), adjStart.end() - 1);
+        for (size_t t = 0; t < triCount; ++t) {
+            for (int k = 0; k < 3; ++k) adj[fill[indices[t * 3 + k]]++] = (uint32_t)t;
+        }
+    }
+
+    // Remaining (not yet emitted) triangles per vertex live in adj[adjStart[v] .. + remaining[v]).
+    std::vector<uint32_t> remaining = valence;
+    std::vector<int>      cachePos(vertexCount, -1);
+    std::vector<float>    vScore(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v) vScore[v] = vertexScore(-1, remaining[v]);
+
+    std::vector<float> tScore(triCount);
+    std::vector<char>  emitted(triCount, 0);
+    for (size_t t = 0; t < triCount; ++t) {
+        tScore[t] = vScore[indices[t * 3]] + vScore[indices[t * 3 + 1]] + vScore[indices[t * 3 + 2]];
+    }
+
+    std::vector<uint32_t> out;
+    out.reserve(triCount * 3);
+
+    std::vector<uint32_t> cache, nextCache;
+    cache.reserve(kCacheSize + 3);
+    nextCache.reserve(kCacheSize + 3);
+
+    size_t scanCursor = 0;
+    int64_t best = -1;
+
+    for (size_t emittedCount = 0; emittedCount < triCount; ++emittedCount) {
+        if (best < 0) {
+            // Nothing adjacent to the cache: take the best remaining triangle.
+            float bestScore = -1.0f;
+            while (scanCursor < triCount && emitted[scanCursor]) ++scanCursor;
+            for (size_t t = scanCursor; t < triCount; ++t) {
+                if (!emitted[t] && tScore[t] > bestScore) {
+                    bestScore = tScore[t];
+                    best = (int64_t)t;
+                }
+            }
+        }
+
+        const uint32_t tri = (uint32_t)best;
+        emitted[tri] = 1;
+        const uint32_t* tv = indices + (size_t)tri * 3;
+        out.insert(out.end(), tv, tv + 3);
+
+        // Drop the triangle from its vertices' remaining lists.
+        for (int k = 0; k < 3; ++k) {
+            const uint32_t v = tv[k];
+            uint32_t* list = adj.data() + adjStart[v];
+            uint32_t& n = remaining[v];
+            for (uint32_t i = 0; i < n; ++i) {
+                if (list[i] == tri) { list[i] = list[n - 1]; --n; break; }
+            }
+        }
+
+        // New cache: this triangle's vertices first, then the old cache minus duplicates.
+        nextCache.assign(tv, tv + 3);
+        for (uint32_t v : cache) {
+            if (v != tv[0] && v != tv[1] && v != tv[2]) nextCache.push_back(v);
+        }
+
+        // Evicted vertices leave the cache.
+        for (size_t i = kCacheSize; i < nextCache.size(); ++i) {
+            cachePos[nextCache[i]] = -1;
+            vScore[nextCache[i]] = vertexScore(-1, remaining[nextCache[i]]);
+        }
+        if (nextCache.size() > (size_t)kCacheSize) {
+            // Rescore evicted vertices' triangles before dropping them from the list.
+            for (size_t i = kCacheSize; i < nextCache.size(); ++i) {
+                const uint32_t v = nextCache[i];
+                for (uint32_t a = 0; a < remaining[v]; ++a) {
+                    const uint32_t t = adj[adjStart[v] + a];
+                    tScore[t] = vScore[indices[t * 3]] + vScore[indices[t * 3 + 1]] + vScore[indices[t * 3 + 2]];
+                }
+            }
+            nextCache.resize(kCacheSize);
+        }
+        cache.swap(nextCache);
+
+        for (size_t i = 0; i < cache.size(); ++i) {
+            cachePos[cache[i]] = (int)i;
+            vScore[cache[i]] = vertexScore((int)i, remaining[cache[i]]);
+        }
+
+        // Rescore triangles touching the cache and pick the next one among them.
+        best = -1;
+        float bestScore = -1.0f;
+        for (uint32_t v : cache) {
+            for (uint32_t a = 0; a < remaining[v]; ++a) {
+                const uint32_t t = adj[adjStart[v] + a];
+                const float s = vScore[indices[t * 3]] + vScore[indices[t * 3 + 1]] + vScore[indices[t * 3 + 2]];
+                tScore[t] = s;
+                if (s > bestScore) {
+                    bestScore = s;
+                    best = (int64_t)t;
+                }
+            }
+        }
+    }
+
+    std::copy(out.begin(), out.end(), indices);
+}
+
+std::vector<uint32_t> buildFetchRemap(const uint32_t* indices, size_t indexCount, size_t vertexCount)
+{
+    constexpr uint32_t kUnset = ~0u;
+    std::vector<uint32_t> remap(vertexCount, kUnset);
+
+    uint32_t next = 0;
+    for (size_t i = 0; i < indexCount; ++i) {
+        uint32_t& r = remap[indices[i]];
+        if (r == kUnset) r = next++;
+    }
+    for (auto& r : remap) {
+        if (r == kUnset) r = next++;
+    }
+    return remap;
+}
+
+float computeACMR(const uint32_t* indices, size_t indexCount, uint32_t cacheSize)
+{
+    const size_t triCount = indexCount / 3;
+    if (triCount == 0) return 0.0f;
+
+    std::deque<uint32_t> fifo;
+    size_t misses = 0;
+    for (size_t i = 0; i < triCount * 3; ++i) {
+        const uint32_t v = indices[i];
+        if (std::find(fifo.begin(), fifo.end(), v) != fifo.end()) continue;
+        ++misses;
+        fifo.push_back(v);
+        if (fifo.size() > cacheSize) fifo.pop_front();
+    }
+    return (float)misses / (float)triCount;
+}
+
+} // namespace pac_index_opt
@@ -0,0 +1,27 @@
+// src/engine/render/IndexOptimizer.h
+//
+// Cook-time index/vertex ordering for GPU caches. CPU only, no GL.
+//   - optimizeVertexCache: reorders triangles for post-transform cache hits
+//     (Forsyth's linear-speed greedy scheme).
+//   - buildFetchRemap:     orders vertices by first use, for pre-transform fetch locality.
+//   - computeACMR:         average cache miss ratio (transformed vertices per triangle)
+//     under a FIFO cache, the usual yardstick for the above.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace pac_index_opt {
+
+// In place; indices are a triangle list referencing [0, vertexCount).
+void optimizeVertexCache(uint32_t* indices, size_t indexCount, size_t vertexCount);
+
+// remap[old] = new. Referenced vertices come first in order of first use, then the
+// unreferenced ones in their original order.
+std::vector<uint32_t> buildFetchRemap(const uint32_t* indices, size_t indexCount, size_t vertexCount);
+
+// 0.5 is the best a regular mesh can do, 3.0 means no reuse at all.
+float computeACMR(const uint32_t* indices, size_t indexCount, uint32_t cacheSize = 16);
+
+} // namespace pac_index_opt
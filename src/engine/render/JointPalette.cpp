@@ -0,0 +1,204 @@
+// src/engine/render/JointPalette.cpp
+
+#include "JointPalette.h"
+
+#include <chrono>
+
+#if PAC_SIMD_X86
+    #include <immintrin.h>
+#endif
+
+namespace pac_joint_palette {
+
+namespace {
+
+// ---- Scalar ----
+
+void buildScalar(const glm::mat4& invMesh,
+                 const glm::mat4* nodeGlobals, std::size_t nodeCount,
+                 const int* joints, const glm::mat4* inverseBind,
+                 std::size_t jointCount, glm::mat4* out)
+{
+    for (std::size_t i = 0; i < jointCount; ++i) {
+        const int j = joints[i];
+        if (j < 0 || (std::size_t)j >= nodeCount) {
+            out[i] = glm::mat4(1.0f);
+            continue;
+        }
+        out[i] = invMesh * nodeGlobals[j] * inverseBind[i];
+    }
+}
+
+#if PAC_SIMD_X86
+
+// ---- SSE ----
+// Column-major: column c of (A * B) = sum_k A.col[k] * B[c][k].
+
+inline void mul4x4SSE(const __m128 a[4], const float* b, float* out)
+{
+    for (int c = 0; c < 4; ++c) {
+        const float* bc = b + c * 4;
+        __m128 r =            _mm_mul_ps(a[0], _mm_set1_ps(bc[0]));
+        r = _mm_add_ps(r, _mm_mul_ps(a[1], _mm_set1_ps(bc[1])));
+        r = _mm_add_ps(r, _mm_mul_ps(a[2], _mm_set1_ps(bc[2])));
+        r = _mm_add_ps(r, _mm_mul_ps(a[3], _mm_set1_ps(bc[3])));
+        _mm_storeu_ps(out + c * 4, r);
+    }
+}
+
+void buildSSE(const glm::mat4& invMesh,
+              const glm::mat4* nodeGlobals, std::size_t nodeCount,
+              const int* joints, const glm::mat4* inverseBind,
+              std::size_t jointCount, glm::mat4* out)
+{
+    const float* inv = &invMesh[0][0];
+    const __m128 invCols[4] = {
+        _mm_loadu_ps(inv + 0), _mm_loadu_ps(inv + 4), _mm_loadu_ps(inv + 8), _mm_loadu_ps(inv + 12)
+    };
+
+    alignas(16) float tmp[16];
+
+    for (std::size_t i = 0; i < jointCount; ++i) {
+        const int j = joints[i];
+        if (j < 0 || (std::size_t)j >= nodeCount) {
+            out[i] = glm::mat4(1.0f);
+            continue;
+        }
+
+        // tmp = invMesh * global
+        mul4x4SSE(invCols, &nodeGlobals[j][0][0], tmp);
+
+        // out = tmp * inverseBind
+        const __m128 tmpCols[4] = {
+            _mm_load_ps(tmp + 0), _mm_load_ps(tmp + 4), _mm_load_ps(tmp + 8), _mm_load_ps(tmp + 12)
+        };
+        mul4x4SSE(tmpCols, &inverseBind[i][0][0], &out[i][0][0]);
+    }
+}
+
+// ---- AVX2 + FMA ----
+// Two output columns per 256-bit register: A's columns are duplicated into both
+// lanes, and _mm256_permute_ps broadcasts element k of each B column within its lane.
+
+PAC_SIMD_TARGET_AVX2
+inline void mul4x4AVX2(const __m256 a[4], const float* b, float* out)
+{
+    for (int c = 0; c < 4; c += 2) {
+        const __m256 bc = _mm256_loadu_ps(b + c * 4);
+        __m256 r = _mm256_mul_ps(a[0], _mm256_permute_ps(bc, 0x00));
+        r = _mm256_fmadd_ps(a[1], _mm256_permute_ps(bc, 0x55), r);
+        r = _mm256_fmadd_ps(a[2], _mm256_permute_ps(bc, 0xAA), r);
+        r = _mm256_fmadd_ps(a[3], _mm256_permute_ps(bc, 0xFF), r);
+        _mm256_storeu_ps(out + c * 4, r);
+    }
+}
+
+PAC_SIMD_TARGET_AVX2
+void buildAVX2(const glm::mat4& invMesh,
+               const glm::mat4* nodeGlobals, std::size_t nodeCount,
+               const int* joints, const glm::mat4* inverseBind,
+               std::size_t jointCount, glm::mat4* out)
+{
+    const float* inv = &invMesh[0][0];
+    const __m256 invCols[4] = {
+        _mm256_broadcast_ps(reinterpret_cast<const __m128*>(inv + 0)),
+        _mm256_broadcast_ps(reinterpret_cast<const __m128*>(inv + 4)),
+        _mm256_broadcast_ps(reinterpret_cast<const __m128*>(inv + 8)),
+        _mm256_broadcast_ps(reinterpret_cast<const __m128*>(inv + 12))
+    };
+
+    alignas(32) float tmp[16];
+
+    for (std::size_t i = 0; i < jointCount; ++i) {
+        const int j = joints[i];
+        if (j < 0 || (std::size_t)j >= nodeCount) {
+            out[i] = glm::mat4(1.0f);
+            continue;
+        }
+
+        mul4x4AVX2(invCols, &nodeGlobals[j][0][0], tmp);
+
+        const __m256 tmpCols[4] = {
+            _mm256_broadcast_ps(reinterpret_cast<const __m128*>(tmp + 0)),
+            _mm256_broadcast_ps(reinterpret_cast<const __m128*>(tmp + 4)),
+            _mm256_broadcast_ps(reinterpret_cast<const __m128*>(tmp + 8)),
+            _mm256_broadcast_ps(reinterpret_cast<const __m128*>(tmp + 12))
+        };
+        mul4x4AVX2(tmpCols, &inverseBind[i][0][0], &out[i][0][0]);
+    }
+}
+
+#endif // PAC_SIMD_X86
+
+} // namespace
+
+void build(Path path,
+           const glm::mat4& invMesh,
+           const glm::mat4* nodeGlobals, std::size_t nodeCount,
+           const int* joints,
+           const glm::mat4* inverseBind,
+           std::size_t jointCount,
+           glm::mat4* out)
+{
+    if (jointCount == 0) return;
+
+#if PAC_SIMD_X86
+    if (path == Path::AVX2 && pac_simd::isPathSupported(Path::AVX2)) {
+        buildAVX2(invMesh, nodeGlobals, nodeCount, joints, inverseBind, jointCount, out);
+        return;
+    }
+    if (path == Path::SSE || path == Path::AVX2) {
+        buildSSE(invMesh, nodeGlobals, nodeCount, joints, inverseBind, jointCount, out);
+        return;
+    }
+#endif
+    buildScalar(invMesh, nodeGlobals, nodeCount, joints, inverseBind, jointCount, out);
+}
+
+std::vector<BenchResult> benchmark(std::size_t jointCount, int iterations)
+{
+    using clock = std::chrono::steady_clock;
+
+    std::vector<BenchResult> results;
+    if (jointCount == 0 || iterations <= 0) return results;
+
+    // Deterministic, non-trivial inputs.
+    auto makeMat = [](std::size_t seed) {
+        glm::mat4 m(1.0f);
+        for (int c = 0; c < 4; ++c)
+            for (int r = 0; r < 4; ++r)
+                m[c][r] = (float)((seed * 31u + (std::size_t)(c * 4 + r) * 7u) % 97u) / 97.0f - 0.5f;
+        return m;
+    };
+
+    std::vector<glm::mat4> globals(jointCount);
+    std::vector<glm::mat4> inverseBind(jointCount);
+    std::vector<int> joints(jointCount);
+    for (std::size_t i = 0; i < jointCount; ++i) {
+        globals[i]     = makeMat(i + 1);
+        inverseBind[i] = makeMat(i + 1000);
+        joints[i]      = (int)((i * 7u) % jointCount);
+    }
+    const glm::mat4 invMesh = makeMat(4242);
+
+    Mat4Buffer out(jointCount);
+
+    for (Path p : { Path::Scalar, Path::SSE, Path::AVX2 }) {
+        BenchResult r{};
+        r.path = p;
+        r.supported = pac_simd::isPathSupported(p);
+        if (r.supported) {
+            auto t0 = clock::now();
+            for (int it = 0; it < iterations; ++it) {
+                build(p, invMesh, globals.data(), globals.size(), joints.data(),
+                      inverseBind.data(), jointCount, out.data());
+            }
+            const double sec = std::chrono::duration<double>(clock::now() - t0).count();
+            r.matricesPerSec = (sec > 0.0) ? (double)jointCount * (double)iterations / sec : 0.0;
+        }
+        results.push_back(r);
+    }
+    return results;
+}
+
+} // namespace pac_joint_palette
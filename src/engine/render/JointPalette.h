@@ -0,0 +1,53 @@
+// src/engine/render/JointPalette.h
+//
+// Batched joint-palette builder for skinning:
+//     out[i] = invMesh * nodeGlobals[joints[i]] * inverseBind[i]
+//
+// SSE and AVX2 kernels with a scalar fallback, picked at runtime through pac_simd
+// (engine/utils/SimdDispatch.h); every path produces the same column-major glm::mat4 layout.
+#pragma once
+
+#include "engine/utils/SimdDispatch.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace pac_joint_palette {
+
+using pac_simd::Path;
+
+// 32-byte aligned palette buffers (keeps each matrix within as few cache lines as possible).
+using Mat4Buffer = std::vector<glm::mat4, pac_simd::AlignedAllocator<glm::mat4>>;
+
+// Builds jointCount matrices into out. Joints that index outside nodeGlobals get identity.
+void build(Path path,
+           const glm::mat4& invMesh,
+           const glm::mat4* nodeGlobals, std::size_t nodeCount,
+           const int* joints,
+           const glm::mat4* inverseBind,
+           std::size_t jointCount,
+           glm::mat4* out);
+
+inline void build(const glm::mat4& invMesh,
+                  const glm::mat4* nodeGlobals, std::size_t nodeCount,
+                  const int* joints,
+                  const glm::mat4* inverseBind,
+                  std::size_t jointCount,
+                  glm::mat4* out)
+{
+    build(pac_simd::bestAvailablePath(), invMesh, nodeGlobals, nodeCount, joints, inverseBind, jointCount, out);
+}
+
+struct BenchResult {
+    Path   path = Path::Scalar;
+    bool   supported = false;
+    double matricesPerSec = 0.0;
+};
+
+// Times every supported path on synthetic data (jointCount joints, repeated iterations times).
+std::vector<BenchResult> benchmark(std::size_t jointCount, int iterations);
+
+} // namespace pac_joint_palette
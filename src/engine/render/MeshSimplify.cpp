@@ -0,0 +1,308 @@
+// src/engine/render/MeshSimplify.cpp
+
+#include "MeshSimplify.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+#include <glm/glm.hpp>
+
+using pac_model_types::Vertex;
+
+namespace pac_mesh_simplify {
+
+namespace {
+
+// Skinned collapses: refuse when more than half the weight moves to other joints, and
+// charge the rest as (delta * kSkinPenalty * extent) of error.
+constexpr float kMaxSkinDelta = 0.5f;
+constexpr float kSkinPenalty  = 0.1f;
+constexpr int   kMaxPasses    = 64;
+
+struct Quadric {
+    double a00 = 0, a01 = 0, a02 = 0, a11 = 0, a12 = 0, a22 = 0;
+    double b0 = 0, b1 = 0, b2 = 0, c = 0;
+    double w = 0; // summed triangle area, so error() is a mean squared distance
+
+    void addPlane(const glm::dvec3& n, double d, double weight)
+    {
+        a00 += weight * n.x * n.x; a01 += weight * n.x * n.y; a02 += weight * n.x * n.z;
+        a11 += weight * n.y * n.y; a12 += weight * n.y * n.z; a22 += weight * n.z * n.z;
+        b0  += weight * n.x * d;   b1  += weight * n.y * d;   b2  += weight * n.z * d;
+        c   += weight * d * d;
+        w   += weight;
+    }
+
+    void add(const Quadric& q)
+    {
+        a00 += q.a00; a01 += q.a01; a02 += q.a02; a11 += q.a11; a12 += q.a12; a22 += q.a22;
+        b0 += q.b0; b1 += q.b1; b2 += q.b2; c += q.c; w += q.w;
+    }
+
+    double error(const glm::dvec3& p) const
+    {
+        const double e = a00 * p.x * p.x + 2 * a01 * p.x * p.y + 2 * a02 * p.x * p.z
+                       + a11 * p.y * p.y + 2 * a12 * p.y * p.z + a22 * p.z * p.z
+                       + 2 * (b0 * p.x + b1 * p.y + b2 * p.z) + c;
+        return (w > 0.0) ? std::fabs(e) / w : 0.0;
+    }
+};
+
+struct Skin {
+    uint16_t joint[4];
+    float    weight[4];
+};
+
+// Half the L1 distance between two joint->weight maps (0 = same skinning, 1 = disjoint).
+float skinDelta(const Skin& a, const Skin& b)
+{
+    uint16_t joint[8];
+    float    diff[8];
+    int n = 0;
+    auto accumulate = [&](const Skin& s, float sign) {
+        for (int i = 0; i < 4; ++i) {
+            if (s.weight[i] <= 0.0f) continue;
+            int k = 0;
+            while (k < n && joint[k] != s.joint[i]) ++k;
+            if (k == n) { joint[n] = s.joint[i]; diff[n] = 0.0f; ++n; }
+            diff[k] += sign * s.weight[i];
+        }
+    };
+    accumulate(a, 1.0f);
+    accumulate(b, -1.0f);
+
+    float sum = 0.0f;
+    for (int k = 0; k < n; ++k) sum += std::fabs(diff[k]);
+    return 0.5f * sum;
+}
+
+uint64_t edgeKey(uint32_t a, uint32_t b)
+{
+    if (a > b) std::swap(a, b);
+    return ((uint64_t)a << 32) | b;
+}
+
+struct Collapse {
+    uint32_t from;
+    uint32_t to;
+    double   error;
+};
+
+} // namespace
+
+Result simplify(const uint32_t* indices, size_t indexCount, const std::vector<Vertex>& vertices,
+                size_t targetIndexCount, float maxError)
+{
+    Result out;
+    out.indices.assign(indices, indices + indexCount - indexCount % 3);
+    if (out.indices.size() <= targetIndexCount || out.indices.empty()) return out;
+
+    // ---- Local wedges (referenced vertices) and welded positions ----
+    std::unordered_map<uint32_t, uint32_t> wedgeOf;
+    std::vector<uint32_t> wedgeGlobal;
+    std::vector<uint32_t> tris(out.indices.size());
+    for (size_t i = 0; i < out.indices.size(); ++i) {
+        auto [it, inserted] = wedgeOf.emplace(out.indices[i], (uint32_t)wedgeGlobal.size());
+        if (inserted) wedgeGlobal.push_back(out.indices[i]);
+        tris[i] = it->second;
+    }
+
+    struct PosKey {
+        uint32_t x, y, z;
+        bool operator==(const PosKey& o) const { return x == o.x && y == o.y && z == o.z; }
+    };
+    struct PosHash {
+        size_t operator()(const PosKey& k) const { return (size_t)(k.x * 73856093u ^ k.y * 19349663u ^ k.z * 83492791u); }
+    };
+
+    std::unordered_map<PosKey, uint32_t, PosHash> canonOf;
+    std::vector<uint32_t>   wedgeCanon(wedgeGlobal.size());
+    std::vector<glm::dvec3> pos;
+    std::vector<Skin>       skin;
+    std::vector<uint32_t>   canonWedges; // wedge count per position; > 1 => attribute seam
+
+    glm::dvec3 lo(0.0), hi(0.0);
+    for (size_t w = 0; w < wedgeGlobal.size(); ++w) {
+        const Vertex& v = vertices[wedgeGlobal[w]];
+        PosKey key;
+        std::memcpy(&key.x, &v.px, 4);
+        std::memcpy(&key.y, &v.py, 4);
+        std::memcpy(&key.z, &v.pz, 4);
+
+        auto [it, inserted] = canonOf.emplace(key, (uint32_t)pos.size());
+        if (inserted) {
+            const glm::dvec3 p(v.px, v.py, v.pz);
+            lo = pos.empty() ? p : glm::min(lo, p);
+            hi = pos.empty() ? p : glm::max(hi, p);
+            pos.push_back(p);
+            skin.push_back({ { v.j0, v.j1, v.j2, v.j3 }, { v.w0, v.w1, v.w2, v.w3 } });
+            canonWedges.push_back(0);
+        }
+        wedgeCanon[w] = it->second;
+        ++canonWedges[it->second];
+    }
+
+    const size_t canonCount = pos.size();
+    const double extent = glm::length(hi - lo);
+    const double maxErrorSq = (double)maxError * (double)maxError;
+
+    // ---- Initial quadrics ----
+    std::vector<Quadric> quadric(canonCount);
+    for (size_t t = 0; t + 2 < tris.size(); t += 3) {
+        const glm::dvec3& p0 = pos[wedgeCanon[tris[t]]];
+        const glm::dvec3& p1 = pos[wedgeCanon[tris[t + 1]]];
+        const glm::dvec3& p2 = pos[wedgeCanon[tris[t + 2]]];
+        glm::dvec3 n = glm::cross(p1 - p0, p2 - p0);
+        const double len = glm::length(n);
+        if (len <= 0.0) continue;
+        n /= len;
+        const double area = 0.5 * len;
+        for (int k = 0; k < 3; ++k) quadric[wedgeCanon[tris[t + k]]].addPlane(n, -glm::dot(n, p0), area);
+    }
+
+    std::vector<uint32_t> wedgeRemap(wedgeGlobal.size());
+    std::vector<uint8_t>  locked(canonCount), touched(canonCount);
+    std::vector<uint32_t> adjStart(canonCount + 1), adj;
+    std::vector<uint64_t> edges;
+    std::vector<Collapse> candidates;
+
+    auto triNormal = [&](const glm::dvec3& a, const glm::dvec3& b, const glm::dvec3& c) {
+        return glm::cross(b - a, c - a);
+    };
+
+    for (int pass = 0; pass < kMaxPasses && tris.size() > targetIndexCount; ++pass) {
+        const size_t triCount = tris.size() / 3;
+
+        // Vertex -> triangle adjacency in welded space.
+        std::fill(adjStart.begin(), adjStart.end(), 0);
+        for (uint32_t w : tris) ++adjStart[wedgeCanon[w] + 1];
+        for (size_t c = 0; c < canonCount; ++c) adjStart[c + 1] += adjStart[c];
+        adj.resize(tris.size());
+        {
+            std::vector<uint32_t> fill(adjStart.begin(), adjStart.end() - 1);
+            for (size_t i = 0; i < tris.size(); ++i) adj[fill[wedgeCanon[tris[i]]]++] = (uint32_t)(i / 3);
+        }
+
+        // Edges; an edge used by one triangle is an open border, by three or more non-manifold.
+        edges.clear();
+        for (size_t t = 0; t < triCount; ++t) {
+            for (int k = 0; k < 3; ++k) {
+                edges.push_back(edgeKey(wedgeCanon[tris[t * 3 + k]], wedgeCanon[tris[t * 3 + (k + 1) % 3]]));
+            }
+        }
+        std::sort(edges.begin(), edges.end());
+
+        for (size_t c = 0; c < canonCount; ++c) locked[c] = (canonWedges[c] > 1) ? 1 : 0;
+        for (size_t i = 0; i < edges.size();) {
+            size_t j = i;
+            while (j < edges.size() && edges[j] == edges[i]) ++j;
+            if (j - i != 2) {
+                locked[(uint32_t)(edges[i] >> 32)] = 1;
+                locked[(uint32_t)edges[i]] = 1;
+            }
+            i = j;
+        }
+        edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+        // Cheapest direction per edge.
+        candidates.clear();
+        for (uint64_t e : edges) {
+            const uint32_t a = (uint32_t)(e >> 32), b = (uint32_t)e;
+            if (a == b) continue;
+
+            const float sd = skinDelta(skin[a], skin[b]);
+            if (sd > kMaxSkinDelta) continue;
+            const double skinCost = std::pow((double)sd * kSkinPenalty * extent, 2.0);
+
+            Quadric q = quadric[a];
+            q.add(quadric[b]);
+
+            Collapse best{ 0, 0, -1.0 };
+            if (!locked[a]) best = { a, b, q.error(pos[b]) + skinCost };
+            if (!locked[b]) {
+                const double eb = q.error(pos[a]) + skinCost;
+                if (best.error < 0.0 || eb < best.error) best = { b, a, eb };
+            }
+            if (best.error >= 0.0 && best.error <= maxErrorSq) candidates.push_back(best);
+        }
+        if (candidates.empty()) break;
+
+        std::sort(candidates.begin(), candidates.end(),
+                  [](const Collapse& x, const Collapse& y) { return x.error < y.error; });
+
+        // Greedy, independent collapses: each touches its 1-ring, which then sits out the pass.
+        for (size_t w = 0; w < wedgeRemap.size(); ++w) wedgeRemap[w] = (uint32_t)w;
+        std::fill(touched.begin(), touched.end(), 0);
+
+        // Each collapse removes about two triangles.
+        const size_t wantRemoved = triCount - targetIndexCount / 3;
+        size_t removed = 0, applied = 0;
+
+        for (const Collapse& c : candidates) {
+            if (removed >= wantRemoved) break;
+            if (touched[c.from] || touched[c.to]) continue;
+
+            // The moving vertex has a single wedge (seams are locked); the target may have
+            // several, so all shared triangles must agree on which one it keeps.
+            uint32_t fromWedge = UINT32_MAX, toWedge = UINT32_MAX;
+            bool ok = true;
+            size_t shared = 0;
+            for (uint32_t a = adjStart[c.from]; a < adjStart[c.from + 1] && ok; ++a) {
+                const uint32_t* t = &tris[(size_t)adj[a] * 3];
+                bool hasTo = false;
+                for (int k = 0; k < 3; ++k) {
+                    if (wedgeCanon[t[k]] == c.from) fromWedge = t[k];
+                    if (wedgeCanon[t[k]] == c.to) {
+                        hasTo = true;
+                        if (toWedge == UINT32_MAX) toWedge = t[k];
+                        else if (toWedge != t[k]) ok = false;
+                    }
+                }
+                if (hasTo) { ++shared; continue; }
+
+                // Reject collapses that flip a surviving triangle.
+                glm::dvec3 p[3], q[3];
+                for (int k = 0; k < 3; ++k) {
+                    p[k] = pos[wedgeCanon[t[k]]];
+                    q[k] = (wedgeCanon[t[k]] == c.from) ? pos[c.to] : p[k];
+                }
+                const glm::dvec3 n0 = triNormal(p[0], p[1], p[2]);
+                const glm::dvec3 n1 = triNormal(q[0], q[1], q[2]);
+                if (glm::dot(n0, n1) <= 0.0) ok = false;
+            }
+            if (!ok || toWedge == UINT32_MAX || fromWedge == UINT32_MAX) continue;
+
+            wedgeRemap[fromWedge] = toWedge;
+            quadric[c.to].add(quadric[c.from]);
+            out.error = (std::max)(out.error, (float)std::sqrt(c.error));
+
+            for (uint32_t a = adjStart[c.from]; a < adjStart[c.from + 1]; ++a) {
+                const uint32_t* t = &tris[(size_t)adj[a] * 3];
+                for (int k = 0; k < 3; ++k) touched[wedgeCanon[t[k]]] = 1;
+            }
+            removed += shared;
+            ++applied;
+        }
+        if (applied == 0) break;
+
+        // Rewrite, dropping triangles that collapsed to a line.
+        size_t write = 0;
+        for (size_t t = 0; t < triCount; ++t) {
+            const uint32_t w0 = wedgeRemap[tris[t * 3]], w1 = wedgeRemap[tris[t * 3 + 1]], w2 = wedgeRemap[tris[t * 3 + 2]];
+            const uint32_t c0 = wedgeCanon[w0], c1 = wedgeCanon[w1], c2 = wedgeCanon[w2];
+            if (c0 == c1 || c1 == c2 || c0 == c2) continue;
+            tris[write++] = w0;
+            tris[write++] = w1;
+            tris[write++] = w2;
+        }
+        tris.resize(write);
+    }
+
+    out.indices.resize(tris.size());
+    for (size_t i = 0; i < tris.size(); ++i) out.indices[i] = wedgeGlobal[tris[i]];
+    return out;
+}
+
+} // namespace pac_mesh_simplify
@@ -0,0 +1,29 @@
+// src/engine/render/MeshSimplify.h
+//
+// Quadric edge-collapse simplification for cook-time LODs. CPU only.
+// Collapses move a vertex onto one of its neighbours, so a LOD is just another index list
+// over the same vertices (and shares the VBO). Vertices on open borders or UV/attribute
+// seams never move, and collapses between differently skinned vertices are penalized
+// (or refused), so simplified limbs still follow their bones.
+#pragma once
+
+#include "ModelMeshTypes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace pac_mesh_simplify {
+
+struct Result {
+    std::vector<uint32_t> indices;
+    float error = 0.0f; // largest collapse error, model units (distance)
+};
+
+// Simplifies a triangle list toward targetIndexCount without exceeding maxError (model
+// units). Stops early when no allowed collapse remains.
+Result simplify(const uint32_t* indices, size_t indexCount,
+                const std::vector<pac_model_types::Vertex>& vertices,
+                size_t targetIndexCount, float maxError);
+
+} // namespace pac_mesh_simplify
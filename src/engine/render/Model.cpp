@@ -1,7 +1,13 @@
 // src/engine/render/Model.cpp
 #include "Model.h"
+#include "GLStateCache.h"
+#include "TextureCache.h"
+#include "VertexPacking.h"
+#include "IndexOptimizer.h"
+#include "MeshSimplify.h"
 #include "ModelStartupLog.h"
 #include "../utils/ShaderLibrary.h"
+#include "../utils/WorkerPool.h"
 
 #include <iostream>
 #include <fstream>
@@ -9,6 +15,12 @@
 #include <algorithm>
 #include <type_traits>
 #include <utility>
+#include <chrono>
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
 
 #include <glad/glad.h>
 #include <glm/gtc/matrix_transform.hpp>
@@ -27,22 +39,14 @@
 
 namespace fs = std::filesystem;
 
-// Helper used by cache and runtime: detect whether a GL min filter implies mipmaps.
-bool isMipmapMinFilter(GLint minF)
+namespace {
+
+bool envDisabled(const char* name)
 {
-    switch (minF) {
-        case GL_NEAREST_MIPMAP_NEAREST:
-        case GL_NEAREST_MIPMAP_LINEAR:
-        case GL_LINEAR_MIPMAP_NEAREST:
-        case GL_LINEAR_MIPMAP_LINEAR:
-            return true;
-        default:
-            return false;
-    }
+    const char* env = std::getenv(name);
+    return env && *env && std::string(env) != "0";
 }
 
-namespace {
-
 // ---- Optional-like helpers used by ModelFastGltfLoad.inl ----
 
 template <typename T, typename = void>
@@ -116,8 +120,33 @@ glm::mat4 Model::trsToMat4(const NodeTRS& n)
 
 Model::Model(const std::string& filepath)
 {
-    loadGLTF(filepath);
+    StagedLoad staged;
+    stage(filepath, staged);
+    finishLoad(staged);
+}
+
+std::unique_ptr<Model> Model::stageLoad(const std::string& filepath, StagedLoad& out)
+{
+    std::unique_ptr<Model> model(new Model(CookOnly{}));
+    model->stage(filepath, out);
+    return model;
+}
+
+void Model::finishLoad(StagedLoad& staged)
+{
+    const auto t0 = std::chrono::steady_clock::now();
+    if (staged.ok) uploadStaged(staged);
+    loadTiming.gpuUploadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    loadTiming.totalMs = staged.stageMs + loadTiming.gpuUploadMs;
+
+    initShader();
 
+    // Drop the mapping / CPU copies now that GL owns the data.
+    staged = StagedLoad{};
+}
+
+void Model::initShader()
+{
     modelShader = ShaderLibrary::get("assets/shaders/model/model.vert", "assets/shaders/model/model.frag");
 
     locMVP     = glGetUniformLocation(modelShader->getID(), "u_MVP");
@@ -131,6 +160,23 @@ Model::Model(const std::string& filepath)
     locAlphaMode      = glGetUniformLocation(modelShader->getID(), "u_AlphaMode");
     locAlphaCutoff    = glGetUniformLocation(modelShader->getID(), "u_AlphaCutoff");
 
+    // packed vertex decode
+    locPosOffset      = glGetUniformLocation(modelShader->getID(), "u_PosOffset");
+    locPosScale       = glGetUniformLocation(modelShader->getID(), "u_PosScale");
+
+    // instancing uniforms
+    locInstanced      = glGetUniformLocation(modelShader->getID(), "u_Instanced");
+    locViewProj       = glGetUniformLocation(modelShader->getID(), "u_ViewProj");
+    locInstanceData   = glGetUniformLocation(modelShader->getID(), "u_InstanceData");
+    locInstanceBase   = glGetUniformLocation(modelShader->getID(), "u_InstanceBase");
+    locInstanceStride = glGetUniformLocation(modelShader->getID(), "u_InstanceStride");
+
+    // baked animation atlas
+    locBaked            = glGetUniformLocation(modelShader->getID(), "u_Baked");
+    locBakedFrames      = glGetUniformLocation(modelShader->getID(), "u_BakedFrames");
+    locBakedFrameStride = glGetUniformLocation(modelShader->getID(), "u_BakedFrameStride");
+    locBakedSlotOffset  = glGetUniformLocation(modelShader->getID(), "u_BakedSlotOffset");
+
     // tone mapping uniforms
     locTonemapMode = glGetUniformLocation(modelShader->getID(), "u_TonemapMode");
     locExposure    = glGetUniformLocation(modelShader->getID(), "u_Exposure");
@@ -138,6 +184,10 @@ Model::Model(const std::string& filepath)
     modelShader->use();
     if (locBaseColorTex >= 0) glUniform1i(locBaseColorTex, 0);
     if (locEmissiveTex  >= 0) glUniform1i(locEmissiveTex, 1);
+    if (locInstanceData >= 0) glUniform1i(locInstanceData, 2);
+    if (locInstanced    >= 0) glUniform1i(locInstanced, 0);
+    if (locBakedFrames  >= 0) glUniform1i(locBakedFrames, 3);
+    if (locBaked        >= 0) glUniform1i(locBaked, 0);
 
     if (locTonemapMode >= 0) glUniform1i(locTonemapMode, 1);
     if (locExposure    >= 0) glUniform1f(locExposure, 1.0f);
@@ -145,14 +195,20 @@ Model::Model(const std::string& filepath)
 
 Model::~Model()
 {
-    if (VAO) glDeleteVertexArrays(1, &VAO);
+    auto& gl = GLStateCache::getInstance();
+
+    if (VAO) gl.deleteVertexArrays(1, &VAO);
     if (VBO) glDeleteBuffers(1, &VBO);
     if (EBO) glDeleteBuffers(1, &EBO);
-
-    for (auto& sm : submeshes) {
-        if (sm.baseColorTexID) glDeleteTextures(1, &sm.baseColorTexID);
-        if (sm.emissiveTexID)  glDeleteTextures(1, &sm.emissiveTexID);
+    for (auto& chunk : instanceChunks) {
+        if (chunk.tex) gl.deleteTextures(1, &chunk.tex);
+        if (chunk.tbo) glDeleteBuffers(1, &chunk.tbo);
     }
+    if (bakedTex) gl.deleteTextures(1, &bakedTex);
+    if (bakedTbo) glDeleteBuffers(1, &bakedTbo);
+
+    // Submesh textures are shared handles; TextureCache deletes them with the last user.
+    submeshes.clear();
 
     modelShader.reset();
 }
@@ -176,14 +232,390 @@ int Model::findAnimationIndexByName(const std::string& name) const
     return -1;
 }
 
-// IMPORTANT: the .inl is written to be included inside this function body.
-void Model::loadGLTF(const std::string& filepath)
+// CPU only (any thread): cache hit or full glTF parse, then the derived layouts.
+bool Model::stage(const std::string& filepath, StagedLoad& out)
 {
-    if (tryLoadCache(filepath)) {
+    const auto t0 = std::chrono::steady_clock::now();
+    bool ok = true;
+
+    if (stageCache(filepath, out)) {
+        out.fromCache = true;
+        loadTiming.fromCache = true;
         std::cerr << "[gltf][CACHE] HIT (no parsing) for: " << filepath << "\n";
-        return;
+    } else {
+        std::cerr << "[gltf][CACHE] MISS (will parse) for: " << filepath << "\n";
+
+        CPUGeometry& geo = out.geometry;
+        ok = parseGLTF(filepath, geo);
+        if (ok) {
+            prepareGeometry(geo, true, !envDisabled("PAC_DISABLE_INDEX_OPT"), !envDisabled("PAC_DISABLE_PACKED_VERTICES"),
+                            !envDisabled("PAC_DISABLE_ANIM_BAKE"), !envDisabled("PAC_DISABLE_ANIM_COMPRESS"));
+            writeCache(filepath, geo);
+        }
+
+        const bool packed = (geo.layout == pac_model_types::VertexLayout::Packed);
+        out.vertices     = packed ? (const void*)geo.packedVertices.data() : (const void*)geo.vertices.data();
+        out.vertexCount  = geo.vertices.size();
+        out.vertexLayout = geo.layout;
+        out.vertexQuant  = geo.quant;
+        out.indexData    = geo.indexBuffer.data();
+        out.indexBytes   = geo.indexBuffer.size();
+        out.bakedFrames      = geo.bakedFrames.data();
+        out.bakedMatrixCount = geo.bakedFrames.size();
+
+        auto view = [](const CPUTexture& t) {
+            StagedLoad::Texture v;
+            v.width = t.width;  v.height = t.height;
+            v.wrapS = t.wrapS;  v.wrapT = t.wrapT;
+            v.minF  = t.minF;   v.magF  = t.magF;
+            v.pixels = t.rgba.empty() ? nullptr : t.rgba.data();
+            return v;
+        };
+        out.textures.clear();
+        out.textures.reserve(submeshes.size() * 2);
+        for (size_t i = 0; i < submeshes.size(); ++i) {
+            out.textures.push_back(view(geo.baseColorTextures[i]));
+            out.textures.push_back(view(geo.emissiveTextures[i]));
+        }
+        if (ok) std::cerr << "[gltf][FASTGLTF] COMPLETE for: " << filepath << "\n";
     }
-    std::cerr << "[gltf][CACHE] MISS (will parse) for: " << filepath << "\n";
 
+    // Content hashes for TextureCache, computed here so the GL thread only looks them up.
+    for (auto& t : out.textures) {
+        if (t.pixels) t.hash = TextureCache::hashPixels(t.desc(), t.pixels);
+    }
+
+    // Built even when parsing failed so an empty Model still has valid (empty) ranges.
+    buildSkinPaletteLayout();
+    buildSubmeshRanges();
+    buildLodSelection();
+
+    out.ok = ok;
+    out.stageMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    return ok;
+}
+
+// IMPORTANT: the .inl is written to be included inside this function body.
+bool Model::parseGLTF(const std::string& filepath, CPUGeometry& out)
+{
     #include "ModelFastGltfLoad.inl"
 }
+
+void Model::uploadStaged(const StagedLoad& staged)
+{
+    vertexLayout = staged.vertexLayout;
+    vertexQuant  = staged.vertexQuant;
+    uploadVertexArrays(staged.vertices, staged.vertexCount, staged.vertexLayout, staged.indexData, staged.indexBytes);
+    uploadBakedFrames(staged.bakedFrames, staged.bakedMatrixCount);
+
+    // Identical images (and the 1x1 placeholders) collapse to one GL texture, within this
+    // model and across models.
+    auto& cache = TextureCache::getInstance();
+    auto upload = [&cache](const StagedLoad::Texture& t) {
+        return cache.acquire(t.desc(), t.pixels, t.hash);
+    };
+    for (size_t i = 0; i < submeshes.size() && 2 * i + 1 < staged.textures.size(); ++i) {
+        submeshes[i].baseColorTex = upload(staged.textures[2 * i + 0]);
+        submeshes[i].emissiveTex  = upload(staged.textures[2 * i + 1]);
+    }
+
+    GLStateCache::getInstance().bindTexture(GL_TEXTURE_2D, 0);
+}
+
+Model::VertexLayoutBench Model::benchmarkVertexLayouts(const std::string& filepath, int iterations)
+{
+    VertexLayoutBench r{};
+
+    Model model{CookOnly{}};
+    CPUGeometry geo;
+    if (!model.parseGLTF(filepath, geo)) return r;
+
+    r.vertexCount = (uint32_t)geo.vertices.size();
+    r.fullBytes   = (uint64_t)geo.vertices.size() * sizeof(Vertex);
+
+    packVertices(geo);
+    r.packable = (geo.layout == pac_model_types::VertexLayout::Packed);
+    if (r.packable) {
+        r.packedBytes = (uint64_t)geo.packedVertices.size() * sizeof(pac_model_types::PackedVertex);
+        r.maxPositionError = pac_vertex_packing::maxPositionError(geo.vertices, geo.packedVertices, geo.quant);
+    }
+
+    GLuint vbo = 0;
+    glGenBuffers(1, &vbo);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+
+    // glFinish after each upload so the driver's copy is inside the timed region.
+    const int n = (std::max)(1, iterations);
+    auto timeUploads = [&](const void* data, size_t bytes) {
+        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)bytes, data, GL_STATIC_DRAW);
+        glFinish();
+        const auto t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < n; ++i) {
+            glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)bytes, data, GL_STATIC_DRAW);
+            glFinish();
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count() / n;
+    };
+
+    r.fullUploadMs = timeUploads(geo.vertices.data(), (size_t)r.fullBytes);
+    if (r.packable) r.packedUploadMs = timeUploads(geo.packedVertices.data(), (size_t)r.packedBytes);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glDeleteBuffers(1, &vbo);
+
+    r.ok = true;
+    return r;
+}
+
+void Model::packVertices(CPUGeometry& geo)
+{
+    if (pac_vertex_packing::packVertices(geo.vertices, geo.packedVertices, geo.quant)) {
+        geo.layout = pac_model_types::VertexLayout::Packed;
+    } else {
+        geo.layout = pac_model_types::VertexLayout::Full;
+        geo.packedVertices.clear();
+        geo.quant = pac_model_types::VertexQuantization{};
+    }
+}
+
+void Model::generateLods(CPUGeometry& geo)
+{
+    using pac_model_types::kMaxMeshLods;
+
+    // Halve the triangle count per level; the error budget (relative to the model's size)
+    // grows with it. Tiny submeshes aren't worth the extra draw ranges.
+    constexpr uint32_t kMinLodTriangles = 64;
+    constexpr float    kLodErrorBudget[kMaxMeshLods] = { 0.0f, 0.01f, 0.02f, 0.04f };
+    constexpr float    kMinReduction = 0.8f; // a level must drop at least 20% of the previous one
+
+    const float extent = 2.0f * boundsRadius;
+
+    for (Submesh& sm : submeshes) {
+        sm.lodCount = 1;
+        const SubmeshLod& base = sm.lods[0];
+        if (base.indexOffset > geo.indices.size() || base.indexCount > geo.indices.size() - base.indexOffset) continue;
+        if (base.indexCount / 3 < kMinLodTriangles) continue;
+
+        for (uint32_t l = 1; l < kMaxMeshLods; ++l) {
+            const SubmeshLod& prev = sm.lods[l - 1];
+            const size_t target = (base.indexCount >> l) / 3 * 3;
+
+            pac_mesh_simplify::Result r = pac_mesh_simplify::simplify(
+                geo.indices.data() + prev.indexOffset, prev.indexCount, geo.vertices, target,
+                kLodErrorBudget[l] * extent);
+            if (r.indices.empty() || (float)r.indices.size() > kMinReduction * (float)prev.indexCount) break;
+
+            SubmeshLod& lod = sm.lods[l];
+            lod.indexOffset = geo.indices.size();
+            lod.indexCount  = r.indices.size();
+            lod.error       = (std::max)(r.error, prev.error);
+            geo.indices.insert(geo.indices.end(), r.indices.begin(), r.indices.end());
+            sm.lodCount = l + 1;
+        }
+    }
+}
+
+void Model::computeBounds(const CPUGeometry& geo)
+{
+    boundsCenter = glm::vec3(0.0f);
+    boundsRadius = 0.0f;
+    if (geo.vertices.empty()) return;
+
+    glm::vec3 lo(geo.vertices[0].px, geo.vertices[0].py, geo.vertices[0].pz), hi = lo;
+    for (const Vertex& v : geo.vertices) {
+        const glm::vec3 p(v.px, v.py, v.pz);
+        lo = glm::min(lo, p);
+        hi = glm::max(hi, p);
+    }
+
+    boundsCenter = 0.5f * (lo + hi);
+    for (const Vertex& v : geo.vertices) {
+        boundsRadius = (std::max)(boundsRadius, glm::length(glm::vec3(v.px, v.py, v.pz) - boundsCenter));
+    }
+}
+
+void Model::buildLodSelection()
+{
+    lodCount = 1;
+    for (auto& e : lodErrors) e = 0.0f;
+
+    for (const Submesh& sm : submeshes) {
+        lodCount = (std::max)(lodCount, sm.lodCount);
+    }
+    // A submesh without level l draws its coarsest one, so the level costs at most that.
+    for (uint32_t l = 1; l < lodCount; ++l) {
+        for (const Submesh& sm : submeshes) {
+            const uint32_t have = (std::min)(l, sm.lodCount - 1);
+            lodErrors[l] = (std::max)(lodErrors[l], sm.lods[have].error);
+        }
+    }
+}
+
+void Model::optimizeIndexOrder(CPUGeometry& geo) const
+{
+    const size_t vertexCount = geo.vertices.size();
+    if (vertexCount == 0 || geo.indices.empty()) return;
+
+    // Triangle order within each LOD of each submesh; ranges and draw order are unchanged.
+    for (const Submesh& sm : submeshes) {
+        for (uint32_t l = 0; l < sm.lodCount; ++l) {
+            const SubmeshLod& lod = sm.lods[l];
+            if (lod.indexOffset > geo.indices.size() || lod.indexCount > geo.indices.size() - lod.indexOffset) continue;
+            pac_index_opt::optimizeVertexCache(geo.indices.data() + lod.indexOffset, lod.indexCount, vertexCount);
+        }
+    }
+
+    // Vertex order by first use across the whole (already reordered) index list. LOD0 ranges
+    // come first and primitives don't share vertices, so each submesh's vertices stay one
+    // contiguous run (LODs only reference a subset of them).
+    const std::vector<uint32_t> remap = pac_index_opt::buildFetchRemap(geo.indices.data(), geo.indices.size(), vertexCount);
+
+    std::vector<Vertex> reordered(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v) reordered[remap[v]] = geo.vertices[v];
+    geo.vertices.swap(reordered);
+
+    for (auto& idx : geo.indices) idx = remap[idx];
+}
+
+void Model::buildIndexBuffer(CPUGeometry& geo)
+{
+    using pac_model_types::IndexType;
+
+    auto inRange = [&](const SubmeshLod& lod) {
+        return lod.indexOffset <= geo.indices.size() && lod.indexCount <= geo.indices.size() - lod.indexOffset;
+    };
+
+    geo.indexBuffer.clear();
+    for (Submesh& sm : submeshes) {
+        sm.indexType = IndexType::U32;
+        sm.baseVertex = 0;
+
+        // LODs reference a subset of LOD0's vertices, so LOD0 decides the range.
+        uint32_t lo = UINT32_MAX, hi = 0;
+        if (inRange(sm.lods[0])) {
+            const uint32_t* src = geo.indices.data() + sm.lods[0].indexOffset;
+            for (size_t i = 0; i < sm.lods[0].indexCount; ++i) {
+                lo = (std::min)(lo, src[i]);
+                hi = (std::max)(hi, src[i]);
+            }
+        }
+        if (lo <= hi && hi - lo <= 0xFFFFu && lo <= (uint32_t)INT32_MAX) {
+            sm.indexType = IndexType::U16;
+            sm.baseVertex = (int32_t)lo;
+        }
+
+        for (uint32_t l = 0; l < sm.lodCount; ++l) {
+            SubmeshLod& lod = sm.lods[l];
+            lod.indexByteOffset = geo.indexBuffer.size();
+            if (!inRange(lod)) {
+                lod.indexCount = 0;
+                continue;
+            }
+            const uint32_t* src = geo.indices.data() + lod.indexOffset;
+
+            if (sm.indexType == IndexType::U16) {
+                geo.indexBuffer.resize(lod.indexByteOffset + lod.indexCount * sizeof(uint16_t));
+                uint16_t* dst = reinterpret_cast<uint16_t*>(geo.indexBuffer.data() + lod.indexByteOffset);
+                for (size_t i = 0; i < lod.indexCount; ++i) dst[i] = (uint16_t)(src[i] - lo);
+            } else {
+                geo.indexBuffer.resize(lod.indexByteOffset + lod.indexCount * sizeof(uint32_t));
+                std::memcpy(geo.indexBuffer.data() + lod.indexByteOffset, src, lod.indexCount * sizeof(uint32_t));
+            }
+
+            // Keep every segment 4-byte aligned so a uint32 segment can follow a uint16 one.
+            geo.indexBuffer.resize((geo.indexBuffer.size() + 3) & ~size_t(3), 0);
+        }
+    }
+}
+
+void Model::prepareGeometry(CPUGeometry& geo, bool lods, bool optimizeIndices, bool packVerts, bool bake,
+                            bool compressAnims)
+{
+    computeBounds(geo);
+    // Before bounds and baking, so both see the clips as the runtime will sample them.
+    if (compressAnims) compressAnimations();
+    buildSkinPaletteLayout();
+    computeAnimatedBounds(geo);
+    if (bake) bakeAnimations(geo);
+    if (lods) generateLods(geo);
+    if (optimizeIndices) optimizeIndexOrder(geo);
+    if (packVerts) packVertices(geo);
+    buildIndexBuffer(geo);
+    buildLodSelection();
+}
+
+Model::MeshStats Model::analyzeMesh(const std::string& filepath)
+{
+    MeshStats r{};
+
+    Model model{CookOnly{}};
+    CPUGeometry geo;
+    if (!model.parseGLTF(filepath, geo)) return r;
+
+    r.vertexCount      = (uint32_t)geo.vertices.size();
+    r.triangleCount    = (uint32_t)(geo.indices.size() / 3);
+    r.submeshCount     = (uint32_t)model.submeshes.size();
+    r.indexBytesBefore = (uint64_t)geo.indices.size() * sizeof(uint32_t);
+
+    // Per submesh, since that's how the triangles are drawn (the cache doesn't carry over
+    // between draws anyway); weighted by triangle count.
+    auto modelACMR = [&]() {
+        double misses = 0.0;
+        for (const Submesh& sm : model.submeshes) {
+            const SubmeshLod& lod = sm.lods[0];
+            if (lod.indexOffset + lod.indexCount > geo.indices.size()) continue;
+            misses += (double)pac_index_opt::computeACMR(geo.indices.data() + lod.indexOffset, lod.indexCount) *
+                      (double)(lod.indexCount / 3);
+        }
+        return r.triangleCount ? (float)(misses / r.triangleCount) : 0.0f;
+    };
+
+    // Full-resolution geometry only (no LODs), so the numbers compare like for like.
+    r.acmrBefore = modelACMR();
+    model.optimizeIndexOrder(geo);
+    r.acmrAfter = modelACMR();
+
+    model.buildIndexBuffer(geo);
+    r.indexBytesAfter = geo.indexBuffer.size();
+    for (const Submesh& sm : model.submeshes) {
+        if (sm.indexType == pac_model_types::IndexType::U16) ++r.submeshes16;
+    }
+
+    r.ok = true;
+    return r;
+}
+
+void Model::uploadVertexArrays(const void* vertices, size_t vertexCount, pac_model_types::VertexLayout layout,
+                               const void* indexData, size_t indexBytes)
+{
+    glGenVertexArrays(1, &VAO);
+    glGenBuffers(1, &VBO);
+    glGenBuffers(1, &EBO);
+
+    GLStateCache::getInstance().bindVertexArray(VAO);
+
+    const size_t stride = pac_vertex_packing::vertexStride(layout);
+
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBufferData(GL_ARRAY_BUFFER, vertexCount * stride, vertices, GL_STATIC_DRAW);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexBytes, indexData, GL_STATIC_DRAW);
+
+    // attributes: pos (0), uv (1), joints (2), weights (3)
+    if (layout == pac_model_types::VertexLayout::Packed) {
+        using pac_model_types::PackedVertex;
+        glVertexAttribPointer(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(PackedVertex), (void*)offsetof(PackedVertex, px));
+        glVertexAttribPointer(1, 2, GL_HALF_FLOAT, GL_FALSE, sizeof(PackedVertex), (void*)offsetof(PackedVertex, u));
+        glVertexAttribIPointer(2, 4, GL_UNSIGNED_BYTE, sizeof(PackedVertex), (void*)offsetof(PackedVertex, j));
+        glVertexAttribPointer(3, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(PackedVertex), (void*)offsetof(PackedVertex, w));
+    } else {
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, px));
+        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, u));
+        glVertexAttribIPointer(2, 4, GL_UNSIGNED_SHORT, sizeof(Vertex), (void*)offsetof(Vertex, j0));
+        glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, w0));
+    }
+    for (GLuint a = 0; a < 4; ++a) glEnableVertexAttribArray(a);
+
+    GLStateCache::getInstance().bindVertexArray(0);
+}
@@ -15,17 +15,35 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 
+#include "Bounds.h"
 #include "Camera3D.h"
 #include "engine/utils/Shader.h"
+#include "engine/utils/MappedFile.h"
 
 #include "ModelAnimationTypes.h"
 #include "ModelMeshTypes.h"
+#include "JointPalette.h"
+#include "RenderQueue.h"
+#include "TextureCache.h"
 
-struct Submesh {
-    size_t indexOffset = 0;
+// One level of detail of a submesh. Every level indexes the same vertices.
+struct SubmeshLod {
+    size_t indexOffset = 0;     // first index in CPUGeometry::indices (import/cook only)
     size_t indexCount = 0;
-    unsigned int baseColorTexID = 0;
-    unsigned int emissiveTexID  = 0;
+    size_t indexByteOffset = 0; // EBO segment, indices relative to Submesh::baseVertex
+    float  error = 0.0f;        // simplification error in model units (0 for LOD0)
+};
+
+struct Submesh {
+    SubmeshLod lods[pac_model_types::kMaxMeshLods]; // [0] = full resolution
+    uint32_t   lodCount = 1;
+
+    // Shared by every LOD's EBO segment.
+    pac_model_types::IndexType indexType = pac_model_types::IndexType::U32;
+    int32_t baseVertex = 0;
+
+    TextureHandle baseColorTex; // shared through TextureCache
+    TextureHandle emissiveTex;
     glm::vec3 emissiveFactor{0.0f};
     int alphaMode = 0; // 0=OPAQUE, 1=MASK, 2=BLEND
     float alphaCutoff = 0.5f;
@@ -46,9 +64,53 @@ public:
         float animTimeSec,
         int animIndex) const;
 
+    // ---- Instanced path ----
+    // Instance transforms and joint palettes go through a texture buffer indexed by
+    // gl_InstanceID in model.vert. Set PAC_DISABLE_INSTANCING=1 to fall back to drawAnimated.
+    struct DrawInstance {
+        glm::mat4 transform{1.0f};
+        float     animTimeSec = 0.0f;
+        int       animIndex   = -1;
+        bool      baked       = false; // use the baked atlas (ignored without one)
+    };
+
+    // Uploads this frame's instance data and records draw items: one instanced item per
+    // (mesh node, opaque/mask submesh), one item per instance for blended submeshes so
+    // they sort back-to-front. Draw with queue.flush().
+    void submitInstanced(RenderQueue& queue, const std::vector<DrawInstance>& instances) const;
+
+    // Issues one recorded item (called by RenderQueue::flush in key order).
+    void drawQueued(const RenderQueue::DrawItem& item) const;
+
+    // ---- Levels of detail ----
+    // Each instance draws the coarsest LOD whose simplification error, projected with the
+    // model's bounding sphere, stays under about a pixel at 1080p. PAC_DISABLE_LOD=1 pins LOD0.
+    uint32_t getLodCount() const { return lodCount; }
+    uint32_t getSubmeshTriangleCount(uint32_t submesh, uint32_t lod) const;
+    uint32_t selectLod(const glm::mat4& instanceTransform, const glm::mat4& view, float projScaleY) const;
+    static bool isLodEnabled();
+
+    static bool isInstancingEnabled();
+
+    // ---- Baked animation atlas ----
+    // Every clip's node globals and joint palettes pre-sampled at kBakedAnimRate (frames
+    // [0, N] spanning [0, duration], so looping and clamped one-shot times both land
+    // between two frames) and stored in the .pacmdl. Baked instances skip CPU pose
+    // evaluation entirely: model.vert fetches and blends the two frames. Instanced path only.
+    static constexpr float kBakedAnimRate = 30.0f;
+    bool hasBakedAnimation() const { return bakedFrameStride > 0 && bakedTex != 0; }
+
+    // ---- Bounds ----
+    // Mesh boxes are bind pose in the mesh's own vertex space. A clip's box is model space
+    // and covers every skinned pose it reaches (sampled at load/cook time); animIndex -1 or
+    // an unknown clip gives the rest pose. Empty boxes mean "unknown", not "invisible".
+    const Aabb& getMeshBounds(int meshIndex) const;
+    const Aabb& getAnimationBounds(int animIndex) const;
+    Aabb getWorldBounds(const glm::mat4& instanceTransform, int animIndex) const;
+
     float getScaleFactor() const { return modelScaleFactor; }
 
-    // Animated node global transform (MODEL SPACE)
+    // Animated node global transform (MODEL SPACE). Goes through the node's socket.
     bool getNodeGlobalTransformByIndex(float animTimeSec,
                                        int animIndex,
                                        int nodeIndex,
@@ -62,6 +124,16 @@ public:
                                       const std::string& nodeName,
                                       glm::mat4& outNodeGlobal) const;
 
+    // ---- Sockets ----
+    // Attachment points for VFX: a node whose model-space transform is read every frame.
+    // A socket knows its ancestor chain and, per clip, the channels driving that chain, so
+    // evaluating it samples only those. If this frame's pose cache already holds the
+    // (clip, time) it reads from there, and instances at the same quantized time share one
+    // evaluation. Ids are stable for the Model's lifetime; -1 means no such node.
+    int getSocket(int nodeIndex) const;
+    int getSocketByName(const std::string& nodeName) const;
+    bool evaluateSocket(int socket, float animTimeSec, int animIndex, glm::mat4& outNodeGlobal) const;
+
     // CPU-side texture blob for caching (always RGBA8)
     struct CPUTexture {
         uint32_t width = 1;
@@ -73,10 +145,232 @@ public:
         std::vector<uint8_t> rgba; // width*height*4
     };
 
+    // CPU-side output of parseGLTF, consumed by the GL upload and writeCache.
+    struct CPUGeometry {
+        std::vector<pac_model_types::Vertex> vertices;
+        std::vector<uint32_t>   indices;
+
+        // Filled by buildIndexBuffer: the EBO contents, one uint16 or uint32 segment per submesh.
+        std::vector<uint8_t>    indexBuffer;
+
+        // Filled by bakeAnimations: frames of bakedFrameStride matrices (see Model::bakedClips).
+        std::vector<glm::mat4>  bakedFrames;
+
+        // Filled by packVertices; what the VBO and writeCache use when layout is Packed.
+        pac_model_types::VertexLayout            layout = pac_model_types::VertexLayout::Full;
+        std::vector<pac_model_types::PackedVertex> packedVertices;
+        pac_model_types::VertexQuantization      quant;
+
+        std::vector<CPUTexture> baseColorTextures; // parallel to submeshes
+        std::vector<CPUTexture> emissiveTextures;  // parallel to submeshes
+    };
+
+    // ---- Two-phase loading ----
+    // stageLoad does everything that needs no GL (cache map + parse, or glTF parse, texture
+    // decode and cache write) and may run on any thread. finishLoad uploads the staged
+    // payload and sets up the shader, and must run on the GL thread.
+    // The constructor taking a path simply does both back to back.
+    struct StagedLoad {
+        struct Texture {
+            uint32_t    width = 1;
+            uint32_t    height = 1;
+            int         wrapS = 0, wrapT = 0, minF = 0, magF = 0;
+            TextureFormat format = TextureFormat::RGBA8;
+            uint32_t    levels = 0; // see TextureCache::Desc
+            const void* pixels = nullptr;
+            uint64_t    hash = 0;  // TextureCache::hashPixels, filled while staging
+
+            TextureCache::Desc desc() const { return { width, height, wrapS, wrapT, minF, magF, format, levels }; }
+        };
+
+        MappedFile  mapping;   // cache hit: backs the views below
+        CPUGeometry geometry;  // glTF parse: backs the views below
+        std::vector<std::vector<uint8_t>> decodedPixels; // cache hit without S3TC: BC chains decoded to RGBA8
+
+        const void*                    vertices = nullptr; // Vertex or PackedVertex, per vertexLayout
+        size_t                         vertexCount = 0;
+        pac_model_types::VertexLayout  vertexLayout = pac_model_types::VertexLayout::Full;
+        pac_model_types::VertexQuantization vertexQuant;
+        const void*                    indexData = nullptr; // per-submesh uint16/uint32 segments
+        size_t                         indexBytes = 0;
+        const glm::mat4*               bakedFrames = nullptr; // empty unless the model was baked
+        size_t                         bakedMatrixCount = 0;
+        std::vector<Texture>           textures; // base, emissive per submesh
+
+        bool   ok = false;
+        bool   fromCache = false;
+        double stageMs = 0.0;
+    };
+
+    static std::unique_ptr<Model> stageLoad(const std::string& filepath, StagedLoad& out);
+    void finishLoad(StagedLoad& staged);
+
     // NEW: exact-match lookup of animation index by glTF animation name.
     // Returns -1 if not found.
     int findAnimationIndexByName(const std::string& name) const;
 
+    // Keyframe sampling microbenchmark: samples every clip over a monotonic 60 Hz
+    // timeline, once with a copy of the original path (string interpolation compare,
+    // binary search per channel) and once with the current one (enum, per-channel cursors).
+    struct SamplingBenchResult {
+        uint64_t channels = 0;    // channel samples per pass
+        double   legacySec = 0.0;
+        double   cursorSec = 0.0;
+        float    checksum  = 0.0f; // keeps the optimizer honest
+    };
+    SamplingBenchResult benchmarkSampling(int framesPerClip) const;
+
+    // ---- Shared pose cache ----
+    // Units sampling the same clip at the same (quantized) time share one pose
+    // evaluation per frame. Call beginPoseCacheFrame() once per rendered frame.
+    struct PoseCacheStats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t socketChainEvals = 0; // socket reads that had to sample their chain
+    };
+
+    static void beginPoseCacheFrame();
+
+    // ---- Load timing ----
+    // How this Model was built at startup (cache hit vs glTF parse) and where the time went.
+    struct LoadTiming {
+        bool   fromCache   = false;
+        double totalMs     = 0.0; // stage + upload (excludes time queued for a worker)
+        double cacheReadMs = 0.0; // map + validate + parse (cache hit only)
+        double gpuUploadMs = 0.0; // VBO/EBO/texture upload
+
+        // glTF import only: unique images decoded, wall time of the parallel decode and
+        // the sum of per-image decode times (what a serial decode would have cost).
+        uint32_t imageCount     = 0;
+        double   decodeWallMs   = 0.0;
+        double   decodeSerialMs = 0.0;
+    };
+    const LoadTiming& getLoadTiming() const { return loadTiming; }
+
+    // ---- Offline cooking (pac_cook) ----
+    // Texture payload of a written .pacmdl.
+    struct CacheTextureStats {
+        uint32_t compressed = 0;  // textures stored as BC1/BC3
+        uint64_t rgbaBytes = 0;   // the same textures as RGBA8 (with mip chains)
+        uint64_t storedBytes = 0; // what was actually written
+    };
+
+    // Parses a glTF and writes its .pacmdl without touching GL. Entries whose cache already
+    // matches the source size + mtime are skipped unless force is set. Safe to run for
+    // different files on different threads. Textures are stored with their mip chains,
+    // BC1/BC3-compressed unless compressTextures is false (or PAC_DISABLE_TEXTURE_BC is set);
+    // vertices in the packed layout unless packVertices is false (or a joint index > 255).
+    // Triangles are reordered for the vertex cache and vertices for fetch locality unless
+    // optimizeIndices is false (or PAC_DISABLE_INDEX_OPT is set); submeshes spanning fewer
+    // than 65536 vertices always get 16-bit indices. Up to three simplified LODs per submesh
+    // are generated unless generateLods is false, and clips are baked into the animation
+    // atlas unless bakeAnimations is false. Clip keyframes are compressed (see
+    // AnimCompress.h) unless compressAnimations is false (or PAC_DISABLE_ANIM_COMPRESS is set).
+    struct ClipCompressStats {
+        std::string name;
+        uint64_t rawBytes = 0;        // keyframe data as loaded
+        uint64_t compressedBytes = 0; // as written
+        uint32_t keysBefore = 0;
+        uint32_t keysAfter = 0;
+        uint32_t constantTracks = 0;
+        uint32_t channelsRemoved = 0;
+        float    maxJointError = 0.0f; // model units, worst node position over the clip
+    };
+    struct CookResult {
+        enum class Status { Cooked, UpToDate, Failed };
+        Status   status = Status::Failed;
+        double   parseMs = 0.0; // fastgltf parse + texture decode
+        double   writeMs = 0.0;
+        uint64_t cacheBytes = 0;
+        LoadTiming import;      // image decode stats (Cooked only)
+        CacheTextureStats textures; // Cooked only
+
+        // Cooked only: VBO layout written and its size vs the full float layout.
+        pac_model_types::VertexLayout vertexLayout = pac_model_types::VertexLayout::Full;
+        uint64_t vertexBytes = 0;
+        uint64_t fullVertexBytes = 0;
+
+        // Cooked only: EBO size vs all-uint32 indices.
+        uint64_t indexBytes = 0;
+        uint64_t fullIndexBytes = 0;
+
+        // Cooked only: LOD levels written and triangles per level (all submeshes; a
+        // submesh without that level counts its coarsest one).
+        uint32_t lodCount = 1;
+        uint64_t lodTriangles[pac_model_types::kMaxMeshLods] = {};
+
+        // Cooked only: baked animation frames (all clips + the rest pose) and their size.
+        uint32_t bakedFrames = 0;
+        uint64_t bakedBytes = 0;
+
+        // Cooked only: per clip, empty if compression was off.
+        std::vector<ClipCompressStats> clips;
+    };
+    struct CookOptions {
+        bool force = false;
+        bool compressTextures = true;
+        bool packVertices = true;
+        bool optimizeIndices = true;
+        bool generateLods = true;
+        bool bakeAnimations = true;
+        bool compressAnimations = true;
+    };
+    static CookResult cookCache(const std::string& filepath, const CookOptions& options);
+    static bool isCacheUpToDate(const std::string& filepath);
+
+    // .pacmdl read microbenchmark (no GL): the pre-v6 readPod stream reader vs the mapped
+    // reader. "Cold" reads follow dropping the file from the OS page cache (POSIX only),
+    // "warm" is the mean of warmIterations.
+    struct CacheReadBench {
+        bool     ok = false;
+        bool     coldMeasured = false; // page cache could be dropped before the cold passes
+        uint64_t fileBytes = 0;
+        double   legacyColdMs = 0.0;   // the pre-v6 readPod stream reader (baseline)
+        double   legacyWarmMs = 0.0;
+        double   mmapColdMs = 0.0;     // mapped reader (stageCache)
+        double   mmapWarmMs = 0.0;
+    };
+    static CacheReadBench benchmarkCacheRead(const std::string& filepath, int warmIterations);
+
+    // Full vs packed vertex layout for one model (parses the glTF; needs a GL context for
+    // the upload timing). Upload times are the mean of `iterations` VBO uploads.
+    struct VertexLayoutBench {
+        bool     ok = false;
+        bool     packable = false; // every joint index fits in 8 bits
+        uint32_t vertexCount = 0;
+        uint64_t fullBytes = 0;
+        uint64_t packedBytes = 0;
+        double   fullUploadMs = 0.0;
+        double   packedUploadMs = 0.0;
+        float    maxPositionError = 0.0f; // model units
+    };
+    static VertexLayoutBench benchmarkVertexLayouts(const std::string& filepath, int iterations);
+
+    // Vertex cache statistics for one model (parses the glTF, no GL): ACMR under a 16-entry
+    // FIFO for the source triangle order and after the cook-time optimization, and the
+    // index buffer size before (all uint32) and after (uint16 where it fits).
+    struct MeshStats {
+        bool     ok = false;
+        uint32_t vertexCount = 0;
+        uint32_t triangleCount = 0;
+        uint32_t submeshCount = 0;
+        uint32_t submeshes16 = 0; // submeshes drawn with 16-bit indices
+        float    acmrBefore = 0.0f;
+        float    acmrAfter = 0.0f;
+        uint64_t indexBytesBefore = 0;
+        uint64_t indexBytesAfter = 0;
+    };
+    static MeshStats analyzeMesh(const std::string& filepath);
+
+    pac_model_types::VertexLayout getVertexLayout() const { return vertexLayout; }
+
+    const PoseCacheStats& getPoseCacheStats() const { return poseCacheStats; }
+    void resetPoseCacheStats() const { poseCacheStats = PoseCacheStats{}; }
+
+    // Totals across every Model (handy for a one-line per-second log).
+    static const PoseCacheStats& getGlobalPoseCacheStats();
+    static void resetGlobalPoseCacheStats();
+
 private:
     unsigned int VAO = 0, VBO = 0, EBO = 0;
     std::vector<Submesh> submeshes;
@@ -90,12 +384,73 @@ private:
     int locEmissiveFactor = -1;
     int locAlphaMode = -1;
     int locAlphaCutoff = -1;
+    int locPosOffset = -1;
+    int locPosScale  = -1;
+
+    // instancing uniforms + per-Model streaming texture buffer
+    int locInstanced      = -1;
+    int locViewProj       = -1;
+    int locInstanceData   = -1;
+    int locInstanceBase   = -1;
+    int locInstanceStride = -1;
+
+    // baked animation atlas: one RGBA32F texture buffer per Model
+    int locBaked            = -1;
+    int locBakedFrames      = -1;
+    int locBakedFrameStride = -1;
+    int locBakedSlotOffset  = -1;
+
+    // One chunk per GL_MAX_TEXTURE_BUFFER_SIZE worth of instances (normally just one).
+    // Slot-major layout inside a chunk: every instance of mesh slot 0, then slot 1, ...
+    struct InstanceChunk {
+        unsigned int tbo = 0;
+        unsigned int tex = 0;
+        uint32_t     count = 0;
+        bool         baked = false;       // records are [transform][frame pair], see submitInstanced
+        std::vector<uint32_t> slotBase; // first matrix of each mesh slot
+    };
+    mutable std::vector<InstanceChunk> instanceChunks;
+    mutable size_t   instanceChunksUsed = 0;
+    mutable uint64_t instanceChunksFrame = 0;
+    mutable std::vector<glm::mat4> instanceStaging;
+    mutable std::vector<uint8_t>   instanceLod;   // per instance of the chunk being staged
+    mutable std::vector<uint32_t>  instanceOrder; // staging slot -> instance, grouped by LOD
+    mutable std::vector<uint32_t>  instanceGroup; // instances of the live or baked pass
 
     // tone mapping uniforms
     int locTonemapMode = -1;
     int locExposure    = -1;
 
     float modelScaleFactor = 1.0f;
+    LoadTiming loadTiming;
+
+    // Bind-pose bounding sphere (model space) and the worst error of each LOD level across
+    // submeshes, for selectLod.
+    glm::vec3 boundsCenter{0.0f};
+    float     boundsRadius = 0.0f;
+    uint32_t  lodCount = 1;
+    float     lodErrors[pac_model_types::kMaxMeshLods] = {};
+
+    // Baked atlas layout. A frame holds, per mesh slot, the node global then that slot's
+    // joint palette (meshSlotStride[k] matrices); frame 0 is the rest pose. Clip a owns
+    // frames [firstFrame, firstFrame + frameCount] (frameCount intervals, one extra frame).
+    struct BakedClip {
+        uint32_t firstFrame = 0;
+        uint32_t frameCount = 0;
+    };
+    std::vector<BakedClip> bakedClips;       // per animation, empty if not baked
+    uint32_t               bakedFrameStride = 0; // matrices per frame, 0 if not baked
+    unsigned int           bakedTbo = 0;
+    unsigned int           bakedTex = 0;
+
+    // See getMeshBounds / getAnimationBounds.
+    std::vector<Aabb> meshBounds; // per mesh index
+    std::vector<Aabb> clipBounds; // per animation
+    Aabb              restBounds;
+
+    // VBO layout; packed positions are decoded in model.vert with vertexQuant.
+    pac_model_types::VertexLayout       vertexLayout = pac_model_types::VertexLayout::Full;
+    pac_model_types::VertexQuantization vertexQuant;
 
     using NodeTRS          = pac_model_types::NodeTRS;
     using SkinData         = pac_model_types::SkinData;
@@ -103,13 +458,38 @@ private:
     using Vertex           = pac_model_types::Vertex;
 
     std::vector<NodeTRS>           nodesDefault;
-    std::vector<std::vector<int>>  nodeChildren;
     std::vector<int>               nodeMesh;
     std::vector<int>               nodeSkin;
-    std::vector<int>               sceneRoots;
+
+    // Flattened hierarchy (indices stay glTF node indices; skins, channels and VFX refer to them).
+    // nodeOrder lists every scene-reachable node parent-before-child, so one linear pass
+    // over it computes all globals. meshNodeOrder is the subset of nodeOrder carrying a mesh.
+    std::vector<int>               nodeParent;
+    std::vector<int>               nodeOrder;
+    std::vector<int>               meshNodeOrder;
     std::vector<SkinData>          skins;
     std::vector<AnimationClip>     animations;
 
+    // Joint palette layout, parallel to meshNodeOrder: offset of that mesh node's palette
+    // inside PoseCacheEntry::palettes, or -1 if the node draws unskinned.
+    std::vector<int>               meshNodePaletteOffset;
+    size_t                         paletteMatrixCount = 0;
+
+    // Matrices per instance record for each mesh slot (model matrix + joint palette).
+    // A model without node meshes has a single slot that draws every submesh.
+    std::vector<uint32_t>          meshSlotStride;
+
+    // Submeshes grouped per mesh, opaque/mask first then blend, so draw paths never scan
+    // every submesh. Ranges index meshSubmeshOrder; the last range covers all submeshes
+    // (used when the model has no node meshes).
+    struct SubmeshRange {
+        uint32_t begin = 0;      // opaque/mask: [begin, blendBegin)
+        uint32_t blendBegin = 0; // blend:       [blendBegin, end)
+        uint32_t end = 0;
+    };
+    std::vector<uint32_t>          meshSubmeshOrder;
+    std::vector<SubmeshRange>      meshSubmeshRanges;
+
     // glTF node names (parallel to nodesDefault).
     std::vector<std::string>       nodeNames;
 
@@ -118,23 +498,126 @@ private:
 
     mutable std::unordered_set<int> warnedMissingAnimIndex;
 
-    void loadGLTF(const std::string& filepath);
+    // Pose cache: one entry per (animIndex, quantized time) sampled this frame.
+    // Entries from older frames are recycled in place (no per-frame allocations).
+    struct PoseCacheEntry {
+        int       animIndex = -1;
+        int64_t   timeKey   = 0;
+        uint64_t  frame     = 0;
+        std::vector<glm::mat4> globals;
+        pac_joint_palette::Mat4Buffer palettes; // every skinned mesh node, see meshNodePaletteOffset
+    };
+
+    mutable std::vector<PoseCacheEntry> poseCache;
+    mutable PoseCacheStats poseCacheStats;
+    mutable std::vector<NodeTRS> poseScratchLocals;
+
+    // Filled by compressAnimations (cook time only), parallel to animations.
+    std::vector<ClipCompressStats> clipCompressStats;
+
+    // Per-clip, per-channel keyframe cursors. Pose evaluation is shared per Model
+    // (see getCachedPose), so the cursor lives with the clip rather than the unit.
+    mutable std::vector<std::vector<uint32_t>> clipChannelCursors;
+
+    // Returns model-space node globals and joint palettes for (animIndex, timeSec),
+    // evaluating at most once per frame.
+    const PoseCacheEntry& getCachedPose(float timeSec, int animIndex) const;
+    // Pose cache key for (timeSec, animIndex): clip (-1 = rest) and quantized time.
+    void poseCacheKey(float timeSec, int animIndex, int& key, int64_t& timeKey) const;
+    // This frame's entry for the key, or nullptr (never evaluates).
+    const PoseCacheEntry* findCachedPose(int key, int64_t timeKey) const;
+
+    // See getSocket. chain runs root first and ends at node; channels[clip] lists the
+    // clip's channels that target the chain, with the chain link each one drives.
+    struct SocketChannel {
+        uint32_t channel = 0;
+        uint32_t link = 0;
+    };
+    struct Socket {
+        int node = -1;
+        std::vector<int> chain;
+        std::vector<std::vector<SocketChannel>> channels; // per clip
+        std::vector<std::vector<uint32_t>>      cursors;  // per clip, parallel to channels
+        std::vector<NodeTRS>                    locals;   // scratch, parallel to chain
+
+        // Last result; reused while (frame, clip, quantized time) match.
+        uint64_t  frame = 0;
+        int       animIndex = -1;
+        int64_t   timeKey = 0;
+        glm::mat4 global{1.0f};
+    };
+    mutable std::vector<Socket> sockets;
+    mutable std::unordered_map<int, int> nodeSocket;
+
+    // Cooking / staging constructor: no shader, no GL objects (the destructor then makes
+    // no GL calls). finishLoad turns a staged Model into a drawable one.
+    struct CookOnly {};
+    explicit Model(CookOnly) {}
+
+    bool stage(const std::string& filepath, StagedLoad& out);
+    bool parseGLTF(const std::string& filepath, CPUGeometry& out);
+    void uploadStaged(const StagedLoad& staged);
+    void initShader();
+    void uploadVertexArrays(const void* vertices, size_t vertexCount, pac_model_types::VertexLayout layout,
+                            const void* indexData, size_t indexBytes);
+    // Switches geo to the packed layout if every joint index fits in 8 bits.
+    static void packVertices(CPUGeometry& geo);
+    // Reorders each submesh's triangles for the post-transform cache, then the vertices by
+    // first use. Works on geo.indices/geo.vertices, so it runs before packVertices.
+    void optimizeIndexOrder(CPUGeometry& geo) const;
+    // Builds geo.indexBuffer and each submesh's EBO segment (uint16 + baseVertex when the
+    // submesh spans fewer than 65536 vertices).
+    void buildIndexBuffer(CPUGeometry& geo);
+    // Appends simplified index lists to geo.indices and records them as submesh LODs.
+    void generateLods(CPUGeometry& geo);
+    void computeBounds(const CPUGeometry& geo);
+    // meshBounds, plus clipBounds/restBounds by sampling each clip and skinning per-joint
+    // vertex boxes. Needs the node hierarchy, skins and palette layout.
+    void computeAnimatedBounds(const CPUGeometry& geo);
+    // lodCount/lodErrors from the submeshes; call once submeshes are final.
+    void buildLodSelection();
+    // Compresses every clip in place and fills clipCompressStats. Needs the node hierarchy
+    // and boundsRadius (translation tolerance scales with the model).
+    void compressAnimations();
+    // Fills geo.bakedFrames and bakedClips/bakedFrameStride. Needs the palette layout.
+    void bakeAnimations(CPUGeometry& geo);
+    // Baked frames (atlas-wide) bracketing (animIndex, timeSec) and the blend between them.
+    void bakedFramePair(int animIndex, float timeSec, uint32_t& frameA, uint32_t& frameB, float& blend) const;
+    void uploadBakedFrames(const glm::mat4* frames, size_t matrixCount);
+    // Everything between parseGLTF and the upload / writeCache, in order.
+    void prepareGeometry(CPUGeometry& geo, bool lods, bool optimizeIndices, bool packVerts, bool bake,
+                         bool compressAnims);
+    void applyVertexDecode() const;
 
     static glm::mat4 trsToMat4(const NodeTRS& n);
+
+    // Builds nodeParent/nodeOrder/meshNodeOrder from glTF children lists (pre-order DFS,
+    // same visiting order as the old recursive walk). Empty roots => node 0 is the root.
+    void buildNodeHierarchy(const std::vector<std::vector<int>>& children,
+                            const std::vector<int>& roots);
+    void buildMeshNodeOrder();
+    // Assigns palette offsets to skinned mesh nodes. Call once skins and meshNodeOrder are final.
+    void buildSkinPaletteLayout();
+    void buildSubmeshRanges();
+    const SubmeshRange& submeshRangeForMesh(int meshIdx) const;
+    int meshIndexForSlot(size_t meshSlot) const;
     void buildPoseMatrices(float timeSec,
                            int animIndex,
                            std::vector<NodeTRS>& outLocal,
                            std::vector<glm::mat4>& outGlobal) const;
+    // The two halves of buildPoseMatrices: overwrite the channels clip drives at timeSec,
+    // then the parent-before-child pass (globals must already be sized).
+    static void applyClip(const AnimationClip& clip, float timeSec, std::vector<uint32_t>& cursors,
+                          std::vector<NodeTRS>& locals);
+    void composeGlobals(const std::vector<NodeTRS>& locals, std::vector<glm::mat4>& globals) const;
 
-    void uploadSkinUniforms(const glm::mat4& meshGlobal,
-                            int skinIndex,
-                            const std::vector<glm::mat4>& nodeGlobals) const;
+    void buildJointPalettes(PoseCacheEntry& entry) const;
+    void noteMissingAnimIndex(int animIndex) const;
+    void applyMaterial(const Submesh& sm) const;
+    void uploadSkinUniforms(const PoseCacheEntry& pose, size_t meshSlot) const;
 
     // ---- On-disk cache helpers ----
-    bool tryLoadCache(const std::string& filepath);
-    void writeCache(const std::string& filepath,
-                    const std::vector<Vertex>& vertices,
-                    const std::vector<uint32_t>& indices,
-                    const std::vector<CPUTexture>& baseColorTexturesCPU,
-                    const std::vector<CPUTexture>& emissiveTexturesCPU) const;
+    bool stageCache(const std::string& filepath, StagedLoad& out);
+    bool writeCache(const std::string& filepath, const CPUGeometry& geo, bool compressTextures = true,
+                    CacheTextureStats* texStats = nullptr) const;
 };
\ No newline at end of file
@@ -3,13 +3,18 @@
 // Animation + skinning draw path split out of Model.cpp.
 
 #include "Model.h"
+#include "AnimCompress.h"
+#include "GLStateCache.h"
 
 #include <glad/glad.h>
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
-#include <functional>
+#include <cstdlib>
 #include <iostream>
+#include <limits>
+#include <string>
 #include <vector>
 
 #include <glm/gtc/type_ptr.hpp>
@@ -18,47 +23,132 @@
 // ✅ Fix: use real enum + sampler type namespace
 using pac_model_types::AnimationSampler;
 using pac_model_types::ChannelPath;
+using pac_model_types::Interpolation;
+using pac_model_types::SamplerFormat;
 
-void Model::uploadSkinUniforms(const glm::mat4& meshGlobal,
-                               int skinIndex,
-                               const std::vector<glm::mat4>& nodeGlobals) const
+static constexpr int kMaxSkinJoints = 128; // matches u_Joints[] in model.vert
+
+void Model::buildSkinPaletteLayout()
 {
-    if (skinIndex < 0 || skinIndex >= (int)skins.size()) {
-        glUniform1i(locUseSkin, 0);
-        return;
-    }
+    meshNodePaletteOffset.assign(meshNodeOrder.size(), -1);
+    paletteMatrixCount = 0;
 
-    const auto& skin = skins[skinIndex];
-    if (skin.joints.empty() || skin.inverseBind.size() != skin.joints.size()) {
-        glUniform1i(locUseSkin, 0);
-        return;
+    for (size_t k = 0; k < meshNodeOrder.size(); ++k) {
+        const int node = meshNodeOrder[k];
+        const int skinIndex = (node < (int)nodeSkin.size()) ? nodeSkin[(size_t)node] : -1;
+        if (skinIndex < 0 || skinIndex >= (int)skins.size()) continue;
+
+        const auto& skin = skins[(size_t)skinIndex];
+        if (skin.joints.empty() || skin.inverseBind.size() != skin.joints.size()) continue;
+
+        if ((int)skin.joints.size() > kMaxSkinJoints) {
+            std::cerr << "[Model] WARNING: skin " << skinIndex << " has " << skin.joints.size()
+                      << " joints (MAX_JOINTS=" << kMaxSkinJoints << "); skinning disabled for node "
+                      << node << ".\n";
+            continue;
+        }
+
+        meshNodePaletteOffset[k] = (int)paletteMatrixCount;
+        paletteMatrixCount += skin.joints.size();
     }
 
-    constexpr int MAX_JOINTS = 128;
-    if ((int)skin.joints.size() > MAX_JOINTS) {
-        std::cerr << "[Model] WARNING: skin joints exceed MAX_JOINTS=128; skinning disabled.\n";
-        glUniform1i(locUseSkin, 0);
-        return;
+    meshSlotStride.assign((std::max)(meshNodeOrder.size(), (size_t)1), 1u);
+    for (size_t k = 0; k < meshNodeOrder.size(); ++k) {
+        if (meshNodePaletteOffset[k] >= 0)
+            meshSlotStride[k] += (uint32_t)skins[(size_t)nodeSkin[(size_t)meshNodeOrder[k]]].joints.size();
     }
+}
 
-    glm::mat4 invMesh = glm::inverse(meshGlobal);
+void Model::buildSubmeshRanges()
+{
+    int meshCount = 0;
+    for (const auto& sm : submeshes) meshCount = (std::max)(meshCount, sm.meshIndex + 1);
+
+    meshSubmeshOrder.clear();
+    meshSubmeshRanges.assign((size_t)meshCount + 1, SubmeshRange{});
+
+    auto appendRange = [&](SubmeshRange& r, int meshIdx) {
+        r.begin = (uint32_t)meshSubmeshOrder.size();
+        for (int blend = 0; blend < 2; ++blend) {
+            if (blend) r.blendBegin = (uint32_t)meshSubmeshOrder.size();
+            for (size_t i = 0; i < submeshes.size(); ++i) {
+                const auto& sm = submeshes[i];
+                if (meshIdx >= 0 && sm.meshIndex != meshIdx) continue;
+                if ((sm.alphaMode == 2) != (blend == 1)) continue;
+                meshSubmeshOrder.push_back((uint32_t)i);
+            }
+        }
+        r.end = (uint32_t)meshSubmeshOrder.size();
+    };
 
-    std::vector<glm::mat4> mats;
-    mats.resize(skin.joints.size(), glm::mat4(1.0f));
+    for (int m = 0; m < meshCount; ++m) appendRange(meshSubmeshRanges[(size_t)m], m);
+    appendRange(meshSubmeshRanges.back(), -1);
+}
 
-    for (size_t i = 0; i < skin.joints.size(); ++i) {
-        int jNode = skin.joints[i];
-        if (jNode < 0 || jNode >= (int)nodeGlobals.size()) {
-            mats[i] = glm::mat4(1.0f);
-            continue;
-        }
-        mats[i] = invMesh * nodeGlobals[jNode] * skin.inverseBind[i];
+const Model::SubmeshRange& Model::submeshRangeForMesh(int meshIdx) const
+{
+    static const SubmeshRange kEmpty{};
+    if (meshSubmeshRanges.empty()) return kEmpty;
+    if (meshIdx < 0) return meshSubmeshRanges.back();
+    if (meshIdx + 1 >= (int)meshSubmeshRanges.size()) return kEmpty;
+    return meshSubmeshRanges[(size_t)meshIdx];
+}
+
+int Model::meshIndexForSlot(size_t meshSlot) const
+{
+    if (meshNodeOrder.empty()) return -1; // single slot drawing every submesh
+    return nodeMesh[(size_t)meshNodeOrder[meshSlot]];
+}
+
+void Model::buildJointPalettes(PoseCacheEntry& entry) const
+{
+    entry.palettes.resize(paletteMatrixCount);
+    if (paletteMatrixCount == 0) return;
+
+    const auto path = pac_simd::bestAvailablePath();
+    const auto& globals = entry.globals;
+
+    for (size_t k = 0; k < meshNodeOrder.size(); ++k) {
+        const int offset = meshNodePaletteOffset[k];
+        if (offset < 0) continue;
+
+        const int node = meshNodeOrder[k];
+        const auto& skin = skins[(size_t)nodeSkin[(size_t)node]];
+
+        pac_joint_palette::build(path,
+                                 glm::inverse(globals[(size_t)node]),
+                                 globals.data(), globals.size(),
+                                 skin.joints.data(),
+                                 skin.inverseBind.data(),
+                                 skin.joints.size(),
+                                 entry.palettes.data() + offset);
+    }
+}
+
+void Model::uploadSkinUniforms(const PoseCacheEntry& pose, size_t meshSlot) const
+{
+    const int offset = (meshSlot < meshNodePaletteOffset.size()) ? meshNodePaletteOffset[meshSlot] : -1;
+    if (offset < 0) {
+        glUniform1i(locUseSkin, 0);
+        return;
     }
 
+    const int node = meshNodeOrder[meshSlot];
+    const size_t jointCount = skins[(size_t)nodeSkin[(size_t)node]].joints.size();
+
     glUniform1i(locUseSkin, 1);
-    glUniformMatrix4fv(locJoints0, (GLsizei)mats.size(), GL_FALSE, glm::value_ptr(mats[0]));
+    glUniformMatrix4fv(locJoints0, (GLsizei)jointCount, GL_FALSE,
+                       glm::value_ptr(pose.palettes[(size_t)offset]));
+}
+
+static GLenum glIndexType(pac_model_types::IndexType t)
+{
+    return (t == pac_model_types::IndexType::U16) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
 }
 
+// LOD switch point: projected simplification error, in half-screen-heights (~1 px at 1080p).
+static constexpr float kLodMaxScreenError = 1.0f / 540.0f;
+
 static float wrapTime(float t, float duration)
 {
     if (duration <= 0.0f) return 0.0f;
@@ -67,6 +157,99 @@ static float wrapTime(float t, float duration)
     return x;
 }
 
+// Clip bounds sample rate, and a cap so a very long clip doesn't stall loading.
+static constexpr float kBoundsSampleHz   = 30.0f;
+static constexpr int   kMaxBoundsSamples = 600;
+
+// Keyframe reduction tolerance for translations, as a fraction of the bind-pose radius.
+static constexpr float kAnimTranslationTolerance = 5e-4f;
+
+// Baked instance record, per mesh slot: [transform][frame A, frame B, blend, 0 | padding].
+static constexpr uint32_t kBakedRecordMats = 2;
+static constexpr int      kMaxBakedFramesPerClip = 600;
+
+// Pose cache time resolution. Times are floored (not rounded) so a clamped
+// one-shot (dur - epsilon) never quantizes onto the wrap point.
+static constexpr float kPoseCacheTimeQuantumSec = 1.0f / 1000.0f;
+
+static uint64_t g_poseCacheFrame = 1;
+static Model::PoseCacheStats g_poseCacheStatsTotal;
+
+void Model::beginPoseCacheFrame()
+{
+    ++g_poseCacheFrame;
+}
+
+const Model::PoseCacheStats& Model::getGlobalPoseCacheStats()
+{
+    return g_poseCacheStatsTotal;
+}
+
+void Model::resetGlobalPoseCacheStats()
+{
+    g_poseCacheStatsTotal = PoseCacheStats{};
+}
+
+void Model::buildNodeHierarchy(const std::vector<std::vector<int>>& children,
+                               const std::vector<int>& roots)
+{
+    const size_t n = nodesDefault.size();
+    nodeParent.assign(n, -1);
+    nodeOrder.clear();
+    nodeOrder.reserve(n);
+
+    if (n == 0) {
+        buildMeshNodeOrder();
+        return;
+    }
+
+    // Iterative pre-order DFS (children pushed in reverse to keep glTF sibling order).
+    std::vector<uint8_t> visited(n, 0);
+    std::vector<int> stack;
+    stack.reserve(n);
+
+    auto visitRoot = [&](int root) {
+        if (root < 0 || root >= (int)n || visited[(size_t)root]) return;
+        nodeParent[(size_t)root] = -1;
+        stack.push_back(root);
+
+        while (!stack.empty()) {
+            const int node = stack.back();
+            stack.pop_back();
+            if (visited[(size_t)node]) continue;
+            visited[(size_t)node] = 1;
+            nodeOrder.push_back(node);
+
+            if (node >= (int)children.size()) continue;
+            const auto& ch = children[(size_t)node];
+            for (auto it = ch.rbegin(); it != ch.rend(); ++it) {
+                const int c = *it;
+                if (c < 0 || c >= (int)n || visited[(size_t)c]) continue;
+                nodeParent[(size_t)c] = node;
+                stack.push_back(c);
+            }
+        }
+    };
+
+    if (roots.empty()) {
+        visitRoot(0);
+    } else {
+        for (int r : roots) visitRoot(r);
+    }
+
+    buildMeshNodeOrder();
+}
+
+void Model::buildMeshNodeOrder()
+{
+    meshNodeOrder.clear();
+    for (int node : nodeOrder) {
+        if (node < (int)nodeMesh.size() && nodeMesh[(size_t)node] >= 0) {
+            meshNodeOrder.push_back(node);
+        }
+    }
+}
+
 static size_t findKeyframe(const std::vector<float>& times, float t)
 {
     if (times.empty()) return 0;
@@ -78,6 +261,112 @@ static size_t findKeyframe(const std::vector<float>& times, float t)
     return idx;
 }
 
+// Same result as findKeyframe, but starts from the previous key for this channel.
+// Monotonic playback only steps forward a key or two; a wrap or a big jump falls
+// back to the binary search.
+static size_t findKeyframeFromCursor(const std::vector<float>& times, float t, uint32_t& cursor)
+{
+    const size_t n = times.size();
+    if (n == 0) return 0;
+
+    size_t i = (cursor < n) ? (size_t)cursor : 0;
+    if (t < times[i]) {
+        i = findKeyframe(times, t);
+    } else {
+        constexpr int kMaxLinearSteps = 4;
+        int steps = 0;
+        while (i + 1 < n && times[i + 1] <= t) {
+            if (++steps > kMaxLinearSteps) {
+                i = findKeyframe(times, t);
+                break;
+            }
+            ++i;
+        }
+    }
+
+    cursor = (uint32_t)i;
+    return i;
+}
+
+// Key i of s as a vec4 (x, y, z, w), whatever the storage format.
+static inline glm::vec4 keyValue(const AnimationSampler& s, size_t i)
+{
+    switch (s.format) {
+        case SamplerFormat::Vec3:   return glm::vec4(s.outputs3[i], 0.0f);
+        case SamplerFormat::Quat48: return pac_anim_compress::decodeQuat48(s.outputsQ[i]);
+        case SamplerFormat::Vec4:
+        default:                    return s.outputs[i];
+    }
+}
+
+// Evaluate sampler s at time t, given key i = findKeyframe(s.inputs, t).
+static glm::vec4 sampleAtKey(const AnimationSampler& s, float t, size_t i)
+{
+    const size_t count = s.valueCount();
+    if (s.inputs.empty() || count == 0) return glm::vec4(0.0f);
+
+    const size_t last = count - 1;
+    if (i >= s.inputs.size() - 1 || i >= last) {
+        return keyValue(s, (std::min)(i, last));
+    }
+
+    const glm::vec4 v0 = keyValue(s, i);
+
+    switch (s.interpolation) {
+        case Interpolation::Step:
+            return v0;
+
+        case Interpolation::CubicSpline: {
+            if (s.outTangents.size() <= i || s.inTangents.size() <= i + 1) return v0;
+
+            // glTF 2.0 cubic Hermite spline (tangents are per second; scale by the key delta).
+            const float t0 = s.inputs[i];
+            const float td = s.inputs[i + 1] - t0;
+            const float u  = (td > 0.0f) ? ((t - t0) / td) : 0.0f;
+            const float u2 = u * u;
+            const float u3 = u2 * u;
+
+            const float h00 =  2.0f * u3 - 3.0f * u2 + 1.0f;
+            const float h10 =         u3 - 2.0f * u2 + u;
+            const float h01 = -2.0f * u3 + 3.0f * u2;
+            const float h11 =         u3 -        u2;
+
+            return h00 * v0
+                 + h10 * td * s.outTangents[i]
+                 + h01 * s.outputs[i + 1]
+                 + h11 * td * s.inTangents[i + 1];
+        }
+
+        case Interpolation::Linear:
+        default: {
+            const float t0 = s.inputs[i];
+            const float t1 = s.inputs[i + 1];
+            const float a = (t1 > t0) ? ((t - t0) / (t1 - t0)) : 0.0f;
+            glm::vec4 v1 = keyValue(s, i + 1);
+            // Quat48 keys lose their sign (q and -q encode alike); keep the short arc.
+            if (s.format == SamplerFormat::Quat48 && glm::dot(v0, v1) < 0.0f) v1 = -v1;
+            return glm::mix(v0, v1, a);
+        }
+    }
+}
+
+static glm::quat vec4ToQuat(const glm::vec4& v)
+{
+    return glm::normalize(glm::quat(v.w, v.x, v.y, v.z));
+}
+
+static void applyChannelValue(pac_model_types::NodeTRS& local, ChannelPath path, const glm::vec4& v)
+{
+    if (path == ChannelPath::Translation) {
+        local.t = glm::vec3(v.x, v.y, v.z);
+    } else if (path == ChannelPath::Scale) {
+        local.s = glm::vec3(v.x, v.y, v.z);
+    } else if (path == ChannelPath::Rotation) {
+        local.r = vec4ToQuat(v);
+    }
+    local.hasMatrix = false;
+}
+
 void Model::buildPoseMatrices(float timeSec,
                               int animIndex,
                               std::vector<NodeTRS>& outLocal,
@@ -88,236 +377,791 @@ void Model::buildPoseMatrices(float timeSec,
 
     if (nodesDefault.empty()) return;
 
-    auto sampleVec4 = [&](const AnimationSampler& s, float t)->glm::vec4 {
-        if (s.inputs.empty() || s.outputs.empty()) return glm::vec4(0.0f);
+    if (animIndex >= 0 && animIndex < (int)animations.size()) {
+        if (clipChannelCursors.size() != animations.size()) clipChannelCursors.resize(animations.size());
+        applyClip(animations[(size_t)animIndex], timeSec, clipChannelCursors[(size_t)animIndex], outLocal);
+    }
+
+    composeGlobals(outLocal, outGlobal);
+}
+
+void Model::applyClip(const AnimationClip& clip, float timeSec, std::vector<uint32_t>& cursors,
+                      std::vector<NodeTRS>& locals)
+{
+    const float t = wrapTime(timeSec, clip.durationSec);
+    if (cursors.size() != clip.channels.size()) cursors.assign(clip.channels.size(), 0u);
+
+    for (size_t c = 0; c < clip.channels.size(); ++c) {
+        const auto& ch = clip.channels[c];
+        if (ch.targetNode < 0 || ch.targetNode >= (int)locals.size()) continue;
+        if (ch.samplerIndex < 0 || ch.samplerIndex >= (int)clip.samplers.size()) continue;
+        const auto& s = clip.samplers[ch.samplerIndex];
+
+        const size_t key = findKeyframeFromCursor(s.inputs, t, cursors[c]);
+        applyChannelValue(locals[ch.targetNode], ch.path, sampleAtKey(s, t, key));
+    }
+}
+
+void Model::composeGlobals(const std::vector<NodeTRS>& locals, std::vector<glm::mat4>& globals) const
+{
+    // Linear pass: nodeOrder is parent-before-child, so each parent global is ready.
+    for (int node : nodeOrder) {
+        const int parent = nodeParent[(size_t)node];
+        if (parent >= 0) globals[(size_t)node] = globals[(size_t)parent] * trsToMat4(locals[(size_t)node]);
+        else             globals[(size_t)node] = trsToMat4(locals[(size_t)node]);
+    }
+}
 
-        size_t i = findKeyframe(s.inputs, t);
-        if (i >= s.inputs.size() - 1) {
-            return s.outputs[(std::min)(i, s.outputs.size() - 1)];
+void Model::compressAnimations()
+{
+    clipCompressStats.clear();
+    if (animations.empty() || nodesDefault.empty()) return;
+
+    std::vector<NodeTRS> locals;
+    std::vector<glm::mat4> restGlobals;
+    buildPoseMatrices(0.0f, -1, locals, restGlobals);
+
+    // Translation tolerance is in model units, so divide by each parent's rest scale.
+    std::vector<float> parentScale(nodesDefault.size(), 1.0f);
+    for (int node : nodeOrder) {
+        const int parent = nodeParent[(size_t)node];
+        if (parent < 0) continue;
+        const glm::mat4& m = restGlobals[(size_t)parent];
+        parentScale[(size_t)node] = (std::max)({ glm::length(glm::vec3(m[0])),
+                                                 glm::length(glm::vec3(m[1])),
+                                                 glm::length(glm::vec3(m[2])) });
+    }
+
+    pac_anim_compress::Tolerances tol;
+    tol.translation = (std::max)(boundsRadius * kAnimTranslationTolerance, 1e-6f);
+
+    std::vector<NodeTRS> localsA, localsB;
+    std::vector<glm::mat4> globalsA(nodesDefault.size()), globalsB(nodesDefault.size());
+    std::vector<uint32_t> cursorsA, cursorsB;
+
+    clipCompressStats.resize(animations.size());
+    for (size_t a = 0; a < animations.size(); ++a) {
+        const AnimationClip original = animations[a];
+        const pac_anim_compress::ClipStats cs =
+            pac_anim_compress::compressClip(animations[a], nodesDefault, parentScale, tol);
+
+        ClipCompressStats& out = clipCompressStats[a];
+        out.name            = original.name;
+        out.rawBytes        = cs.rawBytes;
+        out.compressedBytes = cs.compressedBytes;
+        out.keysBefore      = cs.keysBefore;
+        out.keysAfter       = cs.keysAfter;
+        out.constantTracks  = cs.constantTracks;
+        out.channelsRemoved = cs.channelsRemoved;
+
+        // Largest model-space distance between a node's original and compressed position,
+        // sampled like the clip bounds.
+        const float dur = original.durationSec;
+        const int samples = (dur > 0.0f)
+            ? (std::clamp)((int)std::ceil(dur * kBoundsSampleHz), 1, kMaxBoundsSamples) : 1;
+        const float lastT = (std::max)(dur - 1e-4f, 0.0f);
+        cursorsA.clear();
+        cursorsB.clear();
+        for (int s = 0; s <= samples; ++s) {
+            const float t = (std::min)(dur * (float)s / (float)samples, lastT);
+            localsA = nodesDefault;
+            localsB = nodesDefault;
+            applyClip(original, t, cursorsA, localsA);
+            applyClip(animations[a], t, cursorsB, localsB);
+            composeGlobals(localsA, globalsA);
+            composeGlobals(localsB, globalsB);
+            for (int node : nodeOrder) {
+                const float err = glm::length(glm::vec3(globalsA[(size_t)node][3]) - glm::vec3(globalsB[(size_t)node][3]));
+                out.maxJointError = (std::max)(out.maxJointError, err);
+            }
         }
+    }
+
+    // Compression can change which channels exist; stale cursors would index past them.
+    clipChannelCursors.clear();
+}
 
-        float t0 = s.inputs[i];
-        float t1 = s.inputs[i + 1];
-        float a = (t1 > t0) ? ((t - t0) / (t1 - t0)) : 0.0f;
+void Model::computeAnimatedBounds(const CPUGeometry& geo)
+{
+    int meshCount = 0;
+    for (const auto& sm : submeshes) meshCount = (std::max)(meshCount, sm.meshIndex + 1);
+
+    meshBounds.assign((size_t)meshCount, Aabb{});
+    clipBounds.assign(animations.size(), Aabb{});
+    restBounds = Aabb{};
+
+    // Mesh boxes, and per mesh the box of the vertices each joint slot moves. Skinned
+    // positions are weighted blends of joint-transformed points, so they stay inside the
+    // union of the transformed joint boxes.
+    Aabb allBounds;
+    std::vector<std::vector<Aabb>> jointBounds((size_t)meshCount);
+    std::vector<char> seen(geo.vertices.size(), 0);
+
+    for (const auto& sm : submeshes) {
+        const SubmeshLod& lod = sm.lods[0];
+        if (lod.indexOffset > geo.indices.size() || lod.indexCount > geo.indices.size() - lod.indexOffset) continue;
+
+        for (size_t i = 0; i < lod.indexCount; ++i) {
+            const uint32_t vi = geo.indices[lod.indexOffset + i];
+            if (vi >= geo.vertices.size() || seen[vi]) continue;
+            seen[vi] = 1;
+
+            const Vertex& v = geo.vertices[vi];
+            const glm::vec3 p(v.px, v.py, v.pz);
+            allBounds.expand(p);
+            if (sm.meshIndex < 0) continue;
+
+            meshBounds[(size_t)sm.meshIndex].expand(p);
+            auto& boxes = jointBounds[(size_t)sm.meshIndex];
+            const uint16_t joints[4]  = { v.j0, v.j1, v.j2, v.j3 };
+            const float    weights[4] = { v.w0, v.w1, v.w2, v.w3 };
+            for (int k = 0; k < 4; ++k) {
+                if (weights[k] <= 0.0f) continue;
+                if (boxes.size() <= joints[k]) boxes.resize((size_t)joints[k] + 1);
+                boxes[joints[k]].expand(p);
+            }
+        }
+    }
 
-        glm::vec4 v0 = s.outputs[(std::min)(i, s.outputs.size() - 1)];
-        glm::vec4 v1 = s.outputs[(std::min)(i + 1, s.outputs.size() - 1)];
+    // Same transforms as drawAnimated: node global for rigid meshes, joint global times
+    // inverse bind for skinned ones, every submesh under the instance transform otherwise.
+    auto accumulatePose = [&](const std::vector<glm::mat4>& globals, Aabb& out) {
+        bool hasNodeMesh = false;
+        for (size_t k = 0; k < meshNodeOrder.size(); ++k) {
+            const int node = meshNodeOrder[k];
+            const int meshIdx = nodeMesh[(size_t)node];
+            if (meshIdx < 0 || meshIdx >= meshCount) continue;
+            hasNodeMesh = true;
+
+            if (meshNodePaletteOffset[k] < 0) {
+                out.expand(meshBounds[(size_t)meshIdx].transformed(globals[(size_t)node]));
+                continue;
+            }
 
-        if (s.interpolation == "STEP") return v0;
-        return glm::mix(v0, v1, a);
+            const auto& skin = skins[(size_t)nodeSkin[(size_t)node]];
+            const auto& boxes = jointBounds[(size_t)meshIdx];
+            const size_t n = (std::min)(boxes.size(), skin.joints.size());
+            for (size_t j = 0; j < n; ++j) {
+                const int jointNode = skin.joints[j];
+                if (boxes[j].isEmpty() || jointNode < 0 || jointNode >= (int)globals.size()) continue;
+                out.expand(boxes[j].transformed(globals[(size_t)jointNode] * skin.inverseBind[j]));
+            }
+        }
+        if (!hasNodeMesh) out.expand(allBounds);
     };
 
-    auto sampleQuat = [&](const AnimationSampler& s, float t)->glm::quat {
-        glm::vec4 v = sampleVec4(s, t);
-        glm::quat q(v.w, v.x, v.y, v.z);
-        q = glm::normalize(q);
-        return q;
-    };
+    std::vector<NodeTRS> locals;
+    std::vector<glm::mat4> globals;
 
-    if (animIndex >= 0 && animIndex < (int)animations.size()) {
-        const auto& clip = animations[animIndex];
-        float t = wrapTime(timeSec, clip.durationSec);
+    buildPoseMatrices(0.0f, -1, locals, globals);
+    accumulatePose(globals, restBounds);
 
-        for (const auto& ch : clip.channels) {
-            if (ch.targetNode < 0 || ch.targetNode >= (int)outLocal.size()) continue;
-            if (ch.samplerIndex < 0 || ch.samplerIndex >= (int)clip.samplers.size()) continue;
-            const auto& s = clip.samplers[ch.samplerIndex];
-
-            if (ch.path == ChannelPath::Translation) {
-                glm::vec4 v = sampleVec4(s, t);
-                outLocal[ch.targetNode].t = glm::vec3(v.x, v.y, v.z);
-                outLocal[ch.targetNode].hasMatrix = false;
-            } else if (ch.path == ChannelPath::Scale) {
-                glm::vec4 v = sampleVec4(s, t);
-                outLocal[ch.targetNode].s = glm::vec3(v.x, v.y, v.z);
-                outLocal[ch.targetNode].hasMatrix = false;
-            } else if (ch.path == ChannelPath::Rotation) {
-                outLocal[ch.targetNode].r = sampleQuat(s, t);
-                outLocal[ch.targetNode].hasMatrix = false;
-            }
+    for (size_t a = 0; a < animations.size(); ++a) {
+        const float dur = animations[a].durationSec;
+        const int samples = (dur > 0.0f)
+            ? (std::clamp)((int)std::ceil(dur * kBoundsSampleHz), 1, kMaxBoundsSamples) : 1;
+
+        // The end itself wraps to t = 0, so the last sample sits just before it (where
+        // clamped one-shots hold their final pose).
+        const float lastT = (std::max)(dur - 1e-4f, 0.0f);
+        for (int s = 0; s <= samples; ++s) {
+            buildPoseMatrices((std::min)(dur * (float)s / (float)samples, lastT), (int)a, locals, globals);
+            accumulatePose(globals, clipBounds[a]);
         }
     }
+}
+
+void Model::bakeAnimations(CPUGeometry& geo)
+{
+    geo.bakedFrames.clear();
+    bakedClips.clear();
+    bakedFrameStride = 0;
+
+    // Without node meshes nothing is posed (see drawAnimated), so there is nothing to bake.
+    if (meshNodeOrder.empty() || animations.empty()) return;
 
-    std::function<void(int, const glm::mat4&)> dfs = [&](int node, const glm::mat4& parent) {
-        if (node < 0 || node >= (int)outLocal.size()) return;
-        glm::mat4 localM = trsToMat4(outLocal[node]);
-        glm::mat4 global = parent * localM;
-        outGlobal[node] = global;
+    uint32_t stride = 0;
+    for (uint32_t s : meshSlotStride) stride += s;
 
-        if (node < (int)nodeChildren.size()) {
-            for (int c : nodeChildren[node]) dfs(c, global);
+    PoseCacheEntry pose;
+    std::vector<NodeTRS> locals;
+    auto appendFrame = [&](float t, int animIndex) {
+        buildPoseMatrices(t, animIndex, locals, pose.globals);
+        buildJointPalettes(pose);
+        for (size_t k = 0; k < meshNodeOrder.size(); ++k) {
+            geo.bakedFrames.push_back(pose.globals[(size_t)meshNodeOrder[k]]);
+            const int offset = meshNodePaletteOffset[k];
+            if (offset < 0) continue;
+            geo.bakedFrames.insert(geo.bakedFrames.end(),
+                                   pose.palettes.begin() + offset,
+                                   pose.palettes.begin() + offset + (std::ptrdiff_t)(meshSlotStride[k] - 1));
         }
     };
 
-    if (sceneRoots.empty()) {
-        dfs(0, glm::mat4(1.0f));
-    } else {
-        for (int r : sceneRoots) dfs(r, glm::mat4(1.0f));
+    appendFrame(0.0f, -1); // frame 0: rest pose
+
+    uint32_t nextFrame = 1;
+    bakedClips.resize(animations.size());
+    for (size_t a = 0; a < animations.size(); ++a) {
+        const float dur = animations[a].durationSec;
+        const uint32_t intervals = (dur > 0.0f)
+            ? (uint32_t)(std::clamp)((int)std::ceil(dur * kBakedAnimRate), 1, kMaxBakedFramesPerClip) : 0u;
+
+        bakedClips[a].firstFrame = nextFrame;
+        bakedClips[a].frameCount = intervals;
+
+        // Same end handling as the clip bounds: the last frame is the held one-shot pose.
+        const float lastT = (std::max)(dur - 1e-4f, 0.0f);
+        for (uint32_t f = 0; f <= intervals; ++f) {
+            const float t = intervals ? dur * (float)f / (float)intervals : 0.0f;
+            appendFrame((std::min)(t, lastT), (int)a);
+        }
+        nextFrame += intervals + 1;
     }
+
+    bakedFrameStride = stride;
 }
 
-void Model::drawAnimated(const Camera3D& camera,
-                         const glm::mat4& instanceTransform,
-                         float animTimeSec,
-                         int animIndex) const
+void Model::bakedFramePair(int animIndex, float timeSec, uint32_t& frameA, uint32_t& frameB, float& blend) const
 {
-    if (!modelShader || VAO == 0) return;
+    frameA = frameB = 0; // rest pose
+    blend = 0.0f;
+    if (animIndex < 0 || animIndex >= (int)bakedClips.size()) return;
+
+    const BakedClip& clip = bakedClips[(size_t)animIndex];
+    const float dur = animations[(size_t)animIndex].durationSec;
+    frameA = frameB = clip.firstFrame;
+    if (clip.frameCount == 0 || dur <= 0.0f) return;
+
+    const float pos = wrapTime(timeSec, dur) / dur * (float)clip.frameCount;
+    const uint32_t f = (std::min)((uint32_t)pos, clip.frameCount - 1);
+    frameA = clip.firstFrame + f;
+    frameB = frameA + 1;
+    blend  = (std::clamp)(pos - (float)f, 0.0f, 1.0f);
+}
+
+void Model::poseCacheKey(float timeSec, int animIndex, int& key, int64_t& timeKey) const
+{
+    key = -1;
+    timeKey = 0;
+    if (animIndex >= 0 && animIndex < (int)animations.size()) {
+        key = animIndex;
+        const float t = wrapTime(timeSec, animations[(size_t)animIndex].durationSec);
+        timeKey = (int64_t)std::floor(t / kPoseCacheTimeQuantumSec);
+    }
+}
+
+const Model::PoseCacheEntry* Model::findCachedPose(int key, int64_t timeKey) const
+{
+    for (const auto& e : poseCache) {
+        if (e.frame == g_poseCacheFrame && e.animIndex == key && e.timeKey == timeKey) return &e;
+    }
+    return nullptr;
+}
 
+const Model::PoseCacheEntry& Model::getCachedPose(float timeSec, int animIndex) const
+{
+    int key = -1;
+    int64_t timeKey = 0;
+    poseCacheKey(timeSec, animIndex, key, timeKey);
+
+    PoseCacheEntry* slot = nullptr;
+    for (auto& e : poseCache) {
+        if (e.frame == g_poseCacheFrame) {
+            if (e.animIndex == key && e.timeKey == timeKey) {
+                ++poseCacheStats.hits;
+                ++g_poseCacheStatsTotal.hits;
+                return e;
+            }
+        } else if (!slot) {
+            slot = &e;
+        }
+    }
+
+    if (!slot) {
+        poseCache.emplace_back();
+        slot = &poseCache.back();
+    }
+
+    ++poseCacheStats.misses;
+    ++g_poseCacheStatsTotal.misses;
+
+    slot->animIndex = key;
+    slot->timeKey   = timeKey;
+    slot->frame     = g_poseCacheFrame;
+
+    // Sample at the quantized time so every instance sharing this key sees the same pose.
+    buildPoseMatrices((float)timeKey * kPoseCacheTimeQuantumSec, key, poseScratchLocals, slot->globals);
+    buildJointPalettes(*slot);
+    return *slot;
+}
+
+namespace {
+
+// Restores the GL state the model passes touch on scope exit (UI relies on these).
+// The snapshot comes from GLStateCache's shadow copy, so no glGet round-trips.
+struct ModelDrawStateGuard {
+    GLStateCache& gl = GLStateCache::getInstance();
+    GLStateCache::Snapshot saved = gl.capture();
+
+    ~ModelDrawStateGuard()
+    {
+        gl.restore(saved);
+        gl.bindVertexArray(0);
+    }
+};
+
+} // namespace
+
+void Model::noteMissingAnimIndex(int animIndex) const
+{
     if (animIndex == 1 && (int)animations.size() <= 1) {
         if (warnedMissingAnimIndex.insert(animIndex).second) {
             std::cout << "[Model] NOTE: requested animation index 1, but model has "
                       << animations.size() << " animation(s). Drawing static.\n";
         }
     }
+}
 
-    std::vector<NodeTRS> locals;
-    std::vector<glm::mat4> globals;
-    buildPoseMatrices(animTimeSec, animIndex, locals, globals);
+// Positions in a packed VBO are unorm16 over the model AABB; identity for the float layout.
+void Model::applyVertexDecode() const
+{
+    if (locPosOffset >= 0) glUniform3fv(locPosOffset, 1, vertexQuant.offset);
+    if (locPosScale  >= 0) glUniform3fv(locPosScale,  1, vertexQuant.scale);
+}
 
-    modelShader->use();
-    glBindVertexArray(VAO);
+void Model::applyMaterial(const Submesh& sm) const
+{
+    auto& gl = GLStateCache::getInstance();
+
+    gl.bindTexture(0, GL_TEXTURE_2D, sm.baseColorTex.getID());
+    gl.bindTexture(1, GL_TEXTURE_2D, sm.emissiveTex.getID());
+
+    if (locEmissiveFactor >= 0) glUniform3fv(locEmissiveFactor, 1, glm::value_ptr(sm.emissiveFactor));
+    if (locAlphaMode      >= 0) glUniform1i(locAlphaMode, sm.alphaMode);
+    if (locAlphaCutoff    >= 0) glUniform1f(locAlphaCutoff, sm.alphaCutoff);
+
+    gl.setEnabled(GL_CULL_FACE, !sm.doubleSided);
+
+    // BLEND must enable blending AND disable depth writes.
+    if (sm.alphaMode == 2) { // BLEND
+        gl.enable(GL_BLEND);
+        gl.setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        gl.setDepthMask(false);
+    } else {
+        gl.disable(GL_BLEND);
+        gl.setDepthMask(true);
+    }
+}
 
-    // --- Save GL state (critical: UI relies on these) ---
-    const GLboolean prevCullEnabled  = glIsEnabled(GL_CULL_FACE);
-    const GLboolean prevBlendEnabled = glIsEnabled(GL_BLEND);
+void Model::drawAnimated(const Camera3D& camera,
+                         const glm::mat4& instanceTransform,
+                         float animTimeSec,
+                         int animIndex) const
+{
+    if (!modelShader || VAO == 0) return;
 
-    GLboolean prevDepthWrite = GL_TRUE;
-    glGetBooleanv(GL_DEPTH_WRITEMASK, &prevDepthWrite);
+    noteMissingAnimIndex(animIndex);
 
-    GLint prevActiveTex = 0;
-    glGetIntegerv(GL_ACTIVE_TEXTURE, &prevActiveTex);
+    const PoseCacheEntry& pose = getCachedPose(animTimeSec, animIndex);
+    const std::vector<glm::mat4>& globals = pose.globals;
 
-    GLint prevSrcRGB = GL_ONE, prevDstRGB = GL_ZERO, prevSrcA = GL_ONE, prevDstA = GL_ZERO;
-    glGetIntegerv(GL_BLEND_SRC_RGB,   &prevSrcRGB);
-    glGetIntegerv(GL_BLEND_DST_RGB,   &prevDstRGB);
-    glGetIntegerv(GL_BLEND_SRC_ALPHA, &prevSrcA);
-    glGetIntegerv(GL_BLEND_DST_ALPHA, &prevDstA);
+    ModelDrawStateGuard stateGuard;
 
-    GLint prevEqRGB = GL_FUNC_ADD, prevEqA = GL_FUNC_ADD;
-    glGetIntegerv(GL_BLEND_EQUATION_RGB,   &prevEqRGB);
-    glGetIntegerv(GL_BLEND_EQUATION_ALPHA, &prevEqA);
+    modelShader->use();
+    GLStateCache::getInstance().bindVertexArray(VAO);
+    applyVertexDecode();
 
     // bind sampler units once (safe even if uniforms are optimized out)
     if (locBaseColorTex >= 0) glUniform1i(locBaseColorTex, 0);
     if (locEmissiveTex  >= 0) glUniform1i(locEmissiveTex,  1);
+    if (locInstanced    >= 0) glUniform1i(locInstanced, 0);
+    if (locBaked        >= 0) glUniform1i(locBaked, 0);
 
-    auto setMaterial = [&](const Submesh& sm) {
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, sm.baseColorTexID);
-
-        glActiveTexture(GL_TEXTURE1);
-        glBindTexture(GL_TEXTURE_2D, sm.emissiveTexID);
+    bool hasNodeMesh = false;
 
-        if (locEmissiveFactor >= 0) glUniform3fv(locEmissiveFactor, 1, glm::value_ptr(sm.emissiveFactor));
-        if (locAlphaMode      >= 0) glUniform1i(locAlphaMode, sm.alphaMode);
-        if (locAlphaCutoff    >= 0) glUniform1f(locAlphaCutoff, sm.alphaCutoff);
+    const uint32_t lod = selectLod(instanceTransform, camera.getViewMatrix(), camera.getProjectionMatrix()[1][1]);
 
-        if (sm.doubleSided) glDisable(GL_CULL_FACE);
-        else glEnable(GL_CULL_FACE);
+    auto drawSubmeshRange = [&](const SubmeshRange& range) {
+        for (uint32_t i = range.begin; i < range.end; ++i) {
+            const Submesh& sm = submeshes[meshSubmeshOrder[i]];
+            const SubmeshLod& level = sm.lods[(std::min)(lod, sm.lodCount - 1)];
+            applyMaterial(sm);
 
-        // BLEND must enable blending AND disable depth writes.
-        if (sm.alphaMode == 2) { // BLEND
-            glEnable(GL_BLEND);
-            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-            glDepthMask(GL_FALSE);
-        } else {
-            glDisable(GL_BLEND);
-            glDepthMask(GL_TRUE);
+            glDrawElementsBaseVertex(GL_TRIANGLES,
+                                     (GLsizei)level.indexCount,
+                                     glIndexType(sm.indexType),
+                                     (void*)level.indexByteOffset,
+                                     (GLint)sm.baseVertex);
         }
     };
 
-    bool hasNodeMesh = false;
-
-    auto drawMeshAtNode = [&](int nodeIdx, const glm::mat4& nodeGlobal) {
+    auto drawMeshAtNode = [&](size_t meshSlot) {
+        const int nodeIdx = meshNodeOrder[meshSlot];
         if (nodeIdx < 0 || nodeIdx >= (int)nodeMesh.size()) return;
         int meshIdx = nodeMesh[nodeIdx];
         if (meshIdx < 0) return;
 
         hasNodeMesh = true;
 
-        glm::mat4 vp  = camera.getProjectionMatrix() * camera.getViewMatrix();
-        glm::mat4 mvp = vp * instanceTransform * nodeGlobal;
+        const glm::mat4& vp = camera.getViewProjectionMatrix();
+        glm::mat4 mvp = vp * instanceTransform * globals[(size_t)nodeIdx];
         glUniformMatrix4fv(locMVP, 1, GL_FALSE, glm::value_ptr(mvp));
 
-        uploadSkinUniforms(nodeGlobal,
-                           (nodeIdx < (int)nodeSkin.size() ? nodeSkin[nodeIdx] : -1),
-                           globals);
-
-        // Two-pass inside the mesh: opaque/mask first, then blend.
-        for (int pass = 0; pass < 2; ++pass) {
-            for (const auto& sm : submeshes) {
-                if (sm.meshIndex != meshIdx) continue;
-
-                const bool isBlend = (sm.alphaMode == 2);
-                if ((pass == 0 && isBlend) || (pass == 1 && !isBlend)) continue;
-
-                setMaterial(sm);
-
-                glDrawElements(GL_TRIANGLES,
-                               (GLsizei)sm.indexCount,
-                               GL_UNSIGNED_INT,
-                               (void*)(sm.indexOffset * sizeof(uint32_t)));
-            }
-        }
-    };
-
-    std::function<void(int, const glm::mat4&)> dfsDraw = [&](int node, const glm::mat4& parent) {
-        if (node < 0 || node >= (int)locals.size()) return;
+        uploadSkinUniforms(pose, meshSlot);
 
-        glm::mat4 localM  = trsToMat4(locals[node]);
-        glm::mat4 globalM = parent * localM;
-
-        drawMeshAtNode(node, globalM);
-
-        if (node < (int)nodeChildren.size()) {
-            for (int c : nodeChildren[node]) dfsDraw(c, globalM);
-        }
+        // Range is ordered opaque/mask first, then blend.
+        drawSubmeshRange(submeshRangeForMesh(meshIdx));
     };
 
-    if (sceneRoots.empty()) {
-        dfsDraw(0, glm::mat4(1.0f));
-    } else {
-        for (int r : sceneRoots) dfsDraw(r, glm::mat4(1.0f));
+    // Globals and palettes come from the pose pass; just visit mesh nodes in hierarchy order.
+    for (size_t k = 0; k < meshNodeOrder.size(); ++k) {
+        drawMeshAtNode(k);
     }
 
     // fallback: if nodeMesh is empty, draw everything once with instanceTransform
     if (!hasNodeMesh) {
-        glm::mat4 vp  = camera.getProjectionMatrix() * camera.getViewMatrix();
+        const glm::mat4& vp = camera.getViewProjectionMatrix();
         glm::mat4 mvp = vp * instanceTransform;
         glUniformMatrix4fv(locMVP, 1, GL_FALSE, glm::value_ptr(mvp));
         glUniform1i(locUseSkin, 0);
 
         // opaque/mask then blend
-        for (int pass = 0; pass < 2; ++pass) {
-            for (const auto& sm : submeshes) {
-                const bool isBlend = (sm.alphaMode == 2);
-                if ((pass == 0 && isBlend) || (pass == 1 && !isBlend)) continue;
+        drawSubmeshRange(submeshRangeForMesh(-1));
+    }
+}
 
-                setMaterial(sm);
+void Model::uploadBakedFrames(const glm::mat4* frames, size_t matrixCount)
+{
+    if (!frames || matrixCount == 0 || bakedFrameStride == 0) {
+        bakedFrameStride = 0;
+        return;
+    }
 
-                glDrawElements(GL_TRIANGLES,
-                               (GLsizei)sm.indexCount,
-                               GL_UNSIGNED_INT,
-                               (void*)(sm.indexOffset * sizeof(uint32_t)));
-            }
-        }
+    GLint maxTexels = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &maxTexels);
+    if ((uint64_t)matrixCount * 4 > (uint64_t)(std::max)(maxTexels, 0)) {
+        std::cerr << "[Model] WARNING: baked animation atlas (" << matrixCount
+                  << " matrices) exceeds GL_MAX_TEXTURE_BUFFER_SIZE; using live sampling.\n";
+        bakedFrameStride = 0;
+        return;
     }
 
-    // --- Restore previous GL state (critical: UI relies on these) ---
-    glDepthMask(prevDepthWrite);
+    glGenBuffers(1, &bakedTbo);
+    glBindBuffer(GL_TEXTURE_BUFFER, bakedTbo);
+    glBufferData(GL_TEXTURE_BUFFER, (GLsizeiptr)(matrixCount * sizeof(glm::mat4)), frames, GL_STATIC_DRAW);
+
+    glGenTextures(1, &bakedTex);
+    GLStateCache::getInstance().bindTexture(GL_TEXTURE_BUFFER, bakedTex);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, bakedTbo);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+
+// ------------------------------------------------------------
+// Instanced draw
+// ------------------------------------------------------------
+bool Model::isInstancingEnabled()
+{
+    static const bool enabled = [] {
+        const char* env = std::getenv("PAC_DISABLE_INSTANCING");
+        return !(env && *env && std::string(env) != "0");
+    }();
+    return enabled;
+}
 
-    if (prevBlendEnabled) glEnable(GL_BLEND);
-    else glDisable(GL_BLEND);
+bool Model::isLodEnabled()
+{
+    static const bool enabled = [] {
+        const char* env = std::getenv("PAC_DISABLE_LOD");
+        return !(env && *env && std::string(env) != "0");
+    }();
+    return enabled;
+}
+
+uint32_t Model::getSubmeshTriangleCount(uint32_t submesh, uint32_t lod) const
+{
+    if (submesh >= submeshes.size()) return 0;
+    const Submesh& sm = submeshes[submesh];
+    return (uint32_t)(sm.lods[(std::min)(lod, sm.lodCount - 1)].indexCount / 3);
+}
 
-    glBlendFuncSeparate(prevSrcRGB, prevDstRGB, prevSrcA, prevDstA);
-    glBlendEquationSeparate(prevEqRGB, prevEqA);
+const Aabb& Model::getMeshBounds(int meshIndex) const
+{
+    static const Aabb kEmpty{};
+    if (meshIndex < 0 || meshIndex >= (int)meshBounds.size()) return kEmpty;
+    return meshBounds[(size_t)meshIndex];
+}
 
-    if (prevCullEnabled) glEnable(GL_CULL_FACE);
-    else glDisable(GL_CULL_FACE);
+const Aabb& Model::getAnimationBounds(int animIndex) const
+{
+    if (animIndex < 0 || animIndex >= (int)clipBounds.size()) return restBounds;
+    return clipBounds[(size_t)animIndex];
+}
 
-    glActiveTexture((GLenum)prevActiveTex);
+Aabb Model::getWorldBounds(const glm::mat4& instanceTransform, int animIndex) const
+{
+    return getAnimationBounds(animIndex).transformed(instanceTransform);
+}
 
-    glBindVertexArray(0);
+uint32_t Model::selectLod(const glm::mat4& instanceTransform, const glm::mat4& view, float projScaleY) const
+{
+    if (lodCount <= 1 || boundsRadius <= 0.0f || !isLodEnabled()) return 0;
+
+    const glm::vec3 center = glm::vec3(instanceTransform * glm::vec4(boundsCenter, 1.0f));
+    const float scale = (std::max)({ glm::length(glm::vec3(instanceTransform[0])),
+                                     glm::length(glm::vec3(instanceTransform[1])),
+                                     glm::length(glm::vec3(instanceTransform[2])) });
+    const float radius = boundsRadius * scale;
+    const float depth = -(view * glm::vec4(center, 1.0f)).z;
+    if (depth <= radius) return 0; // camera at or inside the sphere
+
+    // Sphere radius as a fraction of half the screen height; a LOD's error scales with it.
+    const float projectedRadius = radius * projScaleY / depth;
+    for (uint32_t l = lodCount - 1; l > 0; --l) {
+        if (lodErrors[l] / boundsRadius * projectedRadius <= kLodMaxScreenError) return l;
+    }
+    return 0;
+}
+
+void Model::submitInstanced(RenderQueue& queue, const std::vector<DrawInstance>& instances) const
+{
+    if (!modelShader || VAO == 0 || instances.empty()) return;
+
+    if (locInstanced < 0 || locInstanceData < 0) {
+        std::cerr << "[Model] WARNING: model shader has no instanced path; nothing submitted.\n";
+        return;
+    }
+
+    static GLint maxTexels = 0;
+    if (maxTexels == 0) {
+        glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &maxTexels);
+        if (maxTexels <= 0) maxTexels = 65536; // GL 3.3 minimum
+    }
+
+    // Chunks staged for an earlier frame are free again; within a frame they accumulate
+    // so every item recorded into the queue still points at live data at flush time.
+    if (instanceChunksFrame != queue.getFrameId()) {
+        instanceChunksFrame = queue.getFrameId();
+        instanceChunksUsed = 0;
+    }
+
+    for (const auto& inst : instances) noteMissingAnimIndex(inst.animIndex);
+
+    auto& gl = GLStateCache::getInstance();
+
+    modelShader->use();
+    if (locBaseColorTex >= 0) glUniform1i(locBaseColorTex, 0);
+    if (locEmissiveTex  >= 0) glUniform1i(locEmissiveTex,  1);
+    glUniform1i(locInstanceData, 2);
+    if (locViewProj >= 0) glUniformMatrix4fv(locViewProj, 1, GL_FALSE, glm::value_ptr(queue.getViewProj()));
+
+    const bool hasNodeMesh = !meshNodeOrder.empty();
+    const size_t slotCount = meshSlotStride.size();
+    const uint32_t shaderKey = (uint32_t)modelShader->getID();
+
+    // Live and baked instances have different record layouts, so each group gets its own
+    // chunks: live records carry the posed node global and palette, baked ones only the
+    // transform and a frame pair into the atlas.
+    const bool canBake = hasNodeMesh && hasBakedAnimation();
+    for (int pass = 0; pass < 2; ++pass) {
+        const bool baked = (pass == 1);
+        if (baked && !canBake) break;
+
+        instanceGroup.clear();
+        for (size_t i = 0; i < instances.size(); ++i) {
+            if ((canBake && instances[i].baked) == baked) instanceGroup.push_back((uint32_t)i);
+        }
+        if (instanceGroup.empty()) continue;
+
+        auto slotStride = [&](size_t k) { return baked ? kBakedRecordMats : meshSlotStride[k]; };
+
+        size_t matsPerInstance = 0;
+        for (size_t k = 0; k < slotCount; ++k) matsPerInstance += slotStride(k);
+
+        const size_t maxInstancesPerChunk =
+            (std::max)((size_t)1, (size_t)maxTexels / (matsPerInstance * 4));
+
+        for (size_t first = 0; first < instanceGroup.size(); first += maxInstancesPerChunk) {
+            const size_t count = (std::min)(maxInstancesPerChunk, instanceGroup.size() - first);
+
+            if (instanceChunksUsed == instanceChunks.size()) {
+                InstanceChunk chunk;
+                glGenBuffers(1, &chunk.tbo);
+                glGenTextures(1, &chunk.tex);
+                glBindBuffer(GL_TEXTURE_BUFFER, chunk.tbo);
+                glBufferData(GL_TEXTURE_BUFFER, 0, nullptr, GL_STREAM_DRAW);
+                gl.bindTexture(GL_TEXTURE_BUFFER, chunk.tex);
+                glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, chunk.tbo);
+                instanceChunks.push_back(std::move(chunk));
+            }
+
+            const uint16_t chunkIndex = (uint16_t)instanceChunksUsed++;
+            InstanceChunk& chunk = instanceChunks[chunkIndex];
+            chunk.count = (uint32_t)count;
+            chunk.baked = baked;
+            chunk.slotBase.resize(slotCount);
+
+            size_t total = 0;
+            for (size_t k = 0; k < slotCount; ++k) {
+                chunk.slotBase[k] = (uint32_t)total;
+                total += slotStride(k) * count;
+            }
+            instanceStaging.resize(total);
+
+            // LOD per instance, then instances grouped by LOD (counting sort) so each level is one
+            // contiguous instance range in the chunk: lodFirst[l] .. lodFirst[l + 1].
+            uint32_t lodFirst[pac_model_types::kMaxMeshLods + 1] = {};
+            instanceLod.resize(count);
+            for (size_t i = 0; i < count; ++i) {
+                instanceLod[i] = (uint8_t)selectLod(instances[instanceGroup[first + i]].transform, queue.getView(), queue.getProjScaleY());
+                ++lodFirst[instanceLod[i] + 1];
+            }
+            for (uint32_t l = 0; l < pac_model_types::kMaxMeshLods; ++l) lodFirst[l + 1] += lodFirst[l];
+
+            instanceOrder.resize(count);
+            {
+                uint32_t cursor[pac_model_types::kMaxMeshLods];
+                std::copy(lodFirst, lodFirst + pac_model_types::kMaxMeshLods, cursor);
+                for (size_t i = 0; i < count; ++i) instanceOrder[cursor[instanceLod[i]]++] = (uint32_t)i;
+            }
+
+            for (size_t i = 0; i < count; ++i) {
+                const DrawInstance& inst = instances[instanceGroup[first + instanceOrder[i]]];
+
+                if (!hasNodeMesh) {
+                    instanceStaging[chunk.slotBase[0] + i] = inst.transform;
+                    continue;
+                }
+
+                if (baked) {
+                    uint32_t frameA = 0, frameB = 0;
+                    float blend = 0.0f;
+                    bakedFramePair(inst.animIndex, inst.animTimeSec, frameA, frameB, blend);
+
+                    glm::mat4 frames(0.0f);
+                    frames[0] = glm::vec4((float)frameA, (float)frameB, blend, 0.0f);
+                    for (size_t k = 0; k < slotCount; ++k) {
+                        glm::mat4* dst = instanceStaging.data() + chunk.slotBase[k] + i * kBakedRecordMats;
+                        dst[0] = inst.transform;
+                        dst[1] = frames;
+                    }
+                    continue;
+                }
+
+                // Copy out before the next lookup: getCachedPose may grow the cache.
+                const PoseCacheEntry& pose = getCachedPose(inst.animTimeSec, inst.animIndex);
+                for (size_t k = 0; k < slotCount; ++k) {
+                    glm::mat4* dst = instanceStaging.data() + chunk.slotBase[k] + i * meshSlotStride[k];
+                    dst[0] = inst.transform * pose.globals[(size_t)meshNodeOrder[k]];
+
+                    const int offset = meshNodePaletteOffset[k];
+                    if (offset >= 0) {
+                        std::copy(pose.palettes.begin() + offset,
+                                  pose.palettes.begin() + offset + (std::ptrdiff_t)(meshSlotStride[k] - 1),
+                                  dst + 1);
+                    }
+                }
+            }
+
+            // Orphan + refill so a reused chunk never stalls on last frame's draws.
+            const GLsizeiptr bytes = (GLsizeiptr)(instanceStaging.size() * sizeof(glm::mat4));
+            glBindBuffer(GL_TEXTURE_BUFFER, chunk.tbo);
+            glBufferData(GL_TEXTURE_BUFFER, bytes, nullptr, GL_STREAM_DRAW);
+            glBufferSubData(GL_TEXTURE_BUFFER, 0, bytes, instanceStaging.data());
+
+            // Record draw items.
+            for (size_t k = 0; k < slotCount; ++k) {
+                const SubmeshRange& range = submeshRangeForMesh(meshIndexForSlot(k));
+                if (range.begin == range.end) continue;
+
+                RenderQueue::DrawItem item;
+                item.model    = this;
+                item.meshSlot = (uint16_t)k;
+                item.chunk    = chunkIndex;
+
+                for (uint32_t l = 0; l < pac_model_types::kMaxMeshLods; ++l) {
+                    const uint32_t lodBegin = lodFirst[l], lodEnd = lodFirst[l + 1];
+                    if (lodBegin == lodEnd) continue;
+                    item.lod = (uint8_t)l;
+
+                    // Nearest instance drives the opaque depth (front-to-back for early-z).
+                    float nearest = std::numeric_limits<float>::max();
+                    for (uint32_t i = lodBegin; i < lodEnd; ++i) {
+                        const glm::mat4& m = instanceStaging[chunk.slotBase[k] + i * slotStride(k)];
+                        nearest = (std::min)(nearest, queue.viewDepth(glm::vec3(m[3])));
+                    }
+
+                    for (uint32_t r = range.begin; r < range.blendBegin; ++r) {
+                        const uint32_t smIdx = meshSubmeshOrder[r];
+                        item.submesh       = smIdx;
+                        item.firstInstance = lodBegin;
+                        item.instanceCount = lodEnd - lodBegin;
+                        item.key = RenderQueue::makeKey(false, shaderKey, submeshes[smIdx].baseColorTex.getID(),
+                                                        queue.depth01(nearest));
+                        queue.push(item);
+                    }
+
+                    // Blended submeshes: one item per instance so they interleave back-to-front.
+                    for (uint32_t r = range.blendBegin; r < range.end; ++r) {
+                        const uint32_t smIdx = meshSubmeshOrder[r];
+                        for (uint32_t i = lodBegin; i < lodEnd; ++i) {
+                            const glm::mat4& m = instanceStaging[chunk.slotBase[k] + i * slotStride(k)];
+                            item.submesh       = smIdx;
+                            item.firstInstance = i;
+                            item.instanceCount = 1;
+                            item.key = RenderQueue::makeKey(true, shaderKey, submeshes[smIdx].baseColorTex.getID(),
+                                                            queue.depth01(queue.viewDepth(glm::vec3(m[3]))));
+                            queue.push(item);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+
+void Model::drawQueued(const RenderQueue::DrawItem& item) const
+{
+    if (item.chunk >= instanceChunksUsed || item.submesh >= submeshes.size()) return;
+
+    auto& gl = GLStateCache::getInstance();
+    const InstanceChunk& chunk = instanceChunks[item.chunk];
+
+    modelShader->use();
+    gl.bindVertexArray(VAO);
+    gl.bindTexture(2, GL_TEXTURE_BUFFER, chunk.tex);
+    applyVertexDecode();
+
+    const size_t k = item.meshSlot;
+    const bool skinned = !meshNodeOrder.empty() && meshNodePaletteOffset[k] >= 0;
+    const uint32_t stride = chunk.baked ? kBakedRecordMats : meshSlotStride[k];
+
+    glUniform1i(locInstanced, 1);
+    glUniform1i(locUseSkin, skinned ? 1 : 0);
+    if (locBaked >= 0) glUniform1i(locBaked, chunk.baked ? 1 : 0);
+    if (chunk.baked) {
+        uint32_t slotOffset = 0;
+        for (size_t s = 0; s < k; ++s) slotOffset += meshSlotStride[s];
+
+        gl.bindTexture(3, GL_TEXTURE_BUFFER, bakedTex);
+        if (locBakedFrameStride >= 0) glUniform1i(locBakedFrameStride, (GLint)(bakedFrameStride * 4));
+        if (locBakedSlotOffset  >= 0) glUniform1i(locBakedSlotOffset,  (GLint)(slotOffset * 4));
+    }
+    if (locInstanceBase   >= 0) glUniform1i(locInstanceBase,   (GLint)((chunk.slotBase[k] + item.firstInstance * stride) * 4));
+    if (locInstanceStride >= 0) glUniform1i(locInstanceStride, (GLint)(stride * 4));
+
+    const Submesh& sm = submeshes[item.submesh];
+    const SubmeshLod& level = sm.lods[(std::min)((uint32_t)item.lod, sm.lodCount - 1)];
+    applyMaterial(sm);
+
+    glDrawElementsInstancedBaseVertex(GL_TRIANGLES,
+                                      (GLsizei)level.indexCount,
+                                      glIndexType(sm.indexType),
+                                      (void*)level.indexByteOffset,
+                                      (GLsizei)item.instanceCount,
+                                      (GLint)sm.baseVertex);
 }
 
 // ✅ NEW: animated node global transform (MODEL SPACE)
@@ -326,14 +1170,216 @@ bool Model::getNodeGlobalTransformByIndex(float animTimeSec,
                                          int nodeIndex,
                                          glm::mat4& outNodeGlobal) const
 {
-    if (nodeIndex < 0 || nodeIndex >= (int)nodesDefault.size()) return false;
+    return evaluateSocket(getSocket(nodeIndex), animTimeSec, animIndex, outNodeGlobal);
+}
 
-    std::vector<NodeTRS> locals;
-    std::vector<glm::mat4> globals;
-    buildPoseMatrices(animTimeSec, animIndex, locals, globals);
+bool Model::getNodeIndexByName(const std::string& nodeName, int& outNodeIndex) const
+{
+    if (!nodeNameMapBuilt) {
+        nodeNameToIndex.clear();
+        for (size_t i = 0; i < nodeNames.size(); ++i) {
+            if (!nodeNames[i].empty()) nodeNameToIndex.emplace(nodeNames[i], (int)i); // first wins
+        }
+        nodeNameMapBuilt = true;
+    }
 
-    if (nodeIndex < 0 || nodeIndex >= (int)globals.size()) return false;
+    const auto it = nodeNameToIndex.find(nodeName);
+    if (it == nodeNameToIndex.end()) return false;
+    outNodeIndex = it->second;
+    return true;
+}
 
-    outNodeGlobal = globals[nodeIndex];
+bool Model::getNodeGlobalTransformByName(float animTimeSec,
+                                        int animIndex,
+                                        const std::string& nodeName,
+                                        glm::mat4& outNodeGlobal) const
+{
+    return evaluateSocket(getSocketByName(nodeName), animTimeSec, animIndex, outNodeGlobal);
+}
+
+int Model::getSocket(int nodeIndex) const
+{
+    if (nodeIndex < 0 || nodeIndex >= (int)nodesDefault.size()) return -1;
+
+    const auto it = nodeSocket.find(nodeIndex);
+    if (it != nodeSocket.end()) return it->second;
+
+    Socket s;
+    s.node = nodeIndex;
+    for (int n = nodeIndex; n >= 0; n = (n < (int)nodeParent.size()) ? nodeParent[(size_t)n] : -1) {
+        s.chain.push_back(n);
+        if (s.chain.size() > nodesDefault.size()) break; // malformed parent links
+    }
+    std::reverse(s.chain.begin(), s.chain.end());
+    s.locals.resize(s.chain.size());
+
+    s.channels.resize(animations.size());
+    s.cursors.resize(animations.size());
+    for (size_t a = 0; a < animations.size(); ++a) {
+        const auto& clip = animations[a];
+        for (size_t c = 0; c < clip.channels.size(); ++c) {
+            const auto& ch = clip.channels[c];
+            if (ch.samplerIndex < 0 || ch.samplerIndex >= (int)clip.samplers.size()) continue;
+            const auto link = std::find(s.chain.begin(), s.chain.end(), ch.targetNode);
+            if (link == s.chain.end()) continue;
+            s.channels[a].push_back(SocketChannel{ (uint32_t)c, (uint32_t)(link - s.chain.begin()) });
+        }
+        s.cursors[a].assign(s.channels[a].size(), 0u);
+    }
+
+    const int id = (int)sockets.size();
+    sockets.push_back(std::move(s));
+    nodeSocket.emplace(nodeIndex, id);
+    return id;
+}
+
+int Model::getSocketByName(const std::string& nodeName) const
+{
+    int node = -1;
+    return getNodeIndexByName(nodeName, node) ? getSocket(node) : -1;
+}
+
+bool Model::evaluateSocket(int socket, float animTimeSec, int animIndex, glm::mat4& outNodeGlobal) const
+{
+    if (socket < 0 || socket >= (int)sockets.size()) return false;
+    Socket& s = sockets[(size_t)socket];
+
+    int key = -1;
+    int64_t timeKey = 0;
+    poseCacheKey(animTimeSec, animIndex, key, timeKey);
+
+    if (s.frame == g_poseCacheFrame && s.animIndex == key && s.timeKey == timeKey) {
+        outNodeGlobal = s.global;
+        return true;
+    }
+
+    if (const PoseCacheEntry* pose = findCachedPose(key, timeKey)) {
+        s.global = pose->globals[(size_t)s.node];
+    } else {
+        for (size_t i = 0; i < s.chain.size(); ++i) s.locals[i] = nodesDefault[(size_t)s.chain[i]];
+
+        if (key >= 0) {
+            // Same quantized time as getCachedPose, so both paths agree.
+            const auto& clip = animations[(size_t)key];
+            const float t = (float)timeKey * kPoseCacheTimeQuantumSec;
+            const auto& channels = s.channels[(size_t)key];
+            auto& cursors = s.cursors[(size_t)key];
+            for (size_t j = 0; j < channels.size(); ++j) {
+                const auto& ch = clip.channels[channels[j].channel];
+                const auto& sampler = clip.samplers[(size_t)ch.samplerIndex];
+                const size_t k = findKeyframeFromCursor(sampler.inputs, t, cursors[j]);
+                applyChannelValue(s.locals[channels[j].link], ch.path, sampleAtKey(sampler, t, k));
+            }
+        }
+
+        glm::mat4 global(1.0f);
+        for (const NodeTRS& local : s.locals) global = global * trsToMat4(local);
+        s.global = global;
+
+        ++poseCacheStats.socketChainEvals;
+        ++g_poseCacheStatsTotal.socketChainEvals;
+    }
+
+    s.frame     = g_poseCacheFrame;
+    s.animIndex = key;
+    s.timeKey   = timeKey;
+    outNodeGlobal = s.global;
     return true;
 }
+
+// ------------------------------------------------------------
+// Sampling microbenchmark (pac_bench anim)
+// ------------------------------------------------------------
+// The sampling path as it was before interpolation became an enum, kept as the baseline:
+// string interpolation compared per sample, vec4 keys, binary search every time (cubic
+// splines were sampled as linear then).
+namespace {
+
+struct LegacySampler {
+    std::vector<float> inputs;
+    std::vector<glm::vec4> outputs;
+    std::string interpolation; // "LINEAR" / "STEP" / "CUBICSPLINE", as glTF spells it
+};
+
+glm::vec4 legacySampleVec4(const LegacySampler& s, float t)
+{
+    if (s.inputs.empty() || s.outputs.empty()) return glm::vec4(0.0f);
+
+    size_t i = findKeyframe(s.inputs, t);
+    if (i >= s.inputs.size() - 1) {
+        return s.outputs[(std::min)(i, s.outputs.size() - 1)];
+    }
+
+    float t0 = s.inputs[i];
+    float t1 = s.inputs[i + 1];
+    float a = (t1 > t0) ? ((t - t0) / (t1 - t0)) : 0.0f;
+
+    glm::vec4 v0 = s.outputs[(std::min)(i, s.outputs.size() - 1)];
+    glm::vec4 v1 = s.outputs[(std::min)(i + 1, s.outputs.size() - 1)];
+
+    if (s.interpolation == "STEP") return v0;
+    return glm::mix(v0, v1, a);
+}
+
+} // namespace
+
+Model::SamplingBenchResult Model::benchmarkSampling(int framesPerClip) const
+{
+    using clock = std::chrono::steady_clock;
+
+    SamplingBenchResult r{};
+    if (framesPerClip <= 0) return r;
+
+    constexpr float kFrameDt = 1.0f / 60.0f;
+    float checksum = 0.0f;
+
+    // Legacy copies of every clip's samplers (same keys, decoded to vec4), built untimed.
+    std::vector<std::vector<LegacySampler>> legacy(animations.size());
+    for (size_t a = 0; a < animations.size(); ++a) {
+        for (const auto& s : animations[a].samplers) {
+            LegacySampler l;
+            l.inputs = s.inputs;
+            l.outputs.resize(s.valueCount());
+            for (size_t k = 0; k < l.outputs.size(); ++k) l.outputs[k] = keyValue(s, k);
+            l.interpolation = (s.interpolation == Interpolation::Step)        ? "STEP" :
+                              (s.interpolation == Interpolation::CubicSpline) ? "CUBICSPLINE" : "LINEAR";
+            legacy[a].push_back(std::move(l));
+        }
+    }
+
+    // "before": the legacy path above.
+    auto t0 = clock::now();
+    for (size_t a = 0; a < animations.size(); ++a) {
+        const auto& clip = animations[a];
+        for (int f = 0; f < framesPerClip; ++f) {
+            const float t = wrapTime((float)f * kFrameDt, clip.durationSec);
+            for (const auto& ch : clip.channels) {
+                if (ch.samplerIndex < 0 || ch.samplerIndex >= (int)clip.samplers.size()) continue;
+                checksum += legacySampleVec4(legacy[a][(size_t)ch.samplerIndex], t).x;
+                ++r.channels;
+            }
+        }
+    }
+    auto t1 = clock::now();
+
+    // "after": per-channel cursor, stepping forward with playback.
+    std::vector<uint32_t> cursors;
+    for (const auto& clip : animations) {
+        cursors.assign(clip.channels.size(), 0u);
+        for (int f = 0; f < framesPerClip; ++f) {
+            const float t = wrapTime((float)f * kFrameDt, clip.durationSec);
+            for (size_t c = 0; c < clip.channels.size(); ++c) {
+                const auto& ch = clip.channels[c];
+                if (ch.samplerIndex < 0 || ch.samplerIndex >= (int)clip.samplers.size()) continue;
+                const auto& s = clip.samplers[(size_t)ch.samplerIndex];
+                checksum += sampleAtKey(s, t, findKeyframeFromCursor(s.inputs, t, cursors[c])).x;
+            }
+        }
+    }
+    auto t2 = clock::now();
+
+    r.legacySec = std::chrono::duration<double>(t1 - t0).count();
+    r.cursorSec = std::chrono::duration<double>(t2 - t1).count();
+    r.checksum  = checksum;
+    return r;
+}
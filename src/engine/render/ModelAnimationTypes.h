@@ -1,6 +1,7 @@
 // src/engine/render/ModelAnimationTypes.h
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -24,11 +25,42 @@ struct SkinData {
 
 enum class ChannelPath { Translation, Rotation, Scale };
 
+// Stored as uint8 in the .pacmdl cache; keep values stable.
+enum class Interpolation : unsigned char { Linear = 0, Step = 1, CubicSpline = 2 };
+
+// How a sampler's keyframe values are stored. Vec4 is glTF as loaded (vec3 tracks padded);
+// the cooker re-encodes linear/step tracks (see AnimCompress.h). Stored in the .pacmdl
+// cache; keep values stable.
+enum class SamplerFormat : unsigned char { Vec4 = 0, Vec3 = 1, Quat48 = 2 };
+
+// Unit quaternion in 48 bits, "smallest three": the largest component is dropped (and
+// rebuilt as positive), the other three are 15-bit fixed point in [-1/sqrt2, 1/sqrt2].
+struct Quat48 {
+    std::uint16_t v[3];
+};
+
 struct AnimationSampler {
     std::vector<float> inputs;
-    std::vector<glm::vec4> outputs;
-    std::string interpolation;
+    std::vector<glm::vec4> outputs;   // Vec4
+    std::vector<glm::vec3> outputs3;  // Vec3 (translation / scale)
+    std::vector<Quat48>    outputsQ;  // Quat48 (rotation)
+    // CUBICSPLINE only (parallel to outputs): glTF in/out tangents per keyframe. Cubic
+    // samplers always stay Vec4.
+    std::vector<glm::vec4> inTangents;
+    std::vector<glm::vec4> outTangents;
+    Interpolation interpolation = Interpolation::Linear;
+    SamplerFormat format = SamplerFormat::Vec4;
     bool isVec4 = false;
+
+    std::size_t valueCount() const
+    {
+        switch (format) {
+            case SamplerFormat::Vec3:   return outputs3.size();
+            case SamplerFormat::Quat48: return outputsQ.size();
+            case SamplerFormat::Vec4:
+            default:                    return outputs.size();
+        }
+    }
 };
 
 struct AnimationChannel {
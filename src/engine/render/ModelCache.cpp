@@ -1,59 +1,60 @@
 // src/engine/render/ModelCache.cpp
+//
+// .pacmdl cache, v13: fixed header + section table + 64-byte aligned sections of
+// fixed-size records. The reader maps the file and hands vertex/index/texture
+// payloads to GL straight from the mapping; node/skin/animation arrays are bulk
+// copied out of their sections (one memcpy per array, no per-element reads).
+// Textures carry their full mip chain (when sampled with mips), as BC1/BC3 blocks
+// unless disabled at write time; without S3TC support the reader decodes them to RGBA8.
+// Vertices are either the full float layout or the packed one (header.vertexLayout),
+// uploaded as stored. Indices are cook-time optimized and stored as the EBO itself: one
+// uint16 (relative to the submesh's baseVertex) or uint32 segment per submesh LOD.
+// Per-mesh and per-clip skinned AABBs are stored so loading never re-samples clips, and
+// so is the baked animation atlas when the model was baked (uploaded from the mapping).
+// Animation keys are stored in their sampler's format: compressed tracks as vec3 or
+// 48-bit quaternions, the rest as vec4.
 
 #include "Model.h"
 #include "ModelStartupLog.h"
+#include "TextureCompress.h"
+#include "../utils/MappedFile.h"
 
 #include <filesystem>
 #include <fstream>
 #include <sstream>
 #include <iomanip>
 #include <functional>
+#include <chrono>
 #include <cstdint>
 #include <cstddef>   // offsetof
 #include <vector>
 #include <string>
 #include <cstdlib>   // std::getenv
-#include <cstring>   // std::strcmp
+#include <cstring>   // std::strcmp, std::memcpy
+#include <type_traits>
+#include <algorithm>
 
-#include <glad/glad.h>
 #include <glm/gtc/type_ptr.hpp>
 
-// Model.cpp provides this helper (keep definition there).
-extern bool isMipmapMinFilter(GLint minF);
-
 // ✅ Fix: use the real animation types (they live in pac_model_types)
 using pac_model_types::AnimationClip;
 using pac_model_types::AnimationSampler;
 using pac_model_types::AnimationChannel;
 using pac_model_types::ChannelPath;
+using pac_model_types::Interpolation;
+using pac_model_types::SamplerFormat;
+using pac_model_types::Quat48;
+using pac_model_types::NodeTRS;
+using pac_model_types::SkinData;
+using pac_model_types::Vertex;
+using pac_model_types::PackedVertex;
+using pac_model_types::VertexLayout;
+using pac_model_types::IndexType;
 
 namespace pac_model_cache_detail {
 
 namespace fs = std::filesystem;
-
-template<typename T>
-static bool readPod(std::istream& in, T& v) {
-    return (bool)in.read(reinterpret_cast<char*>(&v), sizeof(T));
-}
-template<typename T>
-static bool writePod(std::ostream& out, const T& v) {
-    return (bool)out.write(reinterpret_cast<const char*>(&v), sizeof(T));
-}
-
-static bool readString(std::istream& in, std::string& s) {
-    uint32_t n = 0;
-    if (!readPod(in, n)) return false;
-    s.clear();
-    if (n == 0) return true;
-    s.resize(n);
-    return (bool)in.read(s.data(), n);
-}
-static bool writeString(std::ostream& out, const std::string& s) {
-    uint32_t n = (uint32_t)s.size();
-    if (!writePod(out, n)) return false;
-    if (n == 0) return true;
-    return (bool)out.write(s.data(), n);
-}
+using clock = std::chrono::steady_clock;
 
 static std::string hexHash64(uint64_t v) {
     std::ostringstream oss;
@@ -68,14 +69,49 @@ static bool envTruthy(const char* name) {
     return std::strcmp(v, "0") != 0;
 }
 
+static double msSince(clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(clock::now() - t0).count();
+}
+
 // Cache format constants
 static constexpr uint64_t kModelCacheMagic = 0x4C444D434150554FULL; // "PACMDML" in little-endian-ish
-static constexpr uint32_t kModelCacheVersion = 3;
+static constexpr uint32_t kModelCacheVersion = 13;
+static constexpr uint64_t kSectionAlign = 64;
+
+enum SectionId : uint32_t {
+    SecNodes = 0,        // CacheNode[nodeCount]
+    SecNodeParent,       // int32[nodeCount]
+    SecNodeMesh,         // int32[nodeCount]
+    SecNodeSkin,         // int32[nodeCount]
+    SecNodeOrder,        // int32[orderCount]
+    SecSkins,            // CacheSkin[skinCount]
+    SecSkinJoints,       // int32[]
+    SecSkinInverseBind,  // mat4[]
+    SecClips,            // CacheClip[animCount]
+    SecSamplers,         // CacheSampler[]
+    SecChannels,         // CacheChannel[]
+    SecAnimFloats,       // float[]     (sampler inputs)
+    SecAnimVec4,         // vec4[]      (Vec4 outputs + cubic tangents)
+    SecAnimVec3,         // vec3[]      (Vec3 outputs)
+    SecAnimQuat48,       // Quat48[]    (Quat48 outputs)
+    SecStrings,          // char[]      (clip names)
+    SecVertices,         // Vertex or PackedVertex [vertexCount], per header.vertexLayout
+    SecIndices,          // EBO bytes: per-LOD uint16/uint32 segments, 4-byte aligned
+    SecSubmeshes,        // CacheSubmesh[submeshCount]
+    SecSubmeshLods,      // CacheSubmeshLod[] (lodCount per submesh, LOD0 first)
+    SecMeshBounds,       // CacheAabb[] per mesh index, bind pose, mesh space
+    SecClipBounds,       // CacheAabb[1 + animCount]: rest pose, then each clip (model space)
+    SecBakedClips,       // CacheBakedClip[animCount], or empty if not baked
+    SecBakedFrames,      // mat4[frames * header.bakedFrameStride]
+    SecTextures,         // CacheTexture[2 * submeshCount] (base, emissive per submesh)
+    SecTexturePixels,    // RGBA8 or BC1/BC3 mip chains, each texture 16-byte aligned
+    SecCount
+};
 
-#pragma pack(push, 1)
 struct CacheHeader {
     uint64_t magic = kModelCacheMagic;
     uint32_t version = kModelCacheVersion;
+    uint32_t sectionCount = SecCount;
 
     int64_t  srcWriteTime = 0;
     uint64_t srcFileSize  = 0;
@@ -83,14 +119,121 @@ struct CacheHeader {
     float    modelScaleFactor = 1.0f;
 
     uint32_t vertexCount  = 0;
-    uint32_t indexCount   = 0;
+    uint32_t indexCount   = 0; // all submeshes, any index type
     uint32_t submeshCount = 0;
 
     uint32_t nodeCount    = 0;
+    uint32_t nodeOrderCount = 0;
     uint32_t skinCount    = 0;
     uint32_t animCount    = 0;
+
+    uint32_t vertexLayout = 0;          // VertexLayout
+    float    posOffset[3] = { 0, 0, 0 }; // packed position decode (VertexQuantization)
+    float    posScale[3]  = { 1, 1, 1 };
+
+    float    boundsCenter[3] = { 0, 0, 0 }; // bind-pose bounding sphere, model space
+    float    boundsRadius = 0.0f;
+
+    uint32_t bakedFrameStride = 0; // matrices per baked frame, 0 = not baked
+    uint32_t pad = 0;
+};
+
+struct SectionEntry {
+    uint64_t offset = 0; // from file start, kSectionAlign aligned
+    uint64_t size   = 0; // bytes
+};
+
+struct CacheNode {
+    float    t[3];
+    float    r[4]; // x, y, z, w
+    float    s[3];
+    uint32_t hasMatrix;
+    float    matrix[16];
+};
+
+struct CacheSkin {
+    uint32_t jointOffset;
+    uint32_t jointCount;
+};
+
+struct CacheClip {
+    uint32_t nameOffset;
+    uint32_t nameLength;
+    float    durationSec;
+    uint32_t samplerOffset;
+    uint32_t samplerCount;
+    uint32_t channelOffset;
+    uint32_t channelCount;
+};
+
+struct CacheSampler {
+    uint32_t interpolation; // pac_model_types::Interpolation
+    uint32_t isVec4;
+    uint32_t inputOffset;   // SecAnimFloats
+    uint32_t keyCount;      // inputs == outputs
+    uint32_t outputOffset;  // SecAnimVec4 / SecAnimVec3 / SecAnimQuat48, per format
+    uint32_t tangentOffset; // SecAnimVec4: keyCount in-tangents then keyCount out-tangents (cubic only)
+    uint32_t format;        // pac_model_types::SamplerFormat
+};
+
+struct CacheChannel {
+    int32_t  samplerIndex;
+    int32_t  targetNode;
+    uint32_t path; // 0=T 1=R 2=S
+};
+
+struct CacheSubmesh {
+    uint32_t lodOffset;       // first record in SecSubmeshLods
+    uint32_t lodCount;        // 1..kMaxMeshLods
+    int32_t  meshIndex;
+    float    emissiveFactor[3];
+    uint32_t alphaMode;
+    float    alphaCutoff;
+    uint32_t doubleSided;
+    uint32_t indexType;       // IndexType (element size in bytes)
+    int32_t  baseVertex;
+    uint32_t pad;
 };
-#pragma pack(pop)
+
+struct CacheSubmeshLod {
+    uint64_t indexCount;
+    uint64_t indexByteOffset; // within SecIndices
+    float    error;           // model units
+    uint32_t pad;
+};
+
+struct CacheAabb {
+    float min[3];
+    float max[3];
+};
+
+struct CacheBakedClip {
+    uint32_t firstFrame;
+    uint32_t frameCount; // intervals; frameCount + 1 frames are stored
+};
+
+struct CacheTexture {
+    uint32_t width;
+    uint32_t height;
+    int32_t  wrapS, wrapT, minF, magF;
+    uint32_t format;      // TextureFormat
+    uint32_t levels;      // mip levels stored, largest first
+    uint64_t pixelOffset; // within SecTexturePixels
+    uint64_t pixelBytes;  // whole chain; 0 => empty (1x1 placeholder)
+};
+
+static_assert(std::is_trivially_copyable_v<Vertex>, "Vertex must be memcpy-able");
+static_assert(sizeof(PackedVertex) == 20, "PackedVertex layout");
+static_assert(sizeof(CacheNode)    == 108, "CacheNode layout");
+static_assert(sizeof(CacheClip)    == 28,  "CacheClip layout");
+static_assert(sizeof(CacheSampler) == 28,  "CacheSampler layout");
+static_assert(sizeof(Quat48)       == 6,   "Quat48 layout");
+static_assert(sizeof(CacheChannel) == 12,  "CacheChannel layout");
+static_assert(sizeof(CacheSubmesh) == 48,  "CacheSubmesh layout");
+static_assert(sizeof(CacheSubmeshLod) == 24, "CacheSubmeshLod layout");
+static_assert(sizeof(CacheAabb)    == 24,  "CacheAabb layout");
+static_assert(sizeof(CacheBakedClip) == 8, "CacheBakedClip layout");
+static_assert(sizeof(CacheTexture) == 48,  "CacheTexture layout");
 
 static fs::path cachePathForModel(const std::string& filepath) {
     // Keep it local + simple: cache/models/<hash>.pacmdl
@@ -100,332 +243,732 @@ static fs::path cachePathForModel(const std::string& filepath) {
     return dir / (hexHash64(h) + ".pacmdl");
 }
 
-} // namespace pac_model_cache_detail
+static uint64_t alignUp(uint64_t v, uint64_t a) {
+    return (v + a - 1) & ~(a - 1);
+}
 
-// ------------------------------------------------------------
-// Cache I/O (read)
-// ------------------------------------------------------------
-bool Model::tryLoadCache(const std::string& filepath)
-{
-    using namespace pac_model_cache_detail;
+// ---- Read side: bounds-checked typed views over a byte range ----
 
-    // This keeps "test fastgltf" runs deterministic without forcing you to delete cache files.
-    if (envTruthy("PAC_DISABLE_MODELCACHE")) return false;
+class CacheView {
+public:
+    bool open(const uint8_t* data, size_t size) {
+        base = data;
+        bytes = size;
+        if (!base || bytes < sizeof(CacheHeader)) return false;
 
-    try {
-        const fs::path cpath = cachePathForModel(filepath);
-        if (!fs::exists(cpath)) return false;
+        hdr = reinterpret_cast<const CacheHeader*>(base);
+        if (hdr->magic != kModelCacheMagic) return false;
+        if (hdr->version != kModelCacheVersion) return false;
+        if (hdr->sectionCount != SecCount) return false;
 
-        // Validate source file metadata
-        if (!fs::exists(filepath)) return false;
+        const uint64_t tableEnd = sizeof(CacheHeader) + (uint64_t)SecCount * sizeof(SectionEntry);
+        if (tableEnd > bytes) return false;
+        table = reinterpret_cast<const SectionEntry*>(base + sizeof(CacheHeader));
 
-        CacheHeader hdr{};
-        {
-            std::ifstream in(cpath, std::ios::binary);
-            if (!in.is_open()) return false;
-            if (!readPod(in, hdr)) return false;
-            if (hdr.magic != kModelCacheMagic) return false;
-            if (hdr.version != kModelCacheVersion) return false;
-
-            const auto srcSz = (uint64_t)fs::file_size(filepath);
-            const auto srcWt = fs::last_write_time(filepath).time_since_epoch().count();
-
-            if (hdr.srcFileSize != srcSz) return false;
-            if (hdr.srcWriteTime != (int64_t)srcWt) return false;
-
-            // Apply cached state
-            modelScaleFactor = hdr.modelScaleFactor;
-
-            // Read animation/node/skin state first (so drawAnimated works)
-            nodesDefault.clear();
-            nodeChildren.clear();
-            nodeMesh.clear();
-            nodeSkin.clear();
-            sceneRoots.clear();
-            skins.clear();
-            animations.clear();
-            submeshes.clear();
-
-            // Nodes
-            nodesDefault.resize(hdr.nodeCount);
-            nodeChildren.resize(hdr.nodeCount);
-            nodeMesh.resize(hdr.nodeCount, -1);
-            nodeSkin.resize(hdr.nodeCount, -1);
-
-            for (uint32_t i = 0; i < hdr.nodeCount; ++i) {
-                NodeTRS n{};
-                if (!readPod(in, n.t)) return false;
-                if (!readPod(in, n.r)) return false;
-                if (!readPod(in, n.s)) return false;
-                uint8_t hm = 0;
-                if (!readPod(in, hm)) return false;
-                n.hasMatrix = (hm != 0);
-                if (!readPod(in, n.matrix)) return false;
-                nodesDefault[i] = n;
-            }
+        for (uint32_t i = 0; i < SecCount; ++i) {
+            const auto& e = table[i];
+            if (e.offset % kSectionAlign != 0) return false;
+            if (e.offset > bytes || e.size > bytes - e.offset) return false;
+        }
+        return true;
+    }
 
-            for (uint32_t i = 0; i < hdr.nodeCount; ++i) {
-                uint32_t cc = 0;
-                if (!readPod(in, cc)) return false;
-                nodeChildren[i].resize(cc);
-                for (uint32_t k = 0; k < cc; ++k) {
-                    int32_t vv = 0;
-                    if (!readPod(in, vv)) return false;
-                    nodeChildren[i][k] = (int)vv;
-                }
-            }
+    const CacheHeader& header() const { return *hdr; }
 
-            for (uint32_t i = 0; i < hdr.nodeCount; ++i) {
-                int32_t v = -1;
-                if (!readPod(in, v)) return false;
-                nodeMesh[i] = (int)v;
-            }
+    // Typed view of a whole section; count = size / sizeof(T).
+    template<typename T>
+    bool section(SectionId id, const T*& out, size_t& count) const {
+        const auto& e = table[id];
+        if (e.size % sizeof(T) != 0) return false;
+        out = reinterpret_cast<const T*>(base + e.offset);
+        count = (size_t)(e.size / sizeof(T));
+        return true;
+    }
 
-            for (uint32_t i = 0; i < hdr.nodeCount; ++i) {
-                int32_t v = -1;
-                if (!readPod(in, v)) return false;
-                nodeSkin[i] = (int)v;
-            }
+    const uint8_t* sectionBytes(SectionId id, size_t& size) const {
+        size = (size_t)table[id].size;
+        return base + table[id].offset;
+    }
 
-            // scene roots
-            {
-                uint32_t rc = 0;
-                if (!readPod(in, rc)) return false;
-                sceneRoots.resize(rc);
-                for (uint32_t i = 0; i < rc; ++i) {
-                    int32_t v = -1;
-                    if (!readPod(in, v)) return false;
-                    sceneRoots[i] = (int)v;
-                }
+private:
+    const uint8_t* base = nullptr;
+    size_t bytes = 0;
+    const CacheHeader* hdr = nullptr;
+    const SectionEntry* table = nullptr;
+};
+
+static TextureCache::Desc textureDesc(const CacheTexture& t) {
+    TextureCache::Desc d;
+    d.width  = t.width;  d.height = t.height;
+    d.wrapS  = t.wrapS;  d.wrapT  = t.wrapT;
+    d.minF   = t.minF;   d.magF   = t.magF;
+    d.format = (TextureFormat)t.format;
+    d.levels = t.levels;
+    return d;
+}
+
+// Everything needed to rebuild a Model, parsed from a CacheView. Geometry and
+// texture pixels stay as pointers into the source bytes (no copy).
+struct ParsedCache {
+    float modelScaleFactor = 1.0f;
+
+    std::vector<NodeTRS> nodes;
+    std::vector<int> nodeParent, nodeMesh, nodeSkin, nodeOrder;
+    std::vector<SkinData> skins;
+    std::vector<AnimationClip> animations;
+
+    const void*     vertices = nullptr; // Vertex or PackedVertex, per vertexLayout
+    size_t          vertexCount = 0;
+    VertexLayout    vertexLayout = VertexLayout::Full;
+    pac_model_types::VertexQuantization vertexQuant;
+    const uint8_t*  indexData = nullptr;
+    size_t          indexBytes = 0;
+
+    const CacheSubmesh* submeshes = nullptr;
+    size_t              submeshCount = 0;
+    const CacheSubmeshLod* lods = nullptr;
+    size_t                 lodTotal = 0;
+
+    std::vector<Aabb> meshBounds;
+    std::vector<Aabb> clipBounds; // [0] = rest pose
+
+    const CacheBakedClip* bakedClips = nullptr;
+    size_t                bakedClipCount = 0;
+    const glm::mat4*      bakedFrames = nullptr; // in place
+    size_t                bakedMatrixCount = 0;
+
+    struct TextureView {
+        const CacheTexture* info = nullptr;
+        const uint8_t*      pixels = nullptr; // nullptr => empty (1x1 placeholder)
+    };
+    std::vector<TextureView> textures; // 2 per submesh: base, emissive
+};
+
+template<typename T>
+static void assignInts(std::vector<int>& dst, const T* src, size_t n) {
+    dst.resize(n);
+    for (size_t i = 0; i < n; ++i) dst[i] = (int)src[i];
+}
+
+static bool parseCache(const CacheView& view, ParsedCache& out) {
+    const CacheHeader& hdr = view.header();
+    out.modelScaleFactor = hdr.modelScaleFactor;
+
+    // Nodes
+    const CacheNode* nodes = nullptr; size_t nodeCount = 0;
+    if (!view.section(SecNodes, nodes, nodeCount) || nodeCount != hdr.nodeCount) return false;
+    out.nodes.resize(nodeCount);
+    for (size_t i = 0; i < nodeCount; ++i) {
+        const CacheNode& cn = nodes[i];
+        NodeTRS& n = out.nodes[i];
+        n.t = glm::vec3(cn.t[0], cn.t[1], cn.t[2]);
+        n.r = glm::quat(cn.r[3], cn.r[0], cn.r[1], cn.r[2]);
+        n.s = glm::vec3(cn.s[0], cn.s[1], cn.s[2]);
+        n.hasMatrix = (cn.hasMatrix != 0);
+        std::memcpy(glm::value_ptr(n.matrix), cn.matrix, sizeof(cn.matrix));
+    }
+
+    const int32_t* parent = nullptr; size_t parentCount = 0;
+    const int32_t* mesh = nullptr;   size_t meshCount = 0;
+    const int32_t* skin = nullptr;   size_t skinCount = 0;
+    const int32_t* order = nullptr;  size_t orderCount = 0;
+    if (!view.section(SecNodeParent, parent, parentCount) || parentCount != nodeCount) return false;
+    if (!view.section(SecNodeMesh, mesh, meshCount) || meshCount != nodeCount) return false;
+    if (!view.section(SecNodeSkin, skin, skinCount) || skinCount != nodeCount) return false;
+    if (!view.section(SecNodeOrder, order, orderCount) || orderCount != hdr.nodeOrderCount) return false;
+    if (orderCount > nodeCount) return false;
+
+    assignInts(out.nodeParent, parent, nodeCount);
+    assignInts(out.nodeMesh, mesh, nodeCount);
+    assignInts(out.nodeSkin, skin, nodeCount);
+    assignInts(out.nodeOrder, order, orderCount);
+
+    // parent-before-child is what makes the linear global pass valid
+    {
+        for (int p : out.nodeParent) {
+            if (p < -1 || p >= (int)nodeCount) return false;
+        }
+        std::vector<uint8_t> seen(nodeCount, 0);
+        for (int v : out.nodeOrder) {
+            if (v < 0 || v >= (int)nodeCount) return false;
+            const int p = out.nodeParent[(size_t)v];
+            if (p >= 0 && !seen[(size_t)p]) return false;
+            seen[(size_t)v] = 1;
+        }
+    }
+
+    // Skins
+    const CacheSkin* skinRecs = nullptr; size_t skinRecCount = 0;
+    const int32_t* joints = nullptr;     size_t jointTotal = 0;
+    const glm::mat4* ibm = nullptr;      size_t ibmTotal = 0;
+    if (!view.section(SecSkins, skinRecs, skinRecCount) || skinRecCount != hdr.skinCount) return false;
+    if (!view.section(SecSkinJoints, joints, jointTotal)) return false;
+    if (!view.section(SecSkinInverseBind, ibm, ibmTotal) || ibmTotal != jointTotal) return false;
+
+    out.skins.resize(skinRecCount);
+    for (size_t si = 0; si < skinRecCount; ++si) {
+        const CacheSkin& r = skinRecs[si];
+        if ((uint64_t)r.jointOffset + r.jointCount > jointTotal) return false;
+        assignInts(out.skins[si].joints, joints + r.jointOffset, r.jointCount);
+        out.skins[si].inverseBind.assign(ibm + r.jointOffset, ibm + r.jointOffset + r.jointCount);
+    }
+
+    // Animations
+    const CacheClip* clips = nullptr;       size_t clipCount = 0;
+    const CacheSampler* samplers = nullptr; size_t samplerTotal = 0;
+    const CacheChannel* channels = nullptr; size_t channelTotal = 0;
+    const float* floats = nullptr;          size_t floatTotal = 0;
+    const glm::vec4* vec4s = nullptr;       size_t vec4Total = 0;
+    const glm::vec3* vec3s = nullptr;       size_t vec3Total = 0;
+    const Quat48* quats = nullptr;          size_t quatTotal = 0;
+    const char* strings = nullptr;          size_t stringBytes = 0;
+    if (!view.section(SecClips, clips, clipCount) || clipCount != hdr.animCount) return false;
+    if (!view.section(SecSamplers, samplers, samplerTotal)) return false;
+    if (!view.section(SecChannels, channels, channelTotal)) return false;
+    if (!view.section(SecAnimFloats, floats, floatTotal)) return false;
+    if (!view.section(SecAnimVec4, vec4s, vec4Total)) return false;
+    if (!view.section(SecAnimVec3, vec3s, vec3Total)) return false;
+    if (!view.section(SecAnimQuat48, quats, quatTotal)) return false;
+    if (!view.section(SecStrings, strings, stringBytes)) return false;
+
+    out.animations.resize(clipCount);
+    for (size_t ai = 0; ai < clipCount; ++ai) {
+        const CacheClip& c = clips[ai];
+        AnimationClip& clip = out.animations[ai];
+
+        if ((uint64_t)c.nameOffset + c.nameLength > stringBytes) return false;
+        if ((uint64_t)c.samplerOffset + c.samplerCount > samplerTotal) return false;
+        if ((uint64_t)c.channelOffset + c.channelCount > channelTotal) return false;
+
+        clip.name.assign(strings + c.nameOffset, c.nameLength);
+        clip.durationSec = c.durationSec;
+
+        clip.samplers.resize(c.samplerCount);
+        for (uint32_t s = 0; s < c.samplerCount; ++s) {
+            const CacheSampler& cs = samplers[c.samplerOffset + s];
+            AnimationSampler& samp = clip.samplers[s];
+
+            samp.interpolation = (cs.interpolation == 1u) ? Interpolation::Step :
+                                 (cs.interpolation == 2u) ? Interpolation::CubicSpline :
+                                                            Interpolation::Linear;
+            samp.isVec4 = (cs.isVec4 != 0);
+
+            const uint32_t n = cs.keyCount;
+            if ((uint64_t)cs.inputOffset + n > floatTotal) return false;
+            samp.inputs.assign(floats + cs.inputOffset, floats + cs.inputOffset + n);
+
+            if (cs.format == (uint32_t)SamplerFormat::Vec3) {
+                if ((uint64_t)cs.outputOffset + n > vec3Total) return false;
+                samp.format = SamplerFormat::Vec3;
+                samp.outputs3.assign(vec3s + cs.outputOffset, vec3s + cs.outputOffset + n);
+            } else if (cs.format == (uint32_t)SamplerFormat::Quat48) {
+                if ((uint64_t)cs.outputOffset + n > quatTotal) return false;
+                samp.format = SamplerFormat::Quat48;
+                samp.outputsQ.assign(quats + cs.outputOffset, quats + cs.outputOffset + n);
+            } else {
+                if ((uint64_t)cs.outputOffset + n > vec4Total) return false;
+                samp.outputs.assign(vec4s + cs.outputOffset, vec4s + cs.outputOffset + n);
             }
 
-            // Skins
-            skins.resize(hdr.skinCount);
-            for (uint32_t si = 0; si < hdr.skinCount; ++si) {
-                uint32_t jc = 0;
-                if (!readPod(in, jc)) return false;
-                skins[si].joints.resize(jc);
-                skins[si].inverseBind.resize(jc);
-
-                for (uint32_t j = 0; j < jc; ++j) {
-                    int32_t v = -1;
-                    if (!readPod(in, v)) return false;
-                    skins[si].joints[j] = (int)v;
-                }
-                for (uint32_t j = 0; j < jc; ++j) {
-                    if (!readPod(in, skins[si].inverseBind[j])) return false;
-                }
+            if (samp.interpolation == Interpolation::CubicSpline) {
+                if ((uint64_t)cs.tangentOffset + 2ull * n > vec4Total) return false;
+                const glm::vec4* tan = vec4s + cs.tangentOffset;
+                samp.inTangents.assign(tan, tan + n);
+                samp.outTangents.assign(tan + n, tan + 2 * n);
             }
+        }
 
-            // Animations
-            animations.resize(hdr.animCount);
-            for (uint32_t ai = 0; ai < hdr.animCount; ++ai) {
-                AnimationClip clip{};
-                if (!readString(in, clip.name)) return false;
-                if (!readPod(in, clip.durationSec)) return false;
-
-                uint32_t sc = 0;
-                if (!readPod(in, sc)) return false;
-                clip.samplers.resize(sc);
-                for (uint32_t s = 0; s < sc; ++s) {
-                    AnimationSampler samp{};
-                    if (!readString(in, samp.interpolation)) return false;
-                    uint8_t iv = 0;
-                    if (!readPod(in, iv)) return false;
-                    samp.isVec4 = (iv != 0);
-
-                    uint32_t ic = 0;
-                    if (!readPod(in, ic)) return false;
-                    samp.inputs.resize(ic);
-                    for (uint32_t k = 0; k < ic; ++k) {
-                        if (!readPod(in, samp.inputs[k])) return false;
-                    }
+        clip.channels.resize(c.channelCount);
+        for (uint32_t ci = 0; ci < c.channelCount; ++ci) {
+            const CacheChannel& cc = channels[c.channelOffset + ci];
+            AnimationChannel& ch = clip.channels[ci];
+            ch.samplerIndex = (int)cc.samplerIndex;
+            ch.targetNode   = (int)cc.targetNode;
+            ch.path = (cc.path == 1u) ? ChannelPath::Rotation :
+                      (cc.path == 2u) ? ChannelPath::Scale :
+                                        ChannelPath::Translation;
+        }
+    }
 
-                    uint32_t oc = 0;
-                    if (!readPod(in, oc)) return false;
-                    samp.outputs.resize(oc);
-                    for (uint32_t k = 0; k < oc; ++k) {
-                        if (!readPod(in, samp.outputs[k])) return false;
-                    }
+    // Geometry (in place)
+    if (hdr.vertexLayout == (uint32_t)VertexLayout::Packed) {
+        const PackedVertex* v = nullptr;
+        if (!view.section(SecVertices, v, out.vertexCount)) return false;
+        out.vertices = v;
+        out.vertexLayout = VertexLayout::Packed;
+        std::memcpy(out.vertexQuant.offset, hdr.posOffset, sizeof(hdr.posOffset));
+        std::memcpy(out.vertexQuant.scale, hdr.posScale, sizeof(hdr.posScale));
+    } else if (hdr.vertexLayout == (uint32_t)VertexLayout::Full) {
+        const Vertex* v = nullptr;
+        if (!view.section(SecVertices, v, out.vertexCount)) return false;
+        out.vertices = v;
+    } else {
+        return false;
+    }
+    if (out.vertexCount != hdr.vertexCount) return false;
+    out.indexData = view.sectionBytes(SecIndices, out.indexBytes);
+
+    // Submeshes + textures (in place)
+    if (!view.section(SecSubmeshes, out.submeshes, out.submeshCount) || out.submeshCount != hdr.submeshCount) return false;
+    if (!view.section(SecSubmeshLods, out.lods, out.lodTotal)) return false;
+
+    auto readBounds = [&](SectionId id, std::vector<Aabb>& dst) {
+        const CacheAabb* boxes = nullptr; size_t count = 0;
+        if (!view.section(id, boxes, count)) return false;
+        dst.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            dst[i].min = glm::vec3(boxes[i].min[0], boxes[i].min[1], boxes[i].min[2]);
+            dst[i].max = glm::vec3(boxes[i].max[0], boxes[i].max[1], boxes[i].max[2]);
+        }
+        return true;
+    };
+    if (!readBounds(SecMeshBounds, out.meshBounds)) return false;
+    if (!readBounds(SecClipBounds, out.clipBounds) || out.clipBounds.size() != (size_t)hdr.animCount + 1) return false;
+
+    // Baked atlas: every clip's frames must lie inside the frame section.
+    if (!view.section(SecBakedClips, out.bakedClips, out.bakedClipCount)) return false;
+    if (!view.section(SecBakedFrames, out.bakedFrames, out.bakedMatrixCount)) return false;
+    if (out.bakedClipCount != 0) {
+        if (out.bakedClipCount != hdr.animCount || hdr.bakedFrameStride == 0) return false;
+        if (out.bakedMatrixCount % hdr.bakedFrameStride != 0) return false;
+        const uint64_t frameTotal = out.bakedMatrixCount / hdr.bakedFrameStride;
+        for (size_t a = 0; a < out.bakedClipCount; ++a) {
+            const CacheBakedClip& c = out.bakedClips[a];
+            if ((uint64_t)c.firstFrame + c.frameCount + 1 > frameTotal) return false;
+        }
+    }
 
-                    clip.samplers[s] = std::move(samp);
-                }
+    const CacheTexture* texRecs = nullptr; size_t texCount = 0;
+    if (!view.section(SecTextures, texRecs, texCount) || texCount != 2 * out.submeshCount) return false;
+
+    size_t pixelBytes = 0;
+    const uint8_t* pixels = view.sectionBytes(SecTexturePixels, pixelBytes);
+
+    out.textures.resize(texCount);
+    for (size_t i = 0; i < texCount; ++i) {
+        const CacheTexture& t = texRecs[i];
+        if (t.pixelOffset > pixelBytes || t.pixelBytes > pixelBytes - t.pixelOffset) return false;
+        if (t.format > (uint32_t)TextureFormat::BC3) return false;
+        if (t.levels == 0 || t.levels > TextureCache::fullMipCount(t.width, t.height)) return false;
+        if (t.pixelBytes != 0 && t.pixelBytes != TextureCache::payloadBytes(textureDesc(t))) return false;
+        out.textures[i].info = &t;
+        out.textures[i].pixels = (t.pixelBytes > 0) ? pixels + t.pixelOffset : nullptr;
+    }
 
-                uint32_t cc = 0;
-                if (!readPod(in, cc)) return false;
-                clip.channels.resize(cc);
-                for (uint32_t c = 0; c < cc; ++c) {
-                    int32_t si2 = -1;
-                    int32_t tn  = -1;
-                    uint8_t path = 0;
-                    if (!readPod(in, si2)) return false;
-                    if (!readPod(in, tn)) return false;
-                    if (!readPod(in, path)) return false;
-
-                    AnimationChannel ch{};
-                    ch.samplerIndex = (int)si2;
-                    ch.targetNode   = (int)tn;
-                    ch.path = (path == 1u) ? ChannelPath::Rotation :
-                              (path == 2u) ? ChannelPath::Scale :
-                                             ChannelPath::Translation;
-                    clip.channels[c] = ch;
-                }
+    uint64_t totalIndices = 0;
+    for (size_t i = 0; i < out.submeshCount; ++i) {
+        const CacheSubmesh& sm = out.submeshes[i];
+        if (sm.indexType != (uint32_t)IndexType::U16 && sm.indexType != (uint32_t)IndexType::U32) return false;
+        if (sm.baseVertex < 0 || (uint64_t)sm.baseVertex > out.vertexCount) return false;
+        if (sm.lodCount == 0 || sm.lodCount > pac_model_types::kMaxMeshLods) return false;
+        if ((uint64_t)sm.lodOffset + sm.lodCount > out.lodTotal) return false;
+
+        for (uint32_t l = 0; l < sm.lodCount; ++l) {
+            const CacheSubmeshLod& lod = out.lods[sm.lodOffset + l];
+            if (lod.indexByteOffset % sm.indexType != 0) return false;
+            if (lod.indexByteOffset > out.indexBytes) return false;
+            if (lod.indexCount > (out.indexBytes - lod.indexByteOffset) / sm.indexType) return false;
+            totalIndices += lod.indexCount;
+        }
+    }
+    if (totalIndices != hdr.indexCount) return false;
 
-                animations[ai] = std::move(clip);
-            }
+    return true;
+}
+
+// ---- Write side: section builder ----
+
+class SectionBuilder {
+public:
+    template<typename T>
+    void append(SectionId id, const T* data, size_t count) {
+        static_assert(std::is_trivially_copyable_v<T>, "section payloads must be POD");
+        if (count == 0) return;
+        auto& buf = sections[id];
+        const size_t at = buf.size();
+        buf.resize(at + count * sizeof(T));
+        std::memcpy(buf.data() + at, data, count * sizeof(T));
+    }
+
+    template<typename T>
+    void append(SectionId id, const T& v) { append(id, &v, 1); }
+
+    size_t size(SectionId id) const { return sections[id].size(); }
 
-            // Geometry
-            std::vector<Vertex> vertices;
-            std::vector<uint32_t> indices;
+    void padTo(SectionId id, size_t align) {
+        auto& buf = sections[id];
+        buf.resize((size_t)alignUp(buf.size(), align), 0);
+    }
+
+    bool write(std::ostream& out, CacheHeader hdr) const {
+        SectionEntry table[SecCount];
+        uint64_t offset = alignUp(sizeof(CacheHeader) + sizeof(table), kSectionAlign);
+        for (uint32_t i = 0; i < SecCount; ++i) {
+            table[i].offset = offset;
+            table[i].size = sections[i].size();
+            offset = alignUp(offset + table[i].size, kSectionAlign);
+        }
 
-            vertices.resize(hdr.vertexCount);
-            indices.resize(hdr.indexCount);
+        hdr.sectionCount = SecCount;
+        if (!out.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr))) return false;
+        if (!out.write(reinterpret_cast<const char*>(table), sizeof(table))) return false;
 
-            if (hdr.vertexCount > 0) {
-                if (!in.read(reinterpret_cast<char*>(vertices.data()), vertices.size() * sizeof(Vertex))) return false;
+        uint64_t pos = sizeof(CacheHeader) + sizeof(table);
+        static const char zeros[kSectionAlign] = {};
+        for (uint32_t i = 0; i < SecCount; ++i) {
+            if (table[i].offset > pos) {
+                if (!out.write(zeros, (std::streamsize)(table[i].offset - pos))) return false;
+                pos = table[i].offset;
             }
-            if (hdr.indexCount > 0) {
-                if (!in.read(reinterpret_cast<char*>(indices.data()), indices.size() * sizeof(uint32_t))) return false;
+            if (!sections[i].empty()) {
+                if (!out.write(reinterpret_cast<const char*>(sections[i].data()), (std::streamsize)sections[i].size())) return false;
+                pos += sections[i].size();
             }
+        }
+        return true;
+    }
 
-            // Submeshes + textures (upload textures to GL here)
-            submeshes.resize(hdr.submeshCount);
-            std::vector<CPUTexture> baseColorCPU;
-            std::vector<CPUTexture> emissiveCPU;
-            baseColorCPU.resize(hdr.submeshCount);
-            emissiveCPU.resize(hdr.submeshCount);
-
-            for (uint32_t i = 0; i < hdr.submeshCount; ++i) {
-                uint64_t off = 0, cnt = 0;
-                int32_t meshIdx = -1;
-                if (!readPod(in, off)) return false;
-                if (!readPod(in, cnt)) return false;
-                if (!readPod(in, meshIdx)) return false;
-
-                float ef[3] = {0.0f, 0.0f, 0.0f};
-                uint8_t alphaMode = 0;
-                float alphaCutoff = 0.5f;
-                uint8_t doubleSided = 0;
-                if (!readPod(in, ef[0])) return false;
-                if (!readPod(in, ef[1])) return false;
-                if (!readPod(in, ef[2])) return false;
-                if (!readPod(in, alphaMode)) return false;
-                if (!readPod(in, alphaCutoff)) return false;
-                if (!readPod(in, doubleSided)) return false;
-
-                submeshes[i].indexOffset = (size_t)off;
-                submeshes[i].indexCount  = (size_t)cnt;
-                submeshes[i].meshIndex   = (int)meshIdx;
-                submeshes[i].emissiveFactor = glm::vec3(ef[0], ef[1], ef[2]);
-                submeshes[i].alphaMode      = (int)alphaMode;
-                submeshes[i].alphaCutoff    = alphaCutoff;
-                submeshes[i].doubleSided    = (doubleSided != 0);
-
-                auto readCPUTexture = [&](CPUTexture& t)->bool {
-                    if (!readPod(in, t.width)) return false;
-                    if (!readPod(in, t.height)) return false;
-                    if (!readPod(in, t.wrapS)) return false;
-                    if (!readPod(in, t.wrapT)) return false;
-                    if (!readPod(in, t.minF)) return false;
-                    if (!readPod(in, t.magF)) return false;
-                    uint32_t bytes = 0;
-                    if (!readPod(in, bytes)) return false;
-                    t.rgba.resize(bytes);
-                    if (bytes > 0) {
-                        if (!in.read(reinterpret_cast<char*>(t.rgba.data()), bytes)) return false;
-                    }
-                    return true;
-                };
+private:
+    std::vector<uint8_t> sections[SecCount];
+};
 
-                CPUTexture base{};
-                CPUTexture emissive{};
-                if (!readCPUTexture(base)) return false;
-                if (!readCPUTexture(emissive)) return false;
+} // namespace pac_model_cache_detail
 
-                baseColorCPU[i] = std::move(base);
-                emissiveCPU[i]  = std::move(emissive);
-            }
+// ------------------------------------------------------------
+// Cache I/O (read)
+// ------------------------------------------------------------
+// CPU only: validates and parses the mapped cache into this Model and leaves GL payload
+// views (into the mapping, which moves into out.mapping) for uploadStaged.
+bool Model::stageCache(const std::string& filepath, StagedLoad& out)
+{
+    using namespace pac_model_cache_detail;
 
-            // Upload VBO/EBO/VAO exactly like the slow path
-            glGenVertexArrays(1, &VAO);
-            glGenBuffers(1, &VBO);
-            glGenBuffers(1, &EBO);
+    // This keeps "test fastgltf" runs deterministic without forcing you to delete cache files.
+    if (envTruthy("PAC_DISABLE_MODELCACHE")) return false;
 
-            glBindVertexArray(VAO);
+    try {
+        const auto t0 = clock::now();
 
-            glBindBuffer(GL_ARRAY_BUFFER, VBO);
-            glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
+        const fs::path cpath = cachePathForModel(filepath);
+        if (!fs::exists(cpath)) return false;
 
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-            glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint32_t), indices.data(), GL_STATIC_DRAW);
+        // Validate source file metadata
+        if (!fs::exists(filepath)) return false;
 
-            // attributes: pos (0), uv (1), joints (2), weights (3)
-            glEnableVertexAttribArray(0);
-            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, px));
+        MappedFile file;
+        if (!file.open(cpath.string())) return false;
 
-            glEnableVertexAttribArray(1);
-            glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, u));
+        CacheView view;
+        if (!view.open(file.data(), file.size())) return false;
 
-            glEnableVertexAttribArray(2);
-            glVertexAttribIPointer(2, 4, GL_UNSIGNED_SHORT, sizeof(Vertex), (void*)offsetof(Vertex, j0));
+        const CacheHeader& hdr = view.header();
+        const auto srcSz = (uint64_t)fs::file_size(filepath);
+        const auto srcWt = fs::last_write_time(filepath).time_since_epoch().count();
+        if (hdr.srcFileSize != srcSz) return false;
+        if (hdr.srcWriteTime != (int64_t)srcWt) return false;
 
-            glEnableVertexAttribArray(3);
-            glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, w0));
+        ParsedCache parsed;
+        if (!parseCache(view, parsed)) return false;
 
-            glBindVertexArray(0);
+        // Apply cached state
+        modelScaleFactor = parsed.modelScaleFactor;
+        boundsCenter = glm::vec3(hdr.boundsCenter[0], hdr.boundsCenter[1], hdr.boundsCenter[2]);
+        boundsRadius = hdr.boundsRadius;
 
-            // Upload textures
-            auto uploadCPUTexture = [&](const CPUTexture& t)->GLuint {
-                const int w = (int)(t.width  == 0 ? 1u : t.width);
-                const int h = (int)(t.height == 0 ? 1u : t.height);
-                const void* pixels = t.rgba.empty() ? nullptr : t.rgba.data();
+        nodesDefault = std::move(parsed.nodes);
+        nodeParent   = std::move(parsed.nodeParent);
+        nodeMesh     = std::move(parsed.nodeMesh);
+        nodeSkin     = std::move(parsed.nodeSkin);
+        nodeOrder    = std::move(parsed.nodeOrder);
+        skins        = std::move(parsed.skins);
+        animations   = std::move(parsed.animations);
 
-                GLuint tex = 0;
-                glGenTextures(1, &tex);
-                glBindTexture(GL_TEXTURE_2D, tex);
+        buildMeshNodeOrder();
 
-                glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, (GLsizei)w, (GLsizei)h,
-                             0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+        meshBounds = std::move(parsed.meshBounds);
+        restBounds = parsed.clipBounds[0];
+        clipBounds.assign(parsed.clipBounds.begin() + 1, parsed.clipBounds.end());
 
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, (GLint)t.wrapS);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, (GLint)t.wrapT);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, (GLint)t.minF);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, (GLint)t.magF);
+        bakedClips.resize(parsed.bakedClipCount);
+        for (size_t a = 0; a < parsed.bakedClipCount; ++a) {
+            bakedClips[a].firstFrame = parsed.bakedClips[a].firstFrame;
+            bakedClips[a].frameCount = parsed.bakedClips[a].frameCount;
+        }
+        bakedFrameStride = parsed.bakedClipCount ? hdr.bakedFrameStride : 0;
+
+        submeshes.resize(parsed.submeshCount);
+        for (size_t i = 0; i < parsed.submeshCount; ++i) {
+            const CacheSubmesh& cs = parsed.submeshes[i];
+            Submesh& sm = submeshes[i];
+            sm.lodCount       = cs.lodCount;
+            for (uint32_t l = 0; l < cs.lodCount; ++l) {
+                const CacheSubmeshLod& cl = parsed.lods[cs.lodOffset + l];
+                sm.lods[l].indexCount      = (size_t)cl.indexCount;
+                sm.lods[l].indexByteOffset = (size_t)cl.indexByteOffset;
+                sm.lods[l].error           = cl.error;
+            }
+            sm.indexType      = (IndexType)cs.indexType;
+            sm.baseVertex     = cs.baseVertex;
+            sm.meshIndex      = (int)cs.meshIndex;
+            sm.emissiveFactor = glm::vec3(cs.emissiveFactor[0], cs.emissiveFactor[1], cs.emissiveFactor[2]);
+            sm.alphaMode      = (int)cs.alphaMode;
+            sm.alphaCutoff    = cs.alphaCutoff;
+            sm.doubleSided    = (cs.doubleSided != 0);
+        }
 
-                if (isMipmapMinFilter((GLint)t.minF)) {
-                    glGenerateMipmap(GL_TEXTURE_2D);
+        // GL payload stays in the mapping
+        out.vertices     = parsed.vertices;
+        out.vertexCount  = parsed.vertexCount;
+        out.vertexLayout = parsed.vertexLayout;
+        out.vertexQuant  = parsed.vertexQuant;
+        out.indexData    = parsed.indexData;
+        out.indexBytes   = parsed.indexBytes;
+        out.bakedFrames      = bakedFrameStride ? parsed.bakedFrames : nullptr;
+        out.bakedMatrixCount = bakedFrameStride ? parsed.bakedMatrixCount : 0;
+
+        // Block-compressed chains go to GL as-is; without S3TC they're decoded here, off
+        // the GL thread, into RGBA8 chains owned by the StagedLoad.
+        const bool keepBC = TextureCache::supportsBC();
+        out.textures.clear();
+        out.textures.reserve(parsed.textures.size());
+        for (const auto& t : parsed.textures) {
+            StagedLoad::Texture v;
+            v.width = t.info->width;  v.height = t.info->height;
+            v.wrapS = t.info->wrapS;  v.wrapT = t.info->wrapT;
+            v.minF  = t.info->minF;   v.magF  = t.info->magF;
+            v.format = (TextureFormat)t.info->format;
+            v.levels = t.info->levels;
+            v.pixels = t.pixels;
+
+            if (v.format != TextureFormat::RGBA8 && !keepBC) {
+                if (t.pixels) {
+                    out.decodedPixels.push_back(pac_texture::decodeChainBC(t.pixels, v.width, v.height, v.levels, v.format));
+                    v.pixels = out.decodedPixels.back().data();
                 }
-                return tex;
+                v.format = TextureFormat::RGBA8;
+            }
+            out.textures.push_back(v);
+        }
+
+        // Moving the mapping keeps the views valid (same address range).
+        out.mapping = std::move(file);
+
+        loadTiming.cacheReadMs = msSince(t0);
+
+        STARTUP_LOG(std::string("[Model] Cache hit: ") + filepath + " -> " + cpath.string());
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+// ------------------------------------------------------------
+// Cache read benchmark (pac_bench cache)
+// ------------------------------------------------------------
+Model::CacheReadBench Model::benchmarkCacheRead(const std::string& filepath, int warmIterations)
+{
+    using namespace pac_model_cache_detail;
+
+    CacheReadBench r{};
+    try {
+        const std::string cpath = cachePathForModel(filepath).string();
+        if (!fs::exists(cpath)) return r;
+
+        // Baseline: the pre-v6 stream reader, kept here as it was: one istream::read per
+        // field or element (readPod), every array copied into owned vectors, geometry and
+        // texture pixels included. Only the seeks are new: v13 arrays are found through the
+        // section table instead of following one another.
+        auto legacyRead = [&]() -> bool {
+            std::ifstream in(cpath, std::ios::binary);
+            if (!in.is_open()) return false;
+
+            auto readPod = [&](auto& v) { return (bool)in.read(reinterpret_cast<char*>(&v), sizeof(v)); };
+
+            CacheHeader hdr{};
+            if (!readPod(hdr)) return false;
+            if (hdr.magic != kModelCacheMagic || hdr.version != kModelCacheVersion) return false;
+            SectionEntry table[SecCount];
+            for (auto& e : table) {
+                if (!readPod(e)) return false;
+            }
+
+            // Element by element, like the old per-record loops.
+            auto readArray = [&](SectionId id, auto& dst) -> bool {
+                using T = typename std::decay_t<decltype(dst)>::value_type;
+                dst.resize((size_t)(table[id].size / sizeof(T)));
+                if (!in.seekg((std::streamoff)table[id].offset)) return false;
+                for (auto& v : dst) {
+                    if (!readPod(v)) return false;
+                }
+                return true;
+            };
+            // Bulk, like the old vertex/index/pixel reads.
+            auto readBytes = [&](uint64_t offset, uint64_t size, std::vector<uint8_t>& dst) -> bool {
+                dst.resize((size_t)size);
+                if (size == 0) return true;
+                return in.seekg((std::streamoff)offset) && in.read(reinterpret_cast<char*>(dst.data()), (std::streamsize)size);
             };
 
-            for (size_t i = 0; i < submeshes.size(); ++i) {
-                submeshes[i].baseColorTexID = uploadCPUTexture(baseColorCPU[i]);
-                submeshes[i].emissiveTexID  = uploadCPUTexture(emissiveCPU[i]);
+            std::vector<NodeTRS> nodes(hdr.nodeCount);
+            if (!in.seekg((std::streamoff)table[SecNodes].offset)) return false;
+            for (NodeTRS& n : nodes) {
+                CacheNode cn{};
+                if (!readPod(cn.t) || !readPod(cn.r) || !readPod(cn.s)) return false;
+                if (!readPod(cn.hasMatrix) || !readPod(cn.matrix)) return false;
+                n.t = glm::vec3(cn.t[0], cn.t[1], cn.t[2]);
+                n.r = glm::quat(cn.r[3], cn.r[0], cn.r[1], cn.r[2]);
+                n.s = glm::vec3(cn.s[0], cn.s[1], cn.s[2]);
+                n.hasMatrix = (cn.hasMatrix != 0);
+                std::memcpy(glm::value_ptr(n.matrix), cn.matrix, sizeof(cn.matrix));
+            }
+
+            std::vector<int32_t> parent, mesh, skin, order, joints;
+            std::vector<glm::mat4> ibm;
+            std::vector<CacheSkin> skinRecs;
+            if (!readArray(SecNodeParent, parent) || !readArray(SecNodeMesh, mesh) ||
+                !readArray(SecNodeSkin, skin) || !readArray(SecNodeOrder, order)) return false;
+            if (!readArray(SecSkins, skinRecs) || !readArray(SecSkinJoints, joints) ||
+                !readArray(SecSkinInverseBind, ibm)) return false;
+
+            std::vector<SkinData> skins(skinRecs.size());
+            for (size_t si = 0; si < skinRecs.size(); ++si) {
+                const CacheSkin& r = skinRecs[si];
+                if ((uint64_t)r.jointOffset + r.jointCount > joints.size() || joints.size() != ibm.size()) return false;
+                assignInts(skins[si].joints, joints.data() + r.jointOffset, r.jointCount);
+                skins[si].inverseBind.assign(ibm.begin() + r.jointOffset, ibm.begin() + r.jointOffset + r.jointCount);
             }
 
-            glBindTexture(GL_TEXTURE_2D, 0);
+            std::vector<CacheClip> clips;
+            std::vector<CacheSampler> samplers;
+            std::vector<CacheChannel> channels;
+            std::vector<float> floats;
+            std::vector<glm::vec4> vec4s;
+            std::vector<glm::vec3> vec3s;
+            std::vector<Quat48> quats;
+            std::vector<char> strings;
+            if (!readArray(SecClips, clips) || !readArray(SecSamplers, samplers) || !readArray(SecChannels, channels) ||
+                !readArray(SecAnimFloats, floats) || !readArray(SecAnimVec4, vec4s) || !readArray(SecAnimVec3, vec3s) ||
+                !readArray(SecAnimQuat48, quats) || !readArray(SecStrings, strings)) return false;
+
+            std::vector<AnimationClip> animations(clips.size());
+            for (size_t ai = 0; ai < clips.size(); ++ai) {
+                const CacheClip& c = clips[ai];
+                if ((uint64_t)c.nameOffset + c.nameLength > strings.size()) return false;
+                if ((uint64_t)c.samplerOffset + c.samplerCount > samplers.size()) return false;
+                AnimationClip& clip = animations[ai];
+                clip.name.assign(strings.data() + c.nameOffset, c.nameLength);
+                clip.durationSec = c.durationSec;
+                clip.samplers.resize(c.samplerCount);
+                for (uint32_t si = 0; si < c.samplerCount; ++si) {
+                    const CacheSampler& cs = samplers[c.samplerOffset + si];
+                    AnimationSampler& samp = clip.samplers[si];
+                    const uint32_t n = cs.keyCount;
+                    if ((uint64_t)cs.inputOffset + n > floats.size()) return false;
+                    samp.inputs.assign(floats.begin() + cs.inputOffset, floats.begin() + cs.inputOffset + n);
+                    if (cs.format == (uint32_t)SamplerFormat::Vec3) {
+                        if ((uint64_t)cs.outputOffset + n > vec3s.size()) return false;
+                        samp.outputs3.assign(vec3s.begin() + cs.outputOffset, vec3s.begin() + cs.outputOffset + n);
+                    } else if (cs.format == (uint32_t)SamplerFormat::Quat48) {
+                        if ((uint64_t)cs.outputOffset + n > quats.size()) return false;
+                        samp.outputsQ.assign(quats.begin() + cs.outputOffset, quats.begin() + cs.outputOffset + n);
+                    } else {
+                        if ((uint64_t)cs.outputOffset + n > vec4s.size()) return false;
+                        samp.outputs.assign(vec4s.begin() + cs.outputOffset, vec4s.begin() + cs.outputOffset + n);
+                    }
+                    if (cs.interpolation == 2u) {
+                        if ((uint64_t)cs.tangentOffset + 2ull * n > vec4s.size()) return false;
+                        const auto tan = vec4s.begin() + cs.tangentOffset;
+                        samp.inTangents.assign(tan, tan + n);
+                        samp.outTangents.assign(tan + n, tan + 2 * n);
+                    }
+                }
+
+                if ((uint64_t)c.channelOffset + c.channelCount > channels.size()) return false;
+                clip.channels.resize(c.channelCount);
+                for (uint32_t ci = 0; ci < c.channelCount; ++ci) {
+                    const CacheChannel& cc = channels[c.channelOffset + ci];
+                    clip.channels[ci].samplerIndex = (int)cc.samplerIndex;
+                    clip.channels[ci].targetNode   = (int)cc.targetNode;
+                }
+            }
 
-            STARTUP_LOG(std::string("[Model] Cache hit: ") + filepath + " -> " + cpath.string());
-            return true;
+            std::vector<uint8_t> vertices, indices;
+            if (!readBytes(table[SecVertices].offset, table[SecVertices].size, vertices)) return false;
+            if (!readBytes(table[SecIndices].offset, table[SecIndices].size, indices)) return false;
+
+            std::vector<CacheSubmesh> subs;
+            std::vector<CacheTexture> texRecs;
+            if (!readArray(SecSubmeshes, subs) || !readArray(SecTextures, texRecs)) return false;
+            std::vector<std::vector<uint8_t>> pixels(texRecs.size());
+            for (size_t i = 0; i < texRecs.size(); ++i) {
+                const CacheTexture& t = texRecs[i];
+                if (t.pixelOffset + t.pixelBytes > table[SecTexturePixels].size) return false;
+                if (!readBytes(table[SecTexturePixels].offset + t.pixelOffset, t.pixelBytes, pixels[i])) return false;
+            }
+            return vertices.size() == table[SecVertices].size;
+        };
+
+        // Mapped reader: what stageCache does.
+        auto mappedRead = [&]() -> bool {
+            MappedFile file;
+            if (!file.open(cpath)) return false;
+            CacheView view;
+            ParsedCache parsed;
+            return view.open(file.data(), file.size()) && parseCache(view, parsed);
+        };
+
+        auto timeOnce = [](auto&& fn, double& ms) -> bool {
+            const auto t0 = clock::now();
+            const bool ok = fn();
+            ms = msSince(t0);
+            return ok;
+        };
+
+        // Cold: the file's pages are dropped from the OS cache before each reader's first
+        // pass. Where that isn't possible the cold numbers are left at 0 (coldMeasured false).
+        r.coldMeasured = MappedFile::evictFromPageCache(cpath);
+        if (r.coldMeasured) {
+            if (!timeOnce(mappedRead, r.mmapColdMs)) return r;
+            r.coldMeasured = MappedFile::evictFromPageCache(cpath);
+            if (r.coldMeasured && !timeOnce(legacyRead, r.legacyColdMs)) return r;
         }
+
+        const int n = (std::max)(1, warmIterations);
+        double ms = 0.0;
+        if (!timeOnce(legacyRead, ms) || !timeOnce(mappedRead, ms)) return r; // warm-up
+        for (int i = 0; i < n; ++i) { timeOnce(legacyRead, ms); r.legacyWarmMs += ms; }
+        for (int i = 0; i < n; ++i) { timeOnce(mappedRead, ms); r.mmapWarmMs += ms; }
+        r.legacyWarmMs /= n;
+        r.mmapWarmMs /= n;
+
+        r.fileBytes = (uint64_t)fs::file_size(cpath);
+        r.ok = true;
     } catch (...) {
-        return false;
+        r.ok = false;
     }
+    return r;
 }
 
 // ------------------------------------------------------------
 // Cache I/O (write)
 // ------------------------------------------------------------
-void Model::writeCache(const std::string& filepath,
-                       const std::vector<Vertex>& vertices,
-                       const std::vector<uint32_t>& indices,
-                       const std::vector<CPUTexture>& baseColorTexturesCPU,
-                       const std::vector<CPUTexture>& emissiveTexturesCPU) const
+bool Model::writeCache(const std::string& filepath, const CPUGeometry& geo, bool compressTextures,
+                       CacheTextureStats* texStats) const
 {
     using namespace pac_model_cache_detail;
 
+    const auto& vertices = geo.vertices;
+    const auto& baseColorTexturesCPU = geo.baseColorTextures;
+    const auto& emissiveTexturesCPU = geo.emissiveTextures;
+
     try {
-        if (!fs::exists(filepath)) return;
+        if (!fs::exists(filepath)) return false;
+
+        // Basic sanity: require matching texture entries
+        if (baseColorTexturesCPU.size() != submeshes.size()) return false;
+        if (emissiveTexturesCPU.size() != submeshes.size()) return false;
+        // Written as uploaded: buildIndexBuffer must have run.
+        if (geo.indexBuffer.empty() && !geo.indices.empty()) return false;
 
         fs::path cpath = cachePathForModel(filepath);
         fs::create_directories(cpath.parent_path());
@@ -435,161 +978,300 @@ void Model::writeCache(const std::string& filepath,
         hdr.srcWriteTime = (int64_t)fs::last_write_time(filepath).time_since_epoch().count();
 
         hdr.modelScaleFactor = modelScaleFactor;
+        hdr.boundsCenter[0] = boundsCenter.x;
+        hdr.boundsCenter[1] = boundsCenter.y;
+        hdr.boundsCenter[2] = boundsCenter.z;
+        hdr.boundsRadius = boundsRadius;
 
         hdr.vertexCount  = (uint32_t)vertices.size();
-        hdr.indexCount   = (uint32_t)indices.size();
+        for (const auto& sm : submeshes) {
+            for (uint32_t l = 0; l < sm.lodCount; ++l) hdr.indexCount += (uint32_t)sm.lods[l].indexCount;
+        }
         hdr.submeshCount = (uint32_t)submeshes.size();
 
-        hdr.nodeCount = (uint32_t)nodesDefault.size();
-        hdr.skinCount = (uint32_t)skins.size();
-        hdr.animCount = (uint32_t)animations.size();
-
-        // Basic sanity: require matching texture entries
-        if (baseColorTexturesCPU.size() != submeshes.size()) return;
-        if (emissiveTexturesCPU.size() != submeshes.size()) return;
+        hdr.nodeCount      = (uint32_t)nodesDefault.size();
+        hdr.nodeOrderCount = (uint32_t)nodeOrder.size();
+        hdr.skinCount      = (uint32_t)skins.size();
+        hdr.animCount      = (uint32_t)animations.size();
 
-        std::ofstream out(cpath, std::ios::binary | std::ios::trunc);
-        if (!out.is_open()) return;
-
-        if (!writePod(out, hdr)) return;
+        SectionBuilder sb;
 
         // Nodes
         for (const auto& n : nodesDefault) {
-            if (!writePod(out, n.t)) return;
-            if (!writePod(out, n.r)) return;
-            if (!writePod(out, n.s)) return;
-            uint8_t hm = n.hasMatrix ? 1u : 0u;
-            if (!writePod(out, hm)) return;
-            if (!writePod(out, n.matrix)) return;
-        }
-
-        for (const auto& ch : nodeChildren) {
-            uint32_t cc = (uint32_t)ch.size();
-            if (!writePod(out, cc)) return;
-            for (int v : ch) {
-                int32_t vv = (int32_t)v;
-                if (!writePod(out, vv)) return;
-            }
-        }
-
-        for (int v : nodeMesh) {
-            int32_t vv = (int32_t)v;
-            if (!writePod(out, vv)) return;
-        }
-        for (int v : nodeSkin) {
-            int32_t vv = (int32_t)v;
-            if (!writePod(out, vv)) return;
+            CacheNode cn{};
+            cn.t[0] = n.t.x; cn.t[1] = n.t.y; cn.t[2] = n.t.z;
+            cn.r[0] = n.r.x; cn.r[1] = n.r.y; cn.r[2] = n.r.z; cn.r[3] = n.r.w;
+            cn.s[0] = n.s.x; cn.s[1] = n.s.y; cn.s[2] = n.s.z;
+            cn.hasMatrix = n.hasMatrix ? 1u : 0u;
+            std::memcpy(cn.matrix, glm::value_ptr(n.matrix), sizeof(cn.matrix));
+            sb.append(SecNodes, cn);
         }
 
-        // scene roots
-        {
-            uint32_t rc = (uint32_t)sceneRoots.size();
-            if (!writePod(out, rc)) return;
-            for (int v : sceneRoots) {
-                int32_t vv = (int32_t)v;
-                if (!writePod(out, vv)) return;
-            }
-        }
+        auto appendInts = [&](SectionId id, const std::vector<int>& v) {
+            for (int x : v) sb.append(id, (int32_t)x);
+        };
+        appendInts(SecNodeParent, nodeParent);
+        appendInts(SecNodeMesh, nodeMesh);
+        appendInts(SecNodeSkin, nodeSkin);
+        appendInts(SecNodeOrder, nodeOrder);
 
         // Skins
+        uint32_t jointCursor = 0;
         for (const auto& s : skins) {
-            uint32_t jc = (uint32_t)s.joints.size();
-            if (!writePod(out, jc)) return;
-            for (int v : s.joints) {
-                int32_t vv = (int32_t)v;
-                if (!writePod(out, vv)) return;
-            }
-            for (const auto& m : s.inverseBind) {
-                if (!writePod(out, m)) return;
-            }
+            if (s.inverseBind.size() != s.joints.size()) return false;
+            CacheSkin cs{ jointCursor, (uint32_t)s.joints.size() };
+            sb.append(SecSkins, cs);
+            appendInts(SecSkinJoints, s.joints);
+            sb.append(SecSkinInverseBind, s.inverseBind.data(), s.inverseBind.size());
+            jointCursor += cs.jointCount;
         }
 
         // Animations
+        uint32_t samplerCursor = 0, channelCursor = 0;
         for (const auto& a : animations) {
-            if (!writeString(out, a.name)) return;
-            if (!writePod(out, a.durationSec)) return;
+            CacheClip cc{};
+            cc.nameOffset    = (uint32_t)sb.size(SecStrings);
+            cc.nameLength    = (uint32_t)a.name.size();
+            cc.durationSec   = a.durationSec;
+            cc.samplerOffset = samplerCursor;
+            cc.samplerCount  = (uint32_t)a.samplers.size();
+            cc.channelOffset = channelCursor;
+            cc.channelCount  = (uint32_t)a.channels.size();
+            sb.append(SecClips, cc);
+            sb.append(SecStrings, a.name.data(), a.name.size());
 
-            uint32_t sc = (uint32_t)a.samplers.size();
-            if (!writePod(out, sc)) return;
             for (const auto& s : a.samplers) {
-                if (!writeString(out, s.interpolation)) return;
-                uint8_t iv = s.isVec4 ? 1u : 0u;
-                if (!writePod(out, iv)) return;
-
-                uint32_t ic = (uint32_t)s.inputs.size();
-                if (!writePod(out, ic)) return;
-                for (float v : s.inputs) {
-                    if (!writePod(out, v)) return;
+                if (s.valueCount() != s.inputs.size()) return false;
+
+                CacheSampler cs{};
+                cs.interpolation = (uint32_t)s.interpolation;
+                cs.isVec4        = s.isVec4 ? 1u : 0u;
+                cs.format        = (uint32_t)s.format;
+                cs.keyCount      = (uint32_t)s.inputs.size();
+                cs.inputOffset   = (uint32_t)(sb.size(SecAnimFloats) / sizeof(float));
+                sb.append(SecAnimFloats, s.inputs.data(), s.inputs.size());
+                switch (s.format) {
+                    case SamplerFormat::Vec3:
+                        cs.outputOffset = (uint32_t)(sb.size(SecAnimVec3) / sizeof(glm::vec3));
+                        sb.append(SecAnimVec3, s.outputs3.data(), s.outputs3.size());
+                        break;
+                    case SamplerFormat::Quat48:
+                        cs.outputOffset = (uint32_t)(sb.size(SecAnimQuat48) / sizeof(Quat48));
+                        sb.append(SecAnimQuat48, s.outputsQ.data(), s.outputsQ.size());
+                        break;
+                    case SamplerFormat::Vec4:
+                    default:
+                        cs.outputOffset = (uint32_t)(sb.size(SecAnimVec4) / sizeof(glm::vec4));
+                        sb.append(SecAnimVec4, s.outputs.data(), s.outputs.size());
+                        break;
                 }
 
-                uint32_t oc = (uint32_t)s.outputs.size();
-                if (!writePod(out, oc)) return;
-                for (const auto& v : s.outputs) {
-                    if (!writePod(out, v)) return;
+                if (s.interpolation == Interpolation::CubicSpline) {
+                    if (s.inTangents.size() != s.outputs.size()) return false;
+                    if (s.outTangents.size() != s.outputs.size()) return false;
+                    cs.tangentOffset = (uint32_t)(sb.size(SecAnimVec4) / sizeof(glm::vec4));
+                    sb.append(SecAnimVec4, s.inTangents.data(), s.inTangents.size());
+                    sb.append(SecAnimVec4, s.outTangents.data(), s.outTangents.size());
                 }
+                sb.append(SecSamplers, cs);
             }
+            samplerCursor += cc.samplerCount;
 
-            uint32_t cc = (uint32_t)a.channels.size();
-            if (!writePod(out, cc)) return;
             for (const auto& ch : a.channels) {
-                int32_t si = (int32_t)ch.samplerIndex;
-                int32_t tn = (int32_t)ch.targetNode;
-                uint8_t path = (ch.path == ChannelPath::Rotation) ? 1u : (ch.path == ChannelPath::Scale) ? 2u : 0u;
-                if (!writePod(out, si)) return;
-                if (!writePod(out, tn)) return;
-                if (!writePod(out, path)) return;
+                CacheChannel c{};
+                c.samplerIndex = (int32_t)ch.samplerIndex;
+                c.targetNode   = (int32_t)ch.targetNode;
+                c.path = (ch.path == ChannelPath::Rotation) ? 1u : (ch.path == ChannelPath::Scale) ? 2u : 0u;
+                sb.append(SecChannels, c);
             }
+            channelCursor += cc.channelCount;
         }
 
         // Geometry
-        if (!vertices.empty()) {
-            if (!out.write(reinterpret_cast<const char*>(vertices.data()), vertices.size() * sizeof(Vertex))) return;
+        if (geo.layout == VertexLayout::Packed && geo.packedVertices.size() == vertices.size()) {
+            hdr.vertexLayout = (uint32_t)VertexLayout::Packed;
+            std::memcpy(hdr.posOffset, geo.quant.offset, sizeof(hdr.posOffset));
+            std::memcpy(hdr.posScale, geo.quant.scale, sizeof(hdr.posScale));
+            sb.append(SecVertices, geo.packedVertices.data(), geo.packedVertices.size());
+        } else {
+            sb.append(SecVertices, vertices.data(), vertices.size());
         }
-        if (!indices.empty()) {
-            if (!out.write(reinterpret_cast<const char*>(indices.data()), indices.size() * sizeof(uint32_t))) return;
+        sb.append(SecIndices, geo.indexBuffer.data(), geo.indexBuffer.size());
+
+        auto appendBounds = [&](SectionId id, const Aabb& b) {
+            CacheAabb cb{};
+            std::memcpy(cb.min, &b.min.x, sizeof(cb.min));
+            std::memcpy(cb.max, &b.max.x, sizeof(cb.max));
+            sb.append(id, cb);
+        };
+        for (const auto& b : meshBounds) appendBounds(SecMeshBounds, b);
+        appendBounds(SecClipBounds, restBounds);
+        if (clipBounds.size() != animations.size()) return false;
+        for (const auto& b : clipBounds) appendBounds(SecClipBounds, b);
+
+        if (bakedFrameStride > 0 && !geo.bakedFrames.empty()) {
+            hdr.bakedFrameStride = bakedFrameStride;
+            for (const auto& c : bakedClips) sb.append(SecBakedClips, CacheBakedClip{ c.firstFrame, c.frameCount });
+            sb.append(SecBakedFrames, geo.bakedFrames.data(), geo.bakedFrames.size());
         }
 
         // Submeshes + textures + minimal material params
+        const bool compress = compressTextures && !envTruthy("PAC_DISABLE_TEXTURE_BC");
+        CacheTextureStats stats;
+
+        auto appendTexture = [&](const CPUTexture& t) {
+            CacheTexture ct{};
+            ct.width  = t.width;
+            ct.height = t.height;
+            ct.wrapS = t.wrapS; ct.wrapT = t.wrapT;
+            ct.minF  = t.minF;  ct.magF  = t.magF;
+            ct.format = (uint32_t)TextureFormat::RGBA8;
+            ct.levels = 1;
+            sb.padTo(SecTexturePixels, 16);
+            ct.pixelOffset = sb.size(SecTexturePixels);
+
+            const bool hasPixels = !t.rgba.empty() && t.rgba.size() == (size_t)t.width * t.height * 4u;
+            if (hasPixels) {
+                // Mips are built here once instead of by glGenerateMipmap on every load.
+                if (TextureCache::isMipmapFilter(t.minF)) ct.levels = TextureCache::fullMipCount(t.width, t.height);
+                std::vector<uint8_t> chain = pac_texture::buildMipChainRGBA8(t.rgba.data(), t.width, t.height, ct.levels);
+                stats.rgbaBytes += chain.size();
+
+                // BC needs whole 4x4 blocks at level 0; odd-sized images stay RGBA8.
+                if (compress && t.width % 4 == 0 && t.height % 4 == 0) {
+                    const TextureFormat fmt = pac_texture::chooseBlockFormat(t.rgba.data(), t.width, t.height);
+                    chain = pac_texture::encodeChainBC(chain.data(), t.width, t.height, ct.levels, fmt);
+                    ct.format = (uint32_t)fmt;
+                    ++stats.compressed;
+                }
+
+                ct.pixelBytes = chain.size();
+                stats.storedBytes += chain.size();
+                sb.append(SecTexturePixels, chain.data(), chain.size());
+            }
+            sb.append(SecTextures, ct);
+        };
+
         for (size_t i = 0; i < submeshes.size(); ++i) {
             const auto& sm = submeshes[i];
-            uint64_t off = (uint64_t)sm.indexOffset;
-            uint64_t cnt = (uint64_t)sm.indexCount;
-            int32_t meshIdx = (int32_t)sm.meshIndex;
-            if (!writePod(out, off)) return;
-            if (!writePod(out, cnt)) return;
-            if (!writePod(out, meshIdx)) return;
-
-            // material params
-            if (!writePod(out, sm.emissiveFactor.x)) return;
-            if (!writePod(out, sm.emissiveFactor.y)) return;
-            if (!writePod(out, sm.emissiveFactor.z)) return;
-            uint8_t alphaMode = (uint8_t)sm.alphaMode;
-            uint8_t doubleSided = sm.doubleSided ? 1u : 0u;
-            if (!writePod(out, alphaMode)) return;
-            if (!writePod(out, sm.alphaCutoff)) return;
-            if (!writePod(out, doubleSided)) return;
-
-            auto writeCPUTexture = [&](const CPUTexture& t)->bool {
-                if (!writePod(out, t.width)) return false;
-                if (!writePod(out, t.height)) return false;
-                if (!writePod(out, t.wrapS)) return false;
-                if (!writePod(out, t.wrapT)) return false;
-                if (!writePod(out, t.minF)) return false;
-                if (!writePod(out, t.magF)) return false;
-                uint32_t bytes = (uint32_t)t.rgba.size();
-                if (!writePod(out, bytes)) return false;
-                if (bytes > 0) {
-                    if (!out.write(reinterpret_cast<const char*>(t.rgba.data()), bytes)) return false;
-                }
-                return true;
-            };
+            CacheSubmesh cs{};
+            cs.lodOffset   = (uint32_t)(sb.size(SecSubmeshLods) / sizeof(CacheSubmeshLod));
+            cs.lodCount    = sm.lodCount;
+            for (uint32_t l = 0; l < sm.lodCount; ++l) {
+                CacheSubmeshLod cl{};
+                cl.indexCount      = (uint64_t)sm.lods[l].indexCount;
+                cl.indexByteOffset = (uint64_t)sm.lods[l].indexByteOffset;
+                cl.error           = sm.lods[l].error;
+                sb.append(SecSubmeshLods, cl);
+            }
+            cs.indexType   = (uint32_t)sm.indexType;
+            cs.baseVertex  = (int32_t)sm.baseVertex;
+            cs.meshIndex   = (int32_t)sm.meshIndex;
+            cs.emissiveFactor[0] = sm.emissiveFactor.x;
+            cs.emissiveFactor[1] = sm.emissiveFactor.y;
+            cs.emissiveFactor[2] = sm.emissiveFactor.z;
+            cs.alphaMode   = (uint32_t)sm.alphaMode;
+            cs.alphaCutoff = sm.alphaCutoff;
+            cs.doubleSided = sm.doubleSided ? 1u : 0u;
+            sb.append(SecSubmeshes, cs);
+
+            appendTexture(baseColorTexturesCPU[i]);
+            appendTexture(emissiveTexturesCPU[i]);
+        }
 
-            if (!writeCPUTexture(baseColorTexturesCPU[i])) return;
-            if (!writeCPUTexture(emissiveTexturesCPU[i])) return;
+        // Write to a temp file and rename, so a crash never leaves a truncated cache behind.
+        const fs::path tmpPath = cpath.string() + ".tmp";
+        {
+            std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+            if (!out.is_open()) return false;
+            if (!sb.write(out, hdr)) return false;
         }
+        fs::rename(tmpPath, cpath);
+
+        if (texStats) *texStats = stats;
 
         STARTUP_LOG(std::string("[Model] Cache wrote: ") + filepath + " -> " + cpath.string());
+        return true;
     } catch (...) {
         // ignore cache write failures
+        return false;
     }
 }
+
+// ------------------------------------------------------------
+// Offline cooking
+// ------------------------------------------------------------
+bool Model::isCacheUpToDate(const std::string& filepath)
+{
+    using namespace pac_model_cache_detail;
+
+    try {
+        const fs::path cpath = cachePathForModel(filepath);
+        if (!fs::exists(cpath) || !fs::exists(filepath)) return false;
+
+        CacheHeader hdr{};
+        std::ifstream in(cpath, std::ios::binary);
+        if (!in.read(reinterpret_cast<char*>(&hdr), sizeof(hdr))) return false;
+
+        return hdr.magic == kModelCacheMagic &&
+               hdr.version == kModelCacheVersion &&
+               hdr.srcFileSize == (uint64_t)fs::file_size(filepath) &&
+               hdr.srcWriteTime == (int64_t)fs::last_write_time(filepath).time_since_epoch().count();
+    } catch (...) {
+        return false;
+    }
+}
+
+Model::CookResult Model::cookCache(const std::string& filepath, const CookOptions& options)
+{
+    using namespace pac_model_cache_detail;
+
+    CookResult r{};
+    if (!options.force && isCacheUpToDate(filepath)) {
+        r.status = CookResult::Status::UpToDate;
+    } else {
+        Model model{CookOnly{}};
+        CPUGeometry geo;
+
+        const auto t0 = clock::now();
+        if (!model.parseGLTF(filepath, geo)) return r;
+        r.parseMs = msSince(t0);
+
+        const auto t1 = clock::now();
+        model.prepareGeometry(geo, options.generateLods, options.optimizeIndices && !envTruthy("PAC_DISABLE_INDEX_OPT"),
+                              options.packVertices, options.bakeAnimations && !envTruthy("PAC_DISABLE_ANIM_BAKE"),
+                              options.compressAnimations && !envTruthy("PAC_DISABLE_ANIM_COMPRESS"));
+        if (!model.writeCache(filepath, geo, options.compressTextures, &r.textures)) return r;
+        r.writeMs = msSince(t1);
+        r.import = model.getLoadTiming();
+
+        r.vertexLayout    = geo.layout;
+        r.fullVertexBytes = (uint64_t)geo.vertices.size() * sizeof(Vertex);
+        r.vertexBytes     = (geo.layout == VertexLayout::Packed)
+                          ? (uint64_t)geo.packedVertices.size() * sizeof(PackedVertex)
+                          : r.fullVertexBytes;
+        r.fullIndexBytes  = (uint64_t)geo.indices.size() * sizeof(uint32_t);
+        r.indexBytes      = (uint64_t)geo.indexBuffer.size();
+
+        r.lodCount = model.lodCount;
+        for (uint32_t l = 0; l < pac_model_types::kMaxMeshLods; ++l) {
+            for (const Submesh& sm : model.submeshes) {
+                r.lodTriangles[l] += sm.lods[(std::min)(l, sm.lodCount - 1)].indexCount / 3;
+            }
+        }
+
+        if (model.bakedFrameStride > 0) {
+            r.bakedFrames = (uint32_t)(geo.bakedFrames.size() / model.bakedFrameStride);
+            r.bakedBytes  = (uint64_t)geo.bakedFrames.size() * sizeof(glm::mat4);
+        }
+
+        r.clips = model.clipCompressStats;
+
+        r.status = CookResult::Status::Cooked;
+    }
+
+    std::error_code ec;
+    const auto sz = fs::file_size(cachePathForModel(filepath), ec);
+    r.cacheBytes = ec ? 0 : (uint64_t)sz;
+    return r;
+}
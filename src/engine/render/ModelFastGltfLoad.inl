@@ -1,12 +1,14 @@
 // src/engine/render/ModelFastGltfLoad.inl
 //
-// Intentionally included inside Model::loadGLTF(...) in Model.cpp
+// Intentionally included inside Model::parseGLTF(...) in Model.cpp.
+// CPU only: no GL calls here, so the offline cooker can run it without a context.
 
 // ✅ Fix: always use correct animation types regardless of where this is included
 using pac_model_types::AnimationClip;
 using pac_model_types::AnimationSampler;
 using pac_model_types::AnimationChannel;
 using pac_model_types::ChannelPath;
+using pac_model_types::Interpolation;
 
 struct FG {
     using CPUTexture = Model::CPUTexture;
@@ -197,38 +199,9 @@ struct FG {
         return t;
     }
 
-    static CPUTexture decodeBaseColorTextureFast(const fastgltf::Asset& asset,
-                                                 const std::filesystem::path& baseDir,
-                                                 int materialIndex) {
-        if (materialIndex < 0 || materialIndex >= (int)asset.materials.size()) {
-            return makeWhiteCPUTexture();
-        }
-
-        const auto& mat = asset.materials[(size_t)materialIndex];
-
-        if (!mat.pbrData.baseColorTexture.has_value()) {
-            CPUTexture t;
-            t.width = 1; t.height = 1;
-            t.wrapS = GL_REPEAT;
-            t.wrapT = GL_REPEAT;
-            t.minF  = GL_LINEAR;
-            t.magF  = GL_LINEAR;
-
-            auto f = mat.pbrData.baseColorFactor;
-            auto toU8 = [](float x)->uint8_t {
-                x = (std::max)(0.0f, (std::min)(1.0f, x));
-                return (uint8_t)std::lround(x * 255.0f);
-            };
-            t.rgba = { toU8(f[0]), toU8(f[1]), toU8(f[2]), toU8(f[3]) };
-            return t;
-        }
-
-        const auto& texInfo = mat.pbrData.baseColorTexture.value();
-        const size_t texIndex = texInfo.textureIndex;
-        if (texIndex >= asset.textures.size()) {
-            return makeWhiteCPUTexture();
-        }
-
+    // glTF texture -> image index (first of the image sources we know about).
+    static std::optional<size_t> resolveImageIndex(const fastgltf::Asset& asset, size_t texIndex) {
+        if (texIndex >= asset.textures.size()) return std::nullopt;
         const auto& tex = asset.textures[texIndex];
 
         fastgltf::Optional<std::size_t> imgIndexOpt = tex.imageIndex;
@@ -236,36 +209,85 @@ struct FG {
         if (!imgIndexOpt.has_value()) imgIndexOpt = tex.basisuImageIndex;
         if (!imgIndexOpt.has_value()) imgIndexOpt = tex.ddsImageIndex;
 
-        if (!imgIndexOpt.has_value()) return makeWhiteCPUTexture();
+        if (!imgIndexOpt.has_value()) return std::nullopt;
+        if (imgIndexOpt.value() >= asset.images.size()) return std::nullopt;
+        return imgIndexOpt.value();
+    }
 
-        const size_t imgIndex = imgIndexOpt.value();
-        if (imgIndex >= asset.images.size()) return makeWhiteCPUTexture();
+    static std::optional<size_t> materialImage(const fastgltf::Asset& asset, int materialIndex, bool emissive) {
+        if (materialIndex < 0 || materialIndex >= (int)asset.materials.size()) return std::nullopt;
+        const auto& mat = asset.materials[(size_t)materialIndex];
+        if (emissive) {
+            if (!mat.emissiveTexture.has_value()) return std::nullopt;
+            return resolveImageIndex(asset, mat.emissiveTexture.value().textureIndex);
+        }
+        if (!mat.pbrData.baseColorTexture.has_value()) return std::nullopt;
+        return resolveImageIndex(asset, mat.pbrData.baseColorTexture.value().textureIndex);
+    }
 
-        const auto& img = asset.images[imgIndex];
-        auto enc = getEncodedImageBytes(asset, baseDir, img);
-        if (!enc.has_value() || enc->bytes.empty()) return makeWhiteCPUTexture();
+    // One decoded glTF image (indexed like asset.images); empty rgba => decode failed / unused.
+    struct DecodedImage {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        std::vector<uint8_t> rgba;
+        double decodeMs = 0.0;
+    };
 
-        int w = 0, h = 0, comp = 0;
-        stbi_uc* decoded = stbi_load_from_memory(
-            enc->bytes.data(),
-            (int)enc->bytes.size(),
-            &w, &h, &comp, 4
-        );
+    static void decodeImage(const fastgltf::Asset& asset,
+                            const std::filesystem::path& baseDir,
+                            size_t imgIndex,
+                            DecodedImage& out) {
+        const auto t0 = std::chrono::steady_clock::now();
+
+        auto enc = getEncodedImageBytes(asset, baseDir, asset.images[imgIndex]);
+        if (enc.has_value() && !enc->bytes.empty()) {
+            int w = 0, h = 0, comp = 0;
+            stbi_uc* decoded = stbi_load_from_memory(
+                enc->bytes.data(),
+                (int)enc->bytes.size(),
+                &w, &h, &comp, 4
+            );
 
-        if (decoded == nullptr || w <= 0 || h <= 0) {
+            if (decoded != nullptr && w > 0 && h > 0) {
+                out.width  = (uint32_t)w;
+                out.height = (uint32_t)h;
+                out.rgba.assign(decoded, decoded + (size_t)w * (size_t)h * 4);
+            }
             if (decoded) stbi_image_free(decoded);
-            return makeWhiteCPUTexture();
         }
 
+        out.decodeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    }
+
+    // Decodes the given (unique) images concurrently on the shared WorkerPool (the calling
+    // thread takes part). images must be sized to asset.images.
+    static void decodeImagesParallel(const fastgltf::Asset& asset,
+                                     const std::filesystem::path& baseDir,
+                                     const std::vector<size_t>& imageIndices,
+                                     std::vector<DecodedImage>& images) {
+        WorkerPool::getInstance().parallelFor(imageIndices.size(), [&](size_t i) {
+            // glTF images are never flipped. Only pool threads pin the flag: setting it on
+            // the caller would stick to that thread and override the global flag other
+            // loaders rely on.
+            if (WorkerPool::isWorkerThread()) stbi_set_flip_vertically_on_load_thread(0);
+            decodeImage(asset, baseDir, imageIndices[i], images[imageIndices[i]]);
+        });
+    }
+
+    static CPUTexture makeDecodedTexture(const fastgltf::Asset& asset,
+                                         size_t texIndex,
+                                         const DecodedImage& img) {
         CPUTexture out;
-        out.width  = (uint32_t)w;
-        out.height = (uint32_t)h;
+        out.width  = img.width;
+        out.height = img.height;
+        out.rgba   = img.rgba;
 
         out.wrapS = GL_REPEAT;
         out.wrapT = GL_REPEAT;
         out.minF  = GL_LINEAR_MIPMAP_LINEAR;
         out.magF  = GL_LINEAR;
 
+        const auto& tex = asset.textures[texIndex];
         if (tex.samplerIndex.has_value() && tex.samplerIndex.value() < asset.samplers.size()) {
             const auto& s = asset.samplers[tex.samplerIndex.value()];
             out.wrapS = wrapToGL(s.wrapS);
@@ -273,86 +295,50 @@ struct FG {
             if (s.minFilter.has_value()) out.minF = filterToGLMin((int)s.minFilter.value());
             if (s.magFilter.has_value()) out.magF = filterToGLMag((int)s.magFilter.value());
         }
-
-        const size_t pxCount = (size_t)w * (size_t)h;
-        out.rgba.resize(pxCount * 4);
-        std::memcpy(out.rgba.data(), decoded, pxCount * 4);
-        stbi_image_free(decoded);
-
         return out;
     }
 
-    static CPUTexture decodeEmissiveTextureFast(const fastgltf::Asset& asset,
-                                                const std::filesystem::path& baseDir,
-                                                int materialIndex) {
+    static CPUTexture makeBaseColorTexture(const fastgltf::Asset& asset,
+                                           const std::vector<DecodedImage>& images,
+                                           int materialIndex) {
         if (materialIndex < 0 || materialIndex >= (int)asset.materials.size()) {
-            return makeBlackCPUTexture();
+            return makeWhiteCPUTexture();
         }
 
         const auto& mat = asset.materials[(size_t)materialIndex];
 
-        // No emissive texture -> return a 1x1 black tex; factor will still be applied in shader.
-        if (!mat.emissiveTexture.has_value()) {
-            return makeBlackCPUTexture();
-        }
-
-        const auto& texInfo = mat.emissiveTexture.value();
-        const size_t texIndex = texInfo.textureIndex;
-        if (texIndex >= asset.textures.size()) {
-            return makeBlackCPUTexture();
-        }
-
-        const auto& tex = asset.textures[texIndex];
-
-        fastgltf::Optional<std::size_t> imgIndexOpt = tex.imageIndex;
-        if (!imgIndexOpt.has_value()) imgIndexOpt = tex.webpImageIndex;
-        if (!imgIndexOpt.has_value()) imgIndexOpt = tex.basisuImageIndex;
-        if (!imgIndexOpt.has_value()) imgIndexOpt = tex.ddsImageIndex;
-
-        if (!imgIndexOpt.has_value()) return makeBlackCPUTexture();
-
-        const size_t imgIndex = imgIndexOpt.value();
-        if (imgIndex >= asset.images.size()) return makeBlackCPUTexture();
-
-        const auto& img = asset.images[imgIndex];
-        auto enc = getEncodedImageBytes(asset, baseDir, img);
-        if (!enc.has_value() || enc->bytes.empty()) return makeBlackCPUTexture();
-
-        int w = 0, h = 0, comp = 0;
-        stbi_uc* decoded = stbi_load_from_memory(
-            enc->bytes.data(),
-            (int)enc->bytes.size(),
-            &w, &h, &comp, 4
-        );
+        if (!mat.pbrData.baseColorTexture.has_value()) {
+            CPUTexture t;
+            t.width = 1; t.height = 1;
+            t.wrapS = GL_REPEAT;
+            t.wrapT = GL_REPEAT;
+            t.minF  = GL_LINEAR;
+            t.magF  = GL_LINEAR;
 
-        if (decoded == nullptr || w <= 0 || h <= 0) {
-            if (decoded) stbi_image_free(decoded);
-            return makeBlackCPUTexture();
+            auto f = mat.pbrData.baseColorFactor;
+            auto toU8 = [](float x)->uint8_t {
+                x = (std::max)(0.0f, (std::min)(1.0f, x));
+                return (uint8_t)std::lround(x * 255.0f);
+            };
+            t.rgba = { toU8(f[0]), toU8(f[1]), toU8(f[2]), toU8(f[3]) };
+            return t;
         }
 
-        CPUTexture out;
-        out.width  = (uint32_t)w;
-        out.height = (uint32_t)h;
+        const auto imgIndex = materialImage(asset, materialIndex, false);
+        if (!imgIndex.has_value() || images[*imgIndex].rgba.empty()) return makeWhiteCPUTexture();
 
-        out.wrapS = GL_REPEAT;
-        out.wrapT = GL_REPEAT;
-        out.minF  = GL_LINEAR_MIPMAP_LINEAR;
-        out.magF  = GL_LINEAR;
-
-        if (tex.samplerIndex.has_value() && tex.samplerIndex.value() < asset.samplers.size()) {
-            const auto& s = asset.samplers[tex.samplerIndex.value()];
-            out.wrapS = wrapToGL(s.wrapS);
-            out.wrapT = wrapToGL(s.wrapT);
-            if (s.minFilter.has_value()) out.minF = filterToGLMin((int)s.minFilter.value());
-            if (s.magFilter.has_value()) out.magF = filterToGLMag((int)s.magFilter.value());
-        }
+        return makeDecodedTexture(asset, mat.pbrData.baseColorTexture.value().textureIndex, images[*imgIndex]);
+    }
 
-        const size_t pxCount = (size_t)w * (size_t)h;
-        out.rgba.resize(pxCount * 4);
-        std::memcpy(out.rgba.data(), decoded, pxCount * 4);
-        stbi_image_free(decoded);
+    static CPUTexture makeEmissiveTexture(const fastgltf::Asset& asset,
+                                          const std::vector<DecodedImage>& images,
+                                          int materialIndex) {
+        // No emissive texture -> return a 1x1 black tex; factor will still be applied in shader.
+        const auto imgIndex = materialImage(asset, materialIndex, true);
+        if (!imgIndex.has_value() || images[*imgIndex].rgba.empty()) return makeBlackCPUTexture();
 
-        return out;
+        const auto& mat = asset.materials[(size_t)materialIndex];
+        return makeDecodedTexture(asset, mat.emissiveTexture.value().textureIndex, images[*imgIndex]);
     }
 
     static void readScalarFloat(const fastgltf::Asset& asset,
@@ -415,17 +401,18 @@ struct FG {
     auto fg = pac::fastgltf_loader::tryLoad(filepath);
     if (!fg.has_value()) {
         std::cerr << "[gltf][FASTGLTF] FAILED to parse: " << filepath << "\n";
-        return;
+        return false;
     }
 
     const fastgltf::Asset& asset = fg->asset;
 
     // Reset model state
     nodesDefault.clear();
-    nodeChildren.clear();
     nodeMesh.clear();
     nodeSkin.clear();
-    sceneRoots.clear();
+    nodeParent.clear();
+    nodeOrder.clear();
+    meshNodeOrder.clear();
     skins.clear();
     animations.clear();
     submeshes.clear();
@@ -433,8 +420,10 @@ struct FG {
     fastgltf::DefaultBufferDataAdapter adapter{};
 
     // ---- Nodes + scene roots ----
+    std::vector<std::vector<int>> nodeChildren(asset.nodes.size());
+    std::vector<int> sceneRoots;
+
     nodesDefault.resize(asset.nodes.size());
-    nodeChildren.resize(asset.nodes.size());
     nodeMesh.assign(asset.nodes.size(), -1);
     nodeSkin.assign(asset.nodes.size(), -1);
 
@@ -443,7 +432,6 @@ struct FG {
         if (asset.defaultScene.has_value()) sceneIndex = asset.defaultScene.value();
         if (sceneIndex >= asset.scenes.size()) sceneIndex = 0;
 
-        sceneRoots.clear();
         for (auto n : asset.scenes[sceneIndex].nodeIndices) {
             sceneRoots.push_back((int)n);
         }
@@ -452,7 +440,6 @@ struct FG {
     for (size_t i = 0; i < asset.nodes.size(); ++i) {
         const auto& n = asset.nodes[i];
 
-        nodeChildren[i].clear();
         nodeChildren[i].reserve(n.children.size());
         for (auto c : n.children) nodeChildren[i].push_back((int)c);
 
@@ -474,6 +461,8 @@ struct FG {
         nodesDefault[i] = trs;
     }
 
+    buildNodeHierarchy(nodeChildren, sceneRoots);
+
     // ---- Skins ----
     skins.resize(asset.skins.size());
     for (size_t si = 0; si < asset.skins.size(); ++si) {
@@ -512,10 +501,10 @@ struct FG {
             AnimationSampler samp;
 
             switch (s.interpolation) {
-                case fastgltf::AnimationInterpolation::Step:        samp.interpolation = "STEP"; break;
-                case fastgltf::AnimationInterpolation::CubicSpline: samp.interpolation = "CUBICSPLINE"; break;
+                case fastgltf::AnimationInterpolation::Step:        samp.interpolation = Interpolation::Step; break;
+                case fastgltf::AnimationInterpolation::CubicSpline: samp.interpolation = Interpolation::CubicSpline; break;
                 case fastgltf::AnimationInterpolation::Linear:
-                default:                                           samp.interpolation = "LINEAR"; break;
+                default:                                           samp.interpolation = Interpolation::Linear; break;
             }
 
             if (s.inputAccessor < asset.accessors.size()) {
@@ -537,15 +526,17 @@ struct FG {
                     samp.isVec4 = true;
                 }
 
-                if (samp.interpolation == "CUBICSPLINE" && !samp.inputs.empty()) {
-                    const size_t keys = samp.inputs.size();
-                    std::vector<glm::vec4> values;
-                    values.reserve(keys);
+                if (samp.interpolation == Interpolation::CubicSpline && !samp.inputs.empty()) {
+                    // glTF packs each key as (in-tangent, value, out-tangent).
+                    const size_t keys = (std::min)(samp.inputs.size(), raw.size() / 3);
+                    samp.inTangents.resize(keys);
+                    samp.outputs.resize(keys);
+                    samp.outTangents.resize(keys);
                     for (size_t k = 0; k < keys; ++k) {
-                        const size_t idx = k * 3 + 1;
-                        if (idx < raw.size()) values.push_back(raw[idx]);
+                        samp.inTangents[k]  = raw[k * 3 + 0];
+                        samp.outputs[k]     = raw[k * 3 + 1];
+                        samp.outTangents[k] = raw[k * 3 + 2];
                     }
-                    samp.outputs = std::move(values);
                 } else {
                     samp.outputs = std::move(raw);
                 }
@@ -581,16 +572,51 @@ struct FG {
               << " nodes=" << nodesDefault.size() << "\n";
 
     // ---- Meshes + textures ----
-    std::vector<Vertex> vertices;
-    std::vector<uint32_t> indices;
+    std::vector<Vertex>& vertices = out.vertices;
+    std::vector<uint32_t>& indices = out.indices;
+    vertices.clear();
+    indices.clear();
     vertices.reserve(20000);
     indices.reserve(60000);
 
-    std::vector<FG::CPUTexture> baseColorTexturesCPU;
-    std::vector<FG::CPUTexture> emissiveTexturesCPU;
+    std::vector<FG::CPUTexture>& baseColorTexturesCPU = out.baseColorTextures;
+    std::vector<FG::CPUTexture>& emissiveTexturesCPU = out.emissiveTextures;
+    baseColorTexturesCPU.clear();
+    emissiveTexturesCPU.clear();
     baseColorTexturesCPU.reserve(64);
     emissiveTexturesCPU.reserve(64);
 
+    // ---- Texture decode: every unique image once, in parallel, before the mesh loop ----
+    std::vector<FG::DecodedImage> decodedImages(asset.images.size());
+    {
+        std::vector<uint8_t> wanted(asset.images.size(), 0);
+        std::vector<size_t> imageIndices;
+
+        for (const auto& mesh : asset.meshes) {
+            for (const auto& p : mesh.primitives) {
+                if (p.type != fastgltf::PrimitiveType::Triangles) continue;
+                if (!fgOptHas(p.materialIndex)) continue;
+
+                const int materialIndex = (int)fgOptGet(p.materialIndex);
+                for (bool emissive : { false, true }) {
+                    const auto img = FG::materialImage(asset, materialIndex, emissive);
+                    if (img.has_value() && !wanted[*img]) {
+                        wanted[*img] = 1;
+                        imageIndices.push_back(*img);
+                    }
+                }
+            }
+        }
+
+        const auto t0 = std::chrono::steady_clock::now();
+        FG::decodeImagesParallel(asset, fg->baseDir, imageIndices, decodedImages);
+
+        loadTiming.imageCount     = (uint32_t)imageIndices.size();
+        loadTiming.decodeWallMs   = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        loadTiming.decodeSerialMs = 0.0;
+        for (size_t i : imageIndices) loadTiming.decodeSerialMs += decodedImages[i].decodeMs;
+    }
+
     float minX = std::numeric_limits<float>::max(), minY = std::numeric_limits<float>::max(), minZ = std::numeric_limits<float>::max();
     float maxX = -minX, maxY = -minY, maxZ = -minZ;
 
@@ -715,8 +741,8 @@ struct FG {
             }
 
             // --- material decode (minimal glTF) ---
-            FG::CPUTexture baseCPU = FG::decodeBaseColorTextureFast(asset, fg->baseDir, materialIndex);
-            FG::CPUTexture emissiveCPU = FG::decodeEmissiveTextureFast(asset, fg->baseDir, materialIndex);
+            FG::CPUTexture baseCPU = FG::makeBaseColorTexture(asset, decodedImages, materialIndex);
+            FG::CPUTexture emissiveCPU = FG::makeEmissiveTexture(asset, decodedImages, materialIndex);
 
             glm::vec3 emissiveFactor(0.0f);
             int alphaMode = 0;       // OPAQUE
@@ -749,55 +775,9 @@ struct FG {
                 doubleSided = mat.doubleSided;
             }
 
-            // Upload baseColor texture
-            GLuint baseTexId = 0;
-            glGenTextures(1, &baseTexId);
-            glBindTexture(GL_TEXTURE_2D, baseTexId);
-            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-
-            const uint32_t bw = (baseCPU.width  == 0 ? 1u : baseCPU.width);
-            const uint32_t bh = (baseCPU.height == 0 ? 1u : baseCPU.height);
-            const void* bpixels = baseCPU.rgba.empty() ? nullptr : baseCPU.rgba.data();
-
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, (GLsizei)bw, (GLsizei)bh, 0,
-                         GL_RGBA, GL_UNSIGNED_BYTE, bpixels);
-
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, (GLint)baseCPU.wrapS);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, (GLint)baseCPU.wrapT);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, (GLint)baseCPU.minF);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, (GLint)baseCPU.magF);
-
-            if (isMipmapMinFilter((GLint)baseCPU.minF)) {
-                glGenerateMipmap(GL_TEXTURE_2D);
-            }
-
-            // Upload emissive texture
-            GLuint emissiveTexId = 0;
-            glGenTextures(1, &emissiveTexId);
-            glBindTexture(GL_TEXTURE_2D, emissiveTexId);
-            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-
-            const uint32_t ew = (emissiveCPU.width  == 0 ? 1u : emissiveCPU.width);
-            const uint32_t eh = (emissiveCPU.height == 0 ? 1u : emissiveCPU.height);
-            const void* epixels = emissiveCPU.rgba.empty() ? nullptr : emissiveCPU.rgba.data();
-
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, (GLsizei)ew, (GLsizei)eh, 0,
-                         GL_RGBA, GL_UNSIGNED_BYTE, epixels);
-
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, (GLint)emissiveCPU.wrapS);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, (GLint)emissiveCPU.wrapT);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, (GLint)emissiveCPU.minF);
-            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, (GLint)emissiveCPU.magF);
-
-            if (isMipmapMinFilter((GLint)emissiveCPU.minF)) {
-                glGenerateMipmap(GL_TEXTURE_2D);
-            }
-
             Submesh sm;
-            sm.indexOffset = subIndexOffset;
-            sm.indexCount  = primIdxU32.size();
-            sm.baseColorTexID = baseTexId;
-            sm.emissiveTexID  = emissiveTexId;
+            sm.lods[0].indexOffset = subIndexOffset;
+            sm.lods[0].indexCount  = primIdxU32.size();
             sm.emissiveFactor = emissiveFactor;
             sm.alphaMode      = alphaMode;
             sm.alphaCutoff    = alphaCutoff;
@@ -820,37 +800,11 @@ struct FG {
         std::string("[Model] Loaded (fastgltf): ") + filepath +
         " vertices=" + std::to_string(vertices.size()) +
         " indices=" + std::to_string(indices.size()) +
-        " submeshes=" + std::to_string(submeshes.size())
+        " submeshes=" + std::to_string(submeshes.size()) +
+        " images=" + std::to_string(loadTiming.imageCount) +
+        " decode wall/serial ms=" + std::to_string(loadTiming.decodeWallMs) +
+        "/" + std::to_string(loadTiming.decodeSerialMs)
     );
 
-    // ---- Upload geometry ----
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-    glGenBuffers(1, &EBO);
-
-    glBindVertexArray(VAO);
-
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
-
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint32_t), indices.data(), GL_STATIC_DRAW);
-
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, px));
-    glEnableVertexAttribArray(0);
-
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, u));
-    glEnableVertexAttribArray(1);
-
-    glVertexAttribIPointer(2, 4, GL_UNSIGNED_SHORT, sizeof(Vertex), (void*)offsetof(Vertex, j0));
-    glEnableVertexAttribArray(2);
-
-    glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, w0));
-    glEnableVertexAttribArray(3);
-
-    glBindVertexArray(0);
-
-    // ---- Cache write ----
-    writeCache(filepath, vertices, indices, baseColorTexturesCPU, emissiveTexturesCPU);
-    std::cerr << "[gltf][FASTGLTF] COMPLETE for: " << filepath << "\n";
+    return true;
 }
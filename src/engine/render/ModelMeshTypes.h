@@ -12,4 +12,34 @@ struct Vertex {
     float w0, w1, w2, w3;
 };
 
+// Compact skinned vertex, 20 bytes instead of 44: position as unorm16 over the model's
+// AABB, IEEE half UVs, 8-bit joint indices and unorm8 weights.
+struct PackedVertex {
+    std::uint16_t px, py, pz, pad;
+    std::uint16_t u, v;
+    std::uint8_t  j[4];
+    std::uint8_t  w[4];
+};
+
+// Which of the two lives in a VBO / .pacmdl. Stored on disk; don't renumber.
+enum class VertexLayout : std::uint32_t {
+    Full   = 0, // Vertex
+    Packed = 1, // PackedVertex
+};
+
+// Packed position decode: pos = unorm * scale + offset (identity for Full).
+struct VertexQuantization {
+    float offset[3] = { 0.0f, 0.0f, 0.0f };
+    float scale[3]  = { 1.0f, 1.0f, 1.0f };
+};
+
+// Element type of a submesh's index range; the value is its size in bytes. Stored on disk.
+enum class IndexType : std::uint32_t {
+    U16 = 2,
+    U32 = 4,
+};
+
+// Levels of detail per submesh, including the full-resolution LOD0.
+constexpr std::uint32_t kMaxMeshLods = 4;
+
 } // namespace pac_model_types
@@ -0,0 +1,94 @@
+// src/engine/render/RenderQueue.cpp
+
+#include "RenderQueue.h"
+
+#include "Camera3D.h"
+#include "GLStateCache.h"
+#include "Model.h"
+
+#include <algorithm>
+
+namespace {
+
+constexpr int kDepthBits   = 24;
+constexpr int kShaderBits  = 8;
+constexpr int kTextureBits = 20;
+constexpr int kUnusedBits  = 11;
+
+static_assert(1 + kDepthBits + kShaderBits + kTextureBits + kUnusedBits == 64, "key layout");
+
+constexpr uint64_t kDepthMask   = (1ull << kDepthBits) - 1;
+constexpr uint64_t kShaderMask  = (1ull << kShaderBits) - 1;
+constexpr uint64_t kTextureMask = (1ull << kTextureBits) - 1;
+
+} // namespace
+
+void RenderQueue::begin(const Camera3D& camera)
+{
+    items.clear();
+    view     = camera.getViewMatrix();
+    viewProj = camera.getViewProjectionMatrix();
+    projScaleY = camera.getProjectionMatrix()[1][1];
+    farZ     = (std::max)(camera.getFarPlane(), 0.001f);
+    ++frameId;
+}
+
+float RenderQueue::viewDepth(const glm::vec3& worldPos) const
+{
+    const glm::vec4 v = view * glm::vec4(worldPos, 1.0f);
+    return (std::max)(-v.z, 0.0f);
+}
+
+float RenderQueue::depth01(float d) const
+{
+    return std::clamp(d / farZ, 0.0f, 1.0f);
+}
+
+uint64_t RenderQueue::makeKey(bool blend, uint32_t shader, uint32_t texture, float d01)
+{
+    const uint64_t depth = (uint64_t)(d01 * (float)kDepthMask) & kDepthMask;
+    const uint64_t sh    = (uint64_t)shader  & kShaderMask;
+    const uint64_t tex   = (uint64_t)texture & kTextureMask;
+
+    if (!blend) {
+        // Opaque: state first, then nearest first (early-z).
+        return (sh    << (64 - 1 - kShaderBits))
+             | (tex   << (64 - 1 - kShaderBits - kTextureBits))
+             | (depth << kUnusedBits);
+    }
+
+    // Blend: farthest first; state only breaks depth ties.
+    return (1ull << 63)
+         | ((kDepthMask - depth) << (64 - 1 - kDepthBits))
+         | (sh  << (64 - 1 - kDepthBits - kShaderBits))
+         | (tex << kUnusedBits);
+}
+
+void RenderQueue::flush()
+{
+    // Stable: equal keys keep submission (hierarchy) order.
+    std::stable_sort(items.begin(), items.end(),
+                     [](const DrawItem& a, const DrawItem& b) { return a.key < b.key; });
+
+    Stats stats;
+    stats.items = (uint32_t)items.size();
+
+    auto& gl = GLStateCache::getInstance();
+    const GLStateCache::Snapshot saved = gl.capture();
+
+    for (const DrawItem& item : items) {
+        if (item.key >> 63) ++stats.blendItems;
+        else ++stats.opaqueItems;
+
+        stats.triangles     += (uint64_t)item.model->getSubmeshTriangleCount(item.submesh, item.lod) * item.instanceCount;
+        stats.trianglesLod0 += (uint64_t)item.model->getSubmeshTriangleCount(item.submesh, 0) * item.instanceCount;
+
+        item.model->drawQueued(item);
+    }
+
+    gl.restore(saved);
+    gl.bindVertexArray(0);
+
+    lastStats = stats;
+    items.clear();
+}
@@ -0,0 +1,70 @@
+// src/engine/render/RenderQueue.h
+//
+// Frame-level draw list. Models record DrawItems, flush() sorts them by a packed
+// 64-bit key and draws them in order:
+//
+//   opaque/mask: [pass:1][shader:8][texture:20][depth:24][unused:11]   front-to-back
+//   blend:       [pass:1][~depth:24][shader:8][texture:20][unused:11]  back-to-front
+//
+// so all opaque work from every unit runs before any blended work, opaque draws are
+// grouped by shader/texture, and blended draws composite correctly.
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+class Camera3D;
+class Model;
+
+class RenderQueue {
+public:
+    struct DrawItem {
+        uint64_t     key = 0;
+        const Model* model = nullptr;
+        uint32_t     submesh = 0;        // index into the model's submeshes
+        uint16_t     meshSlot = 0;       // index into the model's meshNodeOrder (0 if none)
+        uint16_t     chunk = 0;          // model-owned instance buffer chunk
+        uint32_t     firstInstance = 0;  // within the chunk
+        uint32_t     instanceCount = 0;
+        uint8_t      lod = 0;            // level of detail (clamped per submesh)
+    };
+
+    struct Stats {
+        uint32_t items = 0;
+        uint32_t opaqueItems = 0;
+        uint32_t blendItems = 0;
+        uint64_t triangles = 0;     // what was drawn, after LOD selection
+        uint64_t trianglesLod0 = 0; // what the same items cost at full resolution
+    };
+
+    // Starts a new frame's list. Frame ids let models know when their staged data is stale.
+    void begin(const Camera3D& camera);
+
+    void push(const DrawItem& item) { items.push_back(item); }
+
+    // View-space distance along the camera forward axis (>= 0 in front of the camera).
+    float viewDepth(const glm::vec3& worldPos) const;
+
+    static uint64_t makeKey(bool blend, uint32_t shader, uint32_t texture, float depth01);
+    float depth01(float viewDepth) const;
+
+    // Sorts and draws everything recorded since begin(). GL state is restored afterwards.
+    void flush();
+
+    uint64_t getFrameId() const { return frameId; }
+    const glm::mat4& getView() const { return view; }
+    const glm::mat4& getViewProj() const { return viewProj; }
+    float getProjScaleY() const { return projScaleY; } // projection[1][1]
+    const Stats& getLastStats() const { return lastStats; }
+
+private:
+    std::vector<DrawItem> items;
+    glm::mat4 view{1.0f};
+    glm::mat4 viewProj{1.0f};
+    float     farZ = 100.0f;
+    float     projScaleY = 1.0f;
+    uint64_t  frameId = 0;
+    Stats     lastStats;
+};
@@ -1,6 +1,7 @@
 // Renderer.cpp
 
 #include "Renderer.h"
+#include "GLStateCache.h"
 #include <glad/glad.h>
 #include <fstream>
 #include <sstream>
@@ -32,7 +33,7 @@ Renderer::Renderer()
     std::cout << "[Renderer] Shader program created with ID: " << shader->getID() << "\n";
     checkGLError("After shader program creation");
 
-    glBindVertexArray(vao.getID());
+    GLStateCache::getInstance().bindVertexArray(vao.getID());
     glBindBuffer(vbo.getTarget(), vbo.getID());
     glBufferData(vbo.getTarget(), sizeof(vertices), vertices, GL_STATIC_DRAW);
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
@@ -53,7 +54,7 @@ Renderer::~Renderer() {
 
 void Renderer::render() {
     shader->use();
-    glBindVertexArray(vao.getID());
+    GLStateCache::getInstance().bindVertexArray(vao.getID());
     glDrawArrays(GL_TRIANGLES, 0, 3);
 }
 
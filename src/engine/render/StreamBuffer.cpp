@@ -0,0 +1,188 @@
+// src/engine/render/StreamBuffer.cpp
+
+#include "StreamBuffer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+// glBufferStorage only exists when the loader was generated with GL 4.4 or the extension.
+#if defined(GL_ARB_buffer_storage) || defined(GL_VERSION_4_4)
+    #define PAC_HAS_BUFFER_STORAGE 1
+#else
+    #define PAC_HAS_BUFFER_STORAGE 0
+#endif
+
+namespace {
+
+std::atomic<bool> g_persistentSupported{ false };
+StreamBuffer::Stats g_stats;
+
+bool persistentMapDisabled()
+{
+    static const bool disabled = [] {
+        const char* env = std::getenv("PAC_DISABLE_PERSISTENT_MAP");
+        return env && *env && std::string(env) != "0";
+    }();
+    return disabled;
+}
+
+} // namespace
+
+void StreamBuffer::detectPersistentMappingSupport()
+{
+    bool found = false;
+#if PAC_HAS_BUFFER_STORAGE
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count && !found; ++i) {
+        const char* ext = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, (GLuint)i));
+        found = ext && std::strcmp(ext, "GL_ARB_buffer_storage") == 0;
+    }
+#endif
+    g_persistentSupported = found && !persistentMapDisabled();
+}
+
+bool StreamBuffer::persistentMappingSupported()
+{
+    return g_persistentSupported.load(std::memory_order_relaxed);
+}
+
+const StreamBuffer::Stats& StreamBuffer::getGlobalStats()
+{
+    return g_stats;
+}
+
+void StreamBuffer::resetGlobalStats()
+{
+    g_stats = Stats{};
+}
+
+StreamBuffer::~StreamBuffer()
+{
+    destroy();
+}
+
+void StreamBuffer::destroy()
+{
+    for (GLsync& f : fences) {
+        if (f) glDeleteSync(f);
+        f = nullptr;
+    }
+    if (buffer) {
+        if (persistentPtr) {
+            glBindBuffer(GL_ARRAY_BUFFER, buffer);
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+        }
+        glDeleteBuffers(1, &buffer);
+    }
+    buffer = 0;
+    persistentPtr = nullptr;
+    persistent = false;
+    segmentBytes = 0;
+    segment = kSegments - 1;
+}
+
+void StreamBuffer::allocate(size_t minSegmentBytes)
+{
+    const bool growing = buffer != 0;
+    // Deleting a buffer the GPU still reads is fine in GL; the store lives until it's done.
+    const size_t grown = std::max(minSegmentBytes, segmentBytes * 2);
+    destroy();
+    if (growing) ++g_stats.reallocs;
+
+    segmentBytes = (grown + stride - 1) / stride * stride;
+    const GLsizeiptr total = (GLsizeiptr)(segmentBytes * kSegments);
+
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+
+#if PAC_HAS_BUFFER_STORAGE
+    if (persistentMappingSupported()) {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_ARRAY_BUFFER, total, nullptr, flags);
+        persistentPtr = static_cast<unsigned char*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, total, flags));
+        persistent = persistentPtr != nullptr;
+        if (persistent) return;
+
+        // Mapping failed: immutable storage can't be respecified, start over on a new name.
+        glDeleteBuffers(1, &buffer);
+        glGenBuffers(1, &buffer);
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    }
+#endif
+    glBufferData(GL_ARRAY_BUFFER, total, nullptr, GL_STREAM_DRAW);
+}
+
+void StreamBuffer::waitForSegment(int seg)
+{
+    GLsync& f = fences[seg];
+    if (!f) return;
+
+    GLenum r = glClientWaitSync(f, 0, 0);
+    if (r == GL_TIMEOUT_EXPIRED) {
+        const auto t0 = std::chrono::steady_clock::now();
+        do {
+            r = glClientWaitSync(f, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000); // 1 ms
+        } while (r == GL_TIMEOUT_EXPIRED);
+        ++g_stats.stalls;
+        g_stats.stallMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    }
+    glDeleteSync(f);
+    f = nullptr;
+}
+
+void StreamBuffer::reserve(size_t bytes)
+{
+    if (!buffer || bytes > segmentBytes) allocate(std::max<size_t>(bytes, stride));
+    else glBindBuffer(GL_ARRAY_BUFFER, buffer);
+}
+
+void* StreamBuffer::map(size_t bytes)
+{
+    bytes = std::max<size_t>(bytes, stride);
+    const bool fresh = !buffer || bytes > segmentBytes;
+    if (fresh) allocate(bytes);
+    else glBindBuffer(GL_ARRAY_BUFFER, buffer);
+
+    segment = (segment + 1) % kSegments;
+    const size_t offset = (size_t)segment * segmentBytes;
+
+    if (persistent) {
+        waitForSegment(segment);
+        return persistentPtr + offset;
+    }
+
+    if (segment == 0 && !fresh) {
+        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)(segmentBytes * kSegments), nullptr, GL_STREAM_DRAW);
+    }
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT
+                           | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_FLUSH_EXPLICIT_BIT;
+    return glMapBufferRange(GL_ARRAY_BUFFER, (GLintptr)offset, (GLsizeiptr)bytes, flags);
+}
+
+GLint StreamBuffer::unmap(size_t bytesWritten)
+{
+    if (!persistent) {
+        if (bytesWritten > 0) glFlushMappedBufferRange(GL_ARRAY_BUFFER, 0, (GLsizeiptr)bytesWritten);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+    }
+
+    g_stats.bytesUploaded += bytesWritten;
+    ++g_stats.uploads;
+    return (GLint)((size_t)segment * segmentBytes / stride);
+}
+
+void StreamBuffer::fence()
+{
+    // The orphan path never rewrites a segment of a store the GPU may still read.
+    if (!persistent) return;
+
+    GLsync& f = fences[segment];
+    if (f) glDeleteSync(f);
+    f = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
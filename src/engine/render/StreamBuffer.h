@@ -0,0 +1,82 @@
+// src/engine/render/StreamBuffer.h
+//
+// Vertex data rewritten every frame (particles), streamed through a ring of kSegments
+// equal segments of one GL_ARRAY_BUFFER. Each map() takes the next segment, so the GPU
+// can still be reading the previous two while the CPU writes.
+//
+// Two paths:
+//   - persistent: GL_ARB_buffer_storage, mapped once (coherent). A fence is placed after
+//     the draws that read a segment and waited on before the segment is written again;
+//     a wait that actually blocks counts as a stall.
+//   - orphan (GL 3.3): the store is orphaned with glBufferData(nullptr) whenever the ring
+//     wraps, and each segment is mapped unsynchronized (nothing can still be reading it).
+//
+// A frame bigger than a segment grows the ring (new buffer name; re-point the VAO).
+#pragma once
+
+#include <glad/glad.h>
+
+#include <cstddef>
+#include <cstdint>
+
+class StreamBuffer {
+public:
+    static constexpr int kSegments = 3;
+
+    struct Stats {
+        uint64_t bytesUploaded = 0;
+        uint64_t uploads = 0;
+        uint64_t stalls = 0;      // fence waits that had to block
+        double   stallMs = 0.0;   // time spent blocked in them
+        uint64_t reallocs = 0;    // ring growth
+    };
+
+    // Looks for GL_ARB_buffer_storage (call after the context is up). PAC_DISABLE_PERSISTENT_MAP=1
+    // keeps every ring on the orphan path.
+    static void detectPersistentMappingSupport();
+    static bool persistentMappingSupported();
+
+    // Summed over every ring since the last reset.
+    static const Stats& getGlobalStats();
+    static void resetGlobalStats();
+
+public:
+    // stride: vertex size; segments stay a multiple of it so a segment's offset is a vertex index.
+    explicit StreamBuffer(size_t stride) : stride(stride) {}
+    ~StreamBuffer();
+
+    StreamBuffer(const StreamBuffer&) = delete;
+    StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+    // Allocates (or grows) segments of at least segmentBytes without mapping; leaves the
+    // buffer bound to GL_ARRAY_BUFFER.
+    void reserve(size_t segmentBytes);
+
+    // Leaves the buffer bound to GL_ARRAY_BUFFER and returns room for `bytes` (write only),
+    // or nullptr if GL couldn't map it (then there's nothing to unmap).
+    void* map(size_t bytes);
+    // Ends the write (bytesWritten <= the mapped size); returns the first vertex of the segment.
+    GLint unmap(size_t bytesWritten);
+    // After the draws that read the segment just written.
+    void fence();
+
+    void destroy();
+
+    GLuint getBuffer() const { return buffer; }
+    bool isPersistent() const { return persistent; }
+
+private:
+    void allocate(size_t minSegmentBytes);
+    void waitForSegment(int seg);
+
+private:
+    size_t stride = 1;
+    size_t segmentBytes = 0;
+
+    GLuint buffer = 0;
+    bool persistent = false;
+    unsigned char* persistentPtr = nullptr;
+
+    int segment = kSegments - 1; // last segment handed out
+    GLsync fences[kSegments] = {};
+};
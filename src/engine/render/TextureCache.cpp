@@ -0,0 +1,287 @@
+// src/engine/render/TextureCache.cpp
+
+#include "TextureCache.h"
+#include "GLStateCache.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#include <glad/glad.h>
+
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT  0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+struct TextureHandle::Entry {
+    unsigned int          id = 0;
+    uint64_t              key = 0;
+    TextureCache::Desc    desc;
+    uint64_t              bytes = 0;
+    bool                  shared = false; // registered in the cache map
+};
+
+unsigned int TextureHandle::getID() const {
+    return entry ? entry->id : 0;
+}
+
+namespace {
+
+// Outlives the singleton (plain bool, no destructor): handles held by other statics may be
+// released after TextureCache itself is gone.
+bool g_cacheAlive = true;
+
+std::atomic<bool> g_supportsBC{false};
+
+// Mips the driver generates for a level-0-only RGBA8 upload.
+bool generatesMips(const TextureCache::Desc& d)
+{
+    return d.levels <= 1 && d.format == TextureFormat::RGBA8 && TextureCache::isMipmapFilter(d.minF);
+}
+
+// VRAM estimate: the payload, plus a third for driver-generated mips.
+uint64_t textureBytes(const TextureCache::Desc& d)
+{
+    const uint64_t payload = TextureCache::payloadBytes(d);
+    return generatesMips(d) ? payload + payload / 3 : payload;
+}
+
+bool sameDesc(const TextureCache::Desc& a, const TextureCache::Desc& b)
+{
+    return a.width == b.width && a.height == b.height &&
+           a.wrapS == b.wrapS && a.wrapT == b.wrapT &&
+           a.minF  == b.minF  && a.magF  == b.magF &&
+           a.format == b.format && a.levels == b.levels;
+}
+
+GLenum glCompressedFormat(TextureFormat f)
+{
+    return (f == TextureFormat::BC1) ? GL_COMPRESSED_RGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+}
+
+inline uint64_t mix64(uint64_t h, uint64_t v)
+{
+    h ^= v * 0x9E3779B97F4A7C15ull;
+    h = (h << 27) | (h >> 37);
+    return h * 0xC2B2AE3D27D4EB4Full + 0x165667B19E3779F9ull;
+}
+
+} // namespace
+
+TextureCache& TextureCache::getInstance() {
+    static TextureCache instance;
+    return instance;
+}
+
+size_t TextureCache::levelBytes(TextureFormat format, uint32_t width, uint32_t height)
+{
+    const size_t w = (std::max)(width, 1u), h = (std::max)(height, 1u);
+    switch (format) {
+        case TextureFormat::BC1: return ((w + 3) / 4) * ((h + 3) / 4) * 8;
+        case TextureFormat::BC3: return ((w + 3) / 4) * ((h + 3) / 4) * 16;
+        case TextureFormat::RGBA8:
+        default:                 return w * h * 4;
+    }
+}
+
+size_t TextureCache::payloadBytes(const Desc& desc)
+{
+    size_t total = 0;
+    uint32_t w = desc.width, h = desc.height;
+    const uint32_t levels = (std::max)(desc.levels, 1u);
+    for (uint32_t l = 0; l < levels; ++l) {
+        total += levelBytes(desc.format, w, h);
+        w = (std::max)(w / 2, 1u);
+        h = (std::max)(h / 2, 1u);
+    }
+    return total;
+}
+
+uint32_t TextureCache::fullMipCount(uint32_t width, uint32_t height)
+{
+    uint32_t n = 1;
+    for (uint32_t m = (std::max)(width, height); m > 1; m /= 2) ++n;
+    return n;
+}
+
+bool TextureCache::isMipmapFilter(int minF)
+{
+    switch ((GLenum)minF) {
+        case GL_NEAREST_MIPMAP_NEAREST:
+        case GL_NEAREST_MIPMAP_LINEAR:
+        case GL_LINEAR_MIPMAP_NEAREST:
+        case GL_LINEAR_MIPMAP_LINEAR:
+            return true;
+        default:
+            return false;
+    }
+}
+
+void TextureCache::detectCompressionSupport()
+{
+    bool found = false;
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count && !found; ++i) {
+        const char* ext = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, (GLuint)i));
+        found = ext && std::strcmp(ext, "GL_EXT_texture_compression_s3tc") == 0;
+    }
+    g_supportsBC = found;
+}
+
+bool TextureCache::supportsBC()
+{
+    return g_supportsBC.load(std::memory_order_relaxed);
+}
+
+uint64_t TextureCache::hashPixels(const Desc& desc, const void* rgba)
+{
+    uint64_t h = 0xCBF29CE484222325ull;
+    h = mix64(h, ((uint64_t)desc.width << 32) | desc.height);
+    h = mix64(h, ((uint64_t)(uint32_t)desc.wrapS << 32) | (uint32_t)desc.wrapT);
+    h = mix64(h, ((uint64_t)(uint32_t)desc.minF << 32) | (uint32_t)desc.magF);
+    h = mix64(h, ((uint64_t)desc.format << 32) | desc.levels);
+
+    if (rgba) {
+        const size_t size = payloadBytes(desc);
+        const unsigned char* p = static_cast<const unsigned char*>(rgba);
+
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8) {
+            uint64_t w;
+            std::memcpy(&w, p + i, 8);
+            h = mix64(h, w);
+        }
+        uint64_t tail = 0;
+        std::memcpy(&tail, p + i, size - i);
+        h = mix64(h, tail ^ size);
+    }
+
+    // 0 means "not hashed yet" to acquire().
+    return h ? h : 1;
+}
+
+TextureHandle TextureCache::acquire(const Desc& in, const void* rgba, uint64_t hash)
+{
+    Desc desc = in;
+    if (desc.width  == 0) desc.width  = 1;
+    if (desc.height == 0) desc.height = 1;
+
+    // Compressed payloads need the extension; callers decode to RGBA8 otherwise.
+    if (desc.format != TextureFormat::RGBA8 && (!supportsBC() || !rgba)) return {};
+
+    const bool shareable = (rgba != nullptr);
+    if (shareable && hash == 0) hash = hashPixels(desc, rgba);
+
+    if (shareable) {
+        auto it = entries.find(hash);
+        if (it != entries.end()) {
+            if (auto existing = it->second.lock()) {
+                // Same hash with different sampler/size is a collision: upload separately.
+                if (sameDesc(existing->desc, desc)) {
+                    ++stats.hits;
+                    stats.bytesSaved += existing->bytes;
+                    return TextureHandle(std::move(existing));
+                }
+            }
+        }
+    }
+
+    GLuint tex = 0;
+    glGenTextures(1, &tex);
+    GLStateCache::getInstance().bindTexture(GL_TEXTURE_2D, tex);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    // Precomputed chains upload level by level; nothing is generated on the GPU.
+    const uint32_t levels = (std::max)(desc.levels, 1u);
+    const unsigned char* src = static_cast<const unsigned char*>(rgba);
+    uint32_t w = desc.width, h = desc.height;
+    for (uint32_t l = 0; l < levels; ++l) {
+        const size_t bytes = levelBytes(desc.format, w, h);
+        if (desc.format == TextureFormat::RGBA8) {
+            glTexImage2D(GL_TEXTURE_2D, (GLint)l, GL_RGBA8, (GLsizei)w, (GLsizei)h, 0,
+                         GL_RGBA, GL_UNSIGNED_BYTE, src);
+        } else {
+            glCompressedTexImage2D(GL_TEXTURE_2D, (GLint)l, glCompressedFormat(desc.format),
+                                   (GLsizei)w, (GLsizei)h, 0, (GLsizei)bytes, src);
+        }
+        if (src) src += bytes;
+        w = (std::max)(w / 2, 1u);
+        h = (std::max)(h / 2, 1u);
+    }
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, (GLint)desc.wrapS);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, (GLint)desc.wrapT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, (GLint)desc.minF);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, (GLint)desc.magF);
+
+    if (generatesMips(desc)) {
+        glGenerateMipmap(GL_TEXTURE_2D);
+    } else {
+        // Keeps a short chain (or a lone level under a mip filter) texture-complete.
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)(levels - 1));
+    }
+
+    auto* e = new TextureHandle::Entry();
+    e->id = tex;
+    e->key = hash;
+    e->desc = desc;
+    e->bytes = textureBytes(desc);
+
+    std::shared_ptr<TextureHandle::Entry> entry(e, [](TextureHandle::Entry* p) {
+        if (g_cacheAlive) TextureCache::getInstance().release(*p);
+        delete p;
+    });
+
+    if (shareable) {
+        auto& slot = entries[hash];
+        // Don't displace a live entry that merely collided.
+        if (slot.expired()) {
+            slot = entry;
+            e->shared = true;
+        }
+    }
+
+    ++stats.uploads;
+    ++stats.live;
+    stats.bytesUploaded += e->bytes;
+    stats.bytesLive += e->bytes;
+
+    return TextureHandle(std::move(entry));
+}
+
+TextureHandle TextureCache::white()
+{
+    static const unsigned char kWhite[4] = { 255, 255, 255, 255 };
+
+    Desc d;
+    d.wrapS = d.wrapT = GL_CLAMP_TO_EDGE;
+    d.minF  = d.magF  = GL_LINEAR;
+    return acquire(d, kWhite);
+}
+
+TextureCache::~TextureCache() {
+    g_cacheAlive = false;
+}
+
+void TextureCache::release(TextureHandle::Entry& e)
+{
+    if (e.shared) {
+        auto it = entries.find(e.key);
+        if (it != entries.end() && it->second.expired()) entries.erase(it);
+    }
+
+    --stats.live;
+    stats.bytesLive -= e.bytes;
+
+    if (e.id) GLStateCache::getInstance().deleteTextures(1, &e.id);
+}
+
+void TextureCache::shutdown()
+{
+    g_cacheAlive = false;
+    entries.clear();
+}
@@ -0,0 +1,102 @@
+// src/engine/render/TextureCache.h
+//
+// Content-addressed 2D textures. A texture is keyed by a hash of its pixel data
+// (RGBA8 or BC1/BC3 blocks, all mip levels) plus size and sampler state, so the same
+// image referenced by several submeshes, models, cards or particle systems is uploaded
+// once and shared.
+// GL thread only, except the static size/hash helpers and supportsBC (any thread).
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+// Shared reference to a cached texture. Cheap to copy; the GL texture is deleted when
+// the last handle goes away. getID() is 0 for an empty handle.
+class TextureHandle {
+public:
+    TextureHandle() = default;
+
+    unsigned int getID() const;
+    explicit operator bool() const { return static_cast<bool>(entry); }
+    void reset() { entry.reset(); }
+
+private:
+    friend class TextureCache;
+    struct Entry;
+    explicit TextureHandle(std::shared_ptr<Entry> e) : entry(std::move(e)) {}
+
+    std::shared_ptr<Entry> entry;
+};
+
+// Pixel layout of a texture payload. Values are stored in .pacmdl files; don't renumber.
+enum class TextureFormat : uint32_t {
+    RGBA8 = 0,
+    BC1   = 1, // S3TC DXT1, opaque
+    BC3   = 2, // S3TC DXT5, with alpha
+};
+
+class TextureCache {
+public:
+    struct Desc {
+        uint32_t width = 1;
+        uint32_t height = 1;
+        int      wrapS = 0, wrapT = 0, minF = 0, magF = 0; // GL enums
+        TextureFormat format = TextureFormat::RGBA8;
+        // Mip levels present in the payload, largest first and tightly packed. 0 means
+        // "level 0 only": RGBA8 then gets glGenerateMipmap if minF asks for mips.
+        uint32_t levels = 0;
+    };
+
+    struct Stats {
+        uint32_t uploads = 0;        // distinct textures created
+        uint32_t hits = 0;           // acquires answered by an existing texture
+        uint32_t live = 0;           // textures currently alive
+        uint64_t bytesUploaded = 0;  // VRAM of every upload (incl. mips)
+        uint64_t bytesSaved = 0;     // VRAM the hits would have cost without sharing
+        uint64_t bytesLive = 0;
+    };
+
+    static TextureCache& getInstance();
+
+    // Payload sizes: one level, and every level desc describes.
+    static size_t levelBytes(TextureFormat format, uint32_t width, uint32_t height);
+    static size_t payloadBytes(const Desc& desc);
+
+    // Full chain length down to 1x1.
+    static uint32_t fullMipCount(uint32_t width, uint32_t height);
+
+    // Whether a GL min filter samples mip levels.
+    static bool isMipmapFilter(int minF);
+
+    // Whether BC1/BC3 payloads can go to GL as-is. Probed once on the GL thread by
+    // detectCompressionSupport (call after the context is up); readable from loader threads.
+    static void detectCompressionSupport();
+    static bool supportsBC();
+
+    // Hash used as the cache key. Safe on worker threads, so loaders can hash while staging.
+    static uint64_t hashPixels(const Desc& desc, const void* rgba);
+
+    // Returns the shared texture for these pixels, uploading them on first use.
+    // hash must be hashPixels(desc, rgba), or 0 to have it computed here.
+    // Null pixels give an uninitialised texture that is never shared.
+    TextureHandle acquire(const Desc& desc, const void* rgba, uint64_t hash = 0);
+
+    // 1x1 opaque white, linear, clamped. Shared fallback for missing images.
+    TextureHandle white();
+
+    const Stats& getStats() const { return stats; }
+
+    // Call before the GL context goes away. Handles still alive afterwards (statics)
+    // release without touching GL.
+    void shutdown();
+
+private:
+    TextureCache() = default;
+    ~TextureCache();
+
+    void release(TextureHandle::Entry& e);
+
+    std::unordered_map<uint64_t, std::weak_ptr<TextureHandle::Entry>> entries;
+    Stats stats;
+};
@@ -0,0 +1,210 @@
+// src/engine/render/TextureCompress.cpp
+
+#include "TextureCompress.h"
+
+#include <algorithm>
+#include <cstring>
+
+// stb_dxt implementation is compiled in src/engine/utils/stb_dxt_impl.cpp.
+#include <stb_dxt.h>
+
+namespace pac_texture {
+
+namespace {
+
+uint32_t nextDim(uint32_t v) { return (std::max)(v / 2, 1u); }
+
+// Gathers the 4x4 block at (bx, by), clamping to the edge for partial blocks.
+void fetchBlock(const uint8_t* rgba, uint32_t w, uint32_t h, uint32_t bx, uint32_t by, uint8_t out[64])
+{
+    for (uint32_t y = 0; y < 4; ++y) {
+        const uint32_t sy = (std::min)(by * 4 + y, h - 1);
+        for (uint32_t x = 0; x < 4; ++x) {
+            const uint32_t sx = (std::min)(bx * 4 + x, w - 1);
+            std::memcpy(out + (y * 4 + x) * 4, rgba + ((size_t)sy * w + sx) * 4, 4);
+        }
+    }
+}
+
+void storeBlock(uint8_t* rgba, uint32_t w, uint32_t h, uint32_t bx, uint32_t by, const uint8_t in[64])
+{
+    for (uint32_t y = 0; y < 4 && by * 4 + y < h; ++y) {
+        for (uint32_t x = 0; x < 4 && bx * 4 + x < w; ++x) {
+            std::memcpy(rgba + ((size_t)(by * 4 + y) * w + bx * 4 + x) * 4, in + (y * 4 + x) * 4, 4);
+        }
+    }
+}
+
+void expand565(uint16_t c, uint8_t out[4])
+{
+    const uint32_t r = (c >> 11) & 31, g = (c >> 5) & 63, b = c & 31;
+    out[0] = (uint8_t)((r << 3) | (r >> 2));
+    out[1] = (uint8_t)((g << 2) | (g >> 4));
+    out[2] = (uint8_t)((b << 3) | (b >> 2));
+    out[3] = 255;
+}
+
+// 8-byte colour block. BC3 colour blocks always use the 4-colour palette.
+void decodeColorBlock(const uint8_t* src, bool forceFourColor, uint8_t out[64])
+{
+    const uint16_t c0 = (uint16_t)(src[0] | (src[1] << 8));
+    const uint16_t c1 = (uint16_t)(src[2] | (src[3] << 8));
+
+    uint8_t pal[4][4];
+    expand565(c0, pal[0]);
+    expand565(c1, pal[1]);
+    if (forceFourColor || c0 > c1) {
+        for (int k = 0; k < 3; ++k) {
+            pal[2][k] = (uint8_t)((2 * pal[0][k] + pal[1][k]) / 3);
+            pal[3][k] = (uint8_t)((pal[0][k] + 2 * pal[1][k]) / 3);
+        }
+        pal[2][3] = pal[3][3] = 255;
+    } else {
+        for (int k = 0; k < 3; ++k) pal[2][k] = (uint8_t)((pal[0][k] + pal[1][k]) / 2);
+        pal[2][3] = 255;
+        pal[3][0] = pal[3][1] = pal[3][2] = pal[3][3] = 0;
+    }
+
+    const uint32_t bits = (uint32_t)src[4] | ((uint32_t)src[5] << 8) | ((uint32_t)src[6] << 16) | ((uint32_t)src[7] << 24);
+    for (int i = 0; i < 16; ++i) {
+        std::memcpy(out + i * 4, pal[(bits >> (2 * i)) & 3], 4);
+    }
+}
+
+// 8-byte BC3 alpha block; writes the alpha byte of each texel.
+void decodeAlphaBlock(const uint8_t* src, uint8_t out[64])
+{
+    const uint32_t a0 = src[0], a1 = src[1];
+    uint8_t pal[8] = { (uint8_t)a0, (uint8_t)a1 };
+    if (a0 > a1) {
+        for (uint32_t k = 1; k < 7; ++k) pal[k + 1] = (uint8_t)(((7 - k) * a0 + k * a1) / 7);
+    } else {
+        for (uint32_t k = 1; k < 5; ++k) pal[k + 1] = (uint8_t)(((5 - k) * a0 + k * a1) / 5);
+        pal[6] = 0;
+        pal[7] = 255;
+    }
+
+    uint64_t bits = 0;
+    for (int b = 0; b < 6; ++b) bits |= (uint64_t)src[2 + b] << (8 * b);
+    for (int i = 0; i < 16; ++i) {
+        out[i * 4 + 3] = pal[(bits >> (3 * i)) & 7];
+    }
+}
+
+} // namespace
+
+std::vector<uint8_t> buildMipChainRGBA8(const uint8_t* rgba, uint32_t width, uint32_t height, uint32_t levels)
+{
+    TextureCache::Desc d;
+    d.width = width; d.height = height; d.levels = levels;
+    std::vector<uint8_t> chain(TextureCache::payloadBytes(d));
+
+    std::memcpy(chain.data(), rgba, TextureCache::levelBytes(TextureFormat::RGBA8, width, height));
+
+    // 2x2 box filter from the previous level (edge texel repeated for odd sizes),
+    // matching what glGenerateMipmap produced for these RGBA8 textures.
+    size_t srcOff = 0;
+    uint32_t sw = width, sh = height;
+    for (uint32_t l = 1; l < levels; ++l) {
+        const uint32_t dw = nextDim(sw), dh = nextDim(sh);
+        const size_t dstOff = srcOff + TextureCache::levelBytes(TextureFormat::RGBA8, sw, sh);
+        const uint8_t* src = chain.data() + srcOff;
+        uint8_t* dst = chain.data() + dstOff;
+
+        for (uint32_t y = 0; y < dh; ++y) {
+            const uint32_t y0 = (std::min)(2 * y, sh - 1), y1 = (std::min)(2 * y + 1, sh - 1);
+            for (uint32_t x = 0; x < dw; ++x) {
+                const uint32_t x0 = (std::min)(2 * x, sw - 1), x1 = (std::min)(2 * x + 1, sw - 1);
+                const uint8_t* p00 = src + ((size_t)y0 * sw + x0) * 4;
+                const uint8_t* p01 = src + ((size_t)y0 * sw + x1) * 4;
+                const uint8_t* p10 = src + ((size_t)y1 * sw + x0) * 4;
+                const uint8_t* p11 = src + ((size_t)y1 * sw + x1) * 4;
+                uint8_t* o = dst + ((size_t)y * dw + x) * 4;
+                for (int c = 0; c < 4; ++c) {
+                    o[c] = (uint8_t)((p00[c] + p01[c] + p10[c] + p11[c] + 2) / 4);
+                }
+            }
+        }
+
+        srcOff = dstOff;
+        sw = dw;
+        sh = dh;
+    }
+    return chain;
+}
+
+TextureFormat chooseBlockFormat(const uint8_t* rgba, uint32_t width, uint32_t height)
+{
+    const size_t n = (size_t)width * height;
+    for (size_t i = 0; i < n; ++i) {
+        if (rgba[i * 4 + 3] != 255) return TextureFormat::BC3;
+    }
+    return TextureFormat::BC1;
+}
+
+std::vector<uint8_t> encodeChainBC(const uint8_t* rgbaChain, uint32_t width, uint32_t height,
+                                   uint32_t levels, TextureFormat format)
+{
+    TextureCache::Desc d;
+    d.width = width; d.height = height; d.levels = levels; d.format = format;
+    std::vector<uint8_t> out(TextureCache::payloadBytes(d));
+
+    const int alpha = (format == TextureFormat::BC3) ? 1 : 0;
+    const size_t blockBytes = alpha ? 16 : 8;
+
+    const uint8_t* src = rgbaChain;
+    uint8_t* dst = out.data();
+    uint32_t w = width, h = height;
+    for (uint32_t l = 0; l < levels; ++l) {
+        const uint32_t bw = (w + 3) / 4, bh = (h + 3) / 4;
+        uint8_t block[64];
+        for (uint32_t by = 0; by < bh; ++by) {
+            for (uint32_t bx = 0; bx < bw; ++bx) {
+                fetchBlock(src, w, h, bx, by, block);
+                stb_compress_dxt_block(dst, block, alpha, STB_DXT_HIGHQUAL);
+                dst += blockBytes;
+            }
+        }
+        src += TextureCache::levelBytes(TextureFormat::RGBA8, w, h);
+        w = nextDim(w);
+        h = nextDim(h);
+    }
+    return out;
+}
+
+std::vector<uint8_t> decodeChainBC(const uint8_t* blockChain, uint32_t width, uint32_t height,
+                                   uint32_t levels, TextureFormat format)
+{
+    TextureCache::Desc d;
+    d.width = width; d.height = height; d.levels = levels;
+    std::vector<uint8_t> out(TextureCache::payloadBytes(d));
+
+    const bool bc3 = (format == TextureFormat::BC3);
+
+    const uint8_t* src = blockChain;
+    uint8_t* dst = out.data();
+    uint32_t w = width, h = height;
+    for (uint32_t l = 0; l < levels; ++l) {
+        const uint32_t bw = (w + 3) / 4, bh = (h + 3) / 4;
+        uint8_t block[64];
+        for (uint32_t by = 0; by < bh; ++by) {
+            for (uint32_t bx = 0; bx < bw; ++bx) {
+                if (bc3) {
+                    decodeColorBlock(src + 8, true, block);
+                    decodeAlphaBlock(src, block);
+                    src += 16;
+                } else {
+                    decodeColorBlock(src, false, block);
+                    src += 8;
+                }
+                storeBlock(dst, w, h, bx, by, block);
+            }
+        }
+        dst += TextureCache::levelBytes(TextureFormat::RGBA8, w, h);
+        w = nextDim(w);
+        h = nextDim(h);
+    }
+    return out;
+}
+
+} // namespace pac_texture
@@ -0,0 +1,26 @@
+// src/engine/render/TextureCompress.h
+//
+// CPU-side texture preparation for the .pacmdl cache: box-filtered mip chains and
+// BC1/BC3 (S3TC) block encode/decode. No GL; safe on any thread.
+#pragma once
+
+#include "TextureCache.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace pac_texture {
+
+// RGBA8 chain of `levels` levels (level 0 = rgba), tightly packed largest first.
+std::vector<uint8_t> buildMipChainRGBA8(const uint8_t* rgba, uint32_t width, uint32_t height, uint32_t levels);
+
+// BC3 if any texel is not fully opaque, else BC1.
+TextureFormat chooseBlockFormat(const uint8_t* rgba, uint32_t width, uint32_t height);
+
+// Encodes/decodes every level of a tightly packed chain.
+std::vector<uint8_t> encodeChainBC(const uint8_t* rgbaChain, uint32_t width, uint32_t height,
+                                   uint32_t levels, TextureFormat format);
+std::vector<uint8_t> decodeChainBC(const uint8_t* blockChain, uint32_t width, uint32_t height,
+                                   uint32_t levels, TextureFormat format);
+
+} // namespace pac_texture
@@ -0,0 +1,105 @@
+// src/engine/render/VertexPacking.cpp
+
+#include "VertexPacking.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/packing.hpp>
+
+using pac_model_types::PackedVertex;
+using pac_model_types::Vertex;
+using pac_model_types::VertexLayout;
+using pac_model_types::VertexQuantization;
+
+namespace pac_vertex_packing {
+
+namespace {
+
+uint16_t quantizeUnorm16(float v, float offset, float scale)
+{
+    const float t = (scale > 0.0f) ? (v - offset) / scale : 0.0f;
+    return (uint16_t)std::lround(std::clamp(t, 0.0f, 1.0f) * 65535.0f);
+}
+
+// Rounds to 8 bits while keeping the sum at exactly 255: the rounding leftover goes to
+// the largest weight, so skinned vertices don't shrink toward the origin.
+void quantizeWeights(const float w[4], uint8_t out[4])
+{
+    int sum = 0, largest = 0;
+    for (int i = 0; i < 4; ++i) {
+        out[i] = (uint8_t)std::lround(std::clamp(w[i], 0.0f, 1.0f) * 255.0f);
+        sum += out[i];
+        if (w[i] > w[largest]) largest = i;
+    }
+    out[largest] = (uint8_t)std::clamp((int)out[largest] + (255 - sum), 0, 255);
+}
+
+} // namespace
+
+size_t vertexStride(VertexLayout layout)
+{
+    return (layout == VertexLayout::Packed) ? sizeof(PackedVertex) : sizeof(Vertex);
+}
+
+bool packVertices(const std::vector<Vertex>& in, std::vector<PackedVertex>& out, VertexQuantization& quant)
+{
+    for (const Vertex& v : in) {
+        if ((std::max)({ v.j0, v.j1, v.j2, v.j3 }) > 255) return false;
+    }
+
+    glm::vec3 lo(0.0f), hi(0.0f);
+    if (!in.empty()) {
+        lo = hi = glm::vec3(in[0].px, in[0].py, in[0].pz);
+        for (const Vertex& v : in) {
+            const glm::vec3 p(v.px, v.py, v.pz);
+            lo = glm::min(lo, p);
+            hi = glm::max(hi, p);
+        }
+    }
+
+    for (int a = 0; a < 3; ++a) {
+        quant.offset[a] = lo[a];
+        quant.scale[a]  = hi[a] - lo[a];
+    }
+
+    out.resize(in.size());
+    for (size_t i = 0; i < in.size(); ++i) {
+        const Vertex& v = in[i];
+        PackedVertex& p = out[i];
+
+        p.px = quantizeUnorm16(v.px, quant.offset[0], quant.scale[0]);
+        p.py = quantizeUnorm16(v.py, quant.offset[1], quant.scale[1]);
+        p.pz = quantizeUnorm16(v.pz, quant.offset[2], quant.scale[2]);
+        p.pad = 0;
+
+        p.u = (uint16_t)glm::packHalf1x16(v.u);
+        p.v = (uint16_t)glm::packHalf1x16(v.v);
+
+        p.j[0] = (uint8_t)v.j0; p.j[1] = (uint8_t)v.j1;
+        p.j[2] = (uint8_t)v.j2; p.j[3] = (uint8_t)v.j3;
+
+        const float w[4] = { v.w0, v.w1, v.w2, v.w3 };
+        quantizeWeights(w, p.w);
+    }
+    return true;
+}
+
+float maxPositionError(const std::vector<Vertex>& in, const std::vector<PackedVertex>& packed,
+                       const VertexQuantization& quant)
+{
+    float err = 0.0f;
+    const size_t n = (std::min)(in.size(), packed.size());
+    for (size_t i = 0; i < n; ++i) {
+        const uint16_t q[3] = { packed[i].px, packed[i].py, packed[i].pz };
+        const float    f[3] = { in[i].px, in[i].py, in[i].pz };
+        for (int a = 0; a < 3; ++a) {
+            const float decoded = (float)q[a] / 65535.0f * quant.scale[a] + quant.offset[a];
+            err = (std::max)(err, std::fabs(decoded - f[a]));
+        }
+    }
+    return err;
+}
+
+} // namespace pac_vertex_packing
@@ -0,0 +1,25 @@
+// src/engine/render/VertexPacking.h
+//
+// Full <-> packed vertex conversion (see pac_model_types::PackedVertex). CPU only.
+#pragma once
+
+#include "ModelMeshTypes.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace pac_vertex_packing {
+
+size_t vertexStride(pac_model_types::VertexLayout layout);
+
+// Fails (out untouched) if a joint index doesn't fit in 8 bits.
+bool packVertices(const std::vector<pac_model_types::Vertex>& in,
+                  std::vector<pac_model_types::PackedVertex>& out,
+                  pac_model_types::VertexQuantization& quant);
+
+// Largest position error introduced by packing, in model units.
+float maxPositionError(const std::vector<pac_model_types::Vertex>& in,
+                       const std::vector<pac_model_types::PackedVertex>& packed,
+                       const pac_model_types::VertexQuantization& quant);
+
+} // namespace pac_vertex_packing
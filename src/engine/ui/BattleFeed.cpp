@@ -2,6 +2,7 @@
 
 #include "BattleFeed.h"
 #include "TextRenderer.h"
+#include "../render/GLStateCache.h"
 #include <algorithm>
 #include <glad/glad.h>
 #include <SDL2/SDL_ttf.h>   // NEW: for TTF_FontHeight()
@@ -29,12 +30,14 @@ void BattleFeed::render(int screenW, int screenH) {
     if (!text || lines.empty()) return;
 
     // 2D overlay: disable depth; enable alpha blending while drawing
-    const GLboolean depthWasEnabled = glIsEnabled(GL_DEPTH_TEST);
-    if (depthWasEnabled) glDisable(GL_DEPTH_TEST);
+    auto& gl = GLStateCache::getInstance();
 
-    const GLboolean blendWasEnabled = glIsEnabled(GL_BLEND);
-    if (!blendWasEnabled) glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    const bool depthWasEnabled = gl.isEnabled(GL_DEPTH_TEST);
+    gl.disable(GL_DEPTH_TEST);
+
+    const bool blendWasEnabled = gl.isEnabled(GL_BLEND);
+    gl.enable(GL_BLEND);
+    gl.setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     // Layout constants
     const float padX = 16.f;
@@ -82,8 +85,8 @@ void BattleFeed::render(int screenW, int screenH) {
     }
 
     // Restore GL state
-    if (!blendWasEnabled) glDisable(GL_BLEND);
-    if (depthWasEnabled) glEnable(GL_DEPTH_TEST);
+    gl.setEnabled(GL_BLEND, blendWasEnabled);
+    gl.setEnabled(GL_DEPTH_TEST, depthWasEnabled);
 }
 
 std::vector<std::string> BattleFeed::wrap(const std::string& s, float maxWidth, float scale) {
@@ -8,6 +8,7 @@
 
 #include "../utils/ShaderLibrary.h"
 #include "../utils/Shader.h"
+#include "../render/GLStateCache.h"
 
 void BootLoadingView::init() {
     // Reuse the simple solid-color UI shader you already ship
@@ -32,7 +33,7 @@ void BootLoadingView::ensureQuad() {
     glGenVertexArrays(1, &vao);
     glGenBuffers(1, &vbo);
 
-    glBindVertexArray(vao);
+    GLStateCache::getInstance().bindVertexArray(vao);
     glBindBuffer(GL_ARRAY_BUFFER, vbo);
     glBufferData(GL_ARRAY_BUFFER, sizeof(verts), verts, GL_STATIC_DRAW);
 
@@ -40,7 +41,7 @@ void BootLoadingView::ensureQuad() {
     glEnableVertexAttribArray(0);
 
     glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    GLStateCache::getInstance().bindVertexArray(0);
 }
 
 void BootLoadingView::drawRect(float x, float y, float w, float h, const glm::vec3& rgb,
@@ -54,9 +55,9 @@ void BootLoadingView::drawRect(float x, float y, float w, float h, const glm::ve
     shader->setUniform("u_Model", model);
     shader->setUniform("u_Color", rgb);
 
-    glBindVertexArray(vao);
+    GLStateCache::getInstance().bindVertexArray(vao);
     glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-    glBindVertexArray(0);
+    GLStateCache::getInstance().bindVertexArray(0);
 }
 
 void BootLoadingView::render(float progress01, int screenW, int screenH) {
@@ -64,15 +65,17 @@ void BootLoadingView::render(float progress01, int screenW, int screenH) {
 
     progress01 = std::clamp(progress01, 0.0f, 1.0f);
 
-    const GLboolean depthWasEnabled = glIsEnabled(GL_DEPTH_TEST);
-    if (depthWasEnabled) glDisable(GL_DEPTH_TEST);
+    auto& gl = GLStateCache::getInstance();
+
+    const bool depthWasEnabled = gl.isEnabled(GL_DEPTH_TEST);
+    gl.disable(GL_DEPTH_TEST);
 
     // No transparency required, but harmless if enabled elsewhere
-    const GLboolean blendWasEnabled = glIsEnabled(GL_BLEND);
-    if (!blendWasEnabled) glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    const bool blendWasEnabled = gl.isEnabled(GL_BLEND);
+    gl.enable(GL_BLEND);
+    gl.setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-    glViewport(0, 0, screenW, screenH);
+    gl.setViewport(0, 0, screenW, screenH);
 
     shader->use();
 
@@ -93,6 +96,6 @@ void BootLoadingView::render(float progress01, int screenW, int screenH) {
     // Fill
     drawRect(barX, barY, barW * progress01, barH, glm::vec3(0.75f, 0.75f, 0.78f), projection);
 
-    if (!blendWasEnabled) glDisable(GL_BLEND);
-    if (depthWasEnabled) glEnable(GL_DEPTH_TEST);
+    gl.setEnabled(GL_BLEND, blendWasEnabled);
+    gl.setEnabled(GL_DEPTH_TEST, depthWasEnabled);
 }
@@ -2,6 +2,8 @@
 
 #include "Card.h"
 #include "../utils/Shader.h"
+#include "../render/GLStateCache.h"
+#include "../render/TextureCache.h"
 #include <glad/glad.h>
 #include <glm/gtc/type_ptr.hpp>
 #include <iostream>
@@ -9,7 +11,7 @@
 
 // Static members for the card frame texture remain unchanged.
 std::string Card::framePath = "assets/ui/frame_gold.png";
-unsigned int Card::frameTextureID = 0;
+TextureHandle Card::frameTexture;
 bool Card::frameLoaded = false;
 
 // -----------------------------------------------------------------------------
@@ -33,7 +35,7 @@ namespace {
             glGenBuffers(1, &cardVBO);
             glGenBuffers(1, &cardEBO);
 
-            glBindVertexArray(cardVAO);
+            GLStateCache::getInstance().bindVertexArray(cardVAO);
             glBindBuffer(GL_ARRAY_BUFFER, cardVBO);
             glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
 
@@ -47,7 +49,7 @@ namespace {
             glEnableVertexAttribArray(1);
 
             glBindBuffer(GL_ARRAY_BUFFER, 0);
-            glBindVertexArray(0);
+            GLStateCache::getInstance().bindVertexArray(0);
 
             cardBuffersInitialized = true;
         }
@@ -55,11 +57,11 @@ namespace {
 }
 
 Card::Card(const SDL_Rect& rect, const std::string& imagePath)
-    : rect(rect), imagePath(imagePath), textureID(0), imgWidth(0), imgHeight(0), imgChannels(0)
+    : rect(rect), imagePath(imagePath), imgWidth(0), imgHeight(0), imgChannels(0)
 {
     stbi_set_flip_vertically_on_load(false);
-    textureID = loadTexture(imagePath);
-    if (textureID == 0) {
+    texture = loadTexture(imagePath);
+    if (!texture) {
         std::cerr << "[Card] Failed to load texture: " << imagePath << "\n";
     }
 
@@ -71,57 +73,47 @@ Card::Card(const SDL_Rect& rect, const std::string& imagePath)
 Card::Card(Card&& other) noexcept
     : rect(other.rect), 
       imagePath(std::move(other.imagePath)),
-      textureID(other.textureID), 
+      texture(std::move(other.texture)),
       imgWidth(other.imgWidth),
       imgHeight(other.imgHeight), 
       imgChannels(other.imgChannels),
       cardData(std::move(other.cardData))
 {
-    other.textureID = 0;
 }
 
 Card& Card::operator=(Card&& other) noexcept {
     if (this != &other) {
-        if (textureID != 0) glDeleteTextures(1, &textureID);
         rect = other.rect;
         imagePath = std::move(other.imagePath);
-        textureID = other.textureID;
+        texture = std::move(other.texture);
         imgWidth = other.imgWidth;
         imgHeight = other.imgHeight;
         imgChannels = other.imgChannels;
         cardData = std::move(other.cardData);
-        other.textureID = 0;
     }
     return *this;
 }
 
-Card::~Card() {
-    if (textureID != 0) {
-        glDeleteTextures(1, &textureID);
-    }
-}
-
-unsigned int Card::loadTexture(const std::string& path) {
-    unsigned int texID;
-    glGenTextures(1, &texID);
-    glBindTexture(GL_TEXTURE_2D, texID);
+Card::~Card() = default;
 
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-    unsigned char* data = stbi_load(path.c_str(), &imgWidth, &imgHeight, &imgChannels, 0);
-    if (data) {
-        GLenum format = (imgChannels == 4) ? GL_RGBA : GL_RGB;
-        glTexImage2D(GL_TEXTURE_2D, 0, format, imgWidth, imgHeight, 0, format, GL_UNSIGNED_BYTE, data);
-        glGenerateMipmap(GL_TEXTURE_2D);
-    } else {
+// Shop rerolls keep recreating cards for the same Pokémon; TextureCache hands back the
+// texture already on the GPU instead of uploading a copy per card.
+TextureHandle Card::loadTexture(const std::string& path) {
+    unsigned char* data = stbi_load(path.c_str(), &imgWidth, &imgHeight, &imgChannels, 4);
+    if (!data) {
         std::cerr << "[Card] Failed to load image: " << path << "\n";
-        texID = 0;
+        return {};
     }
+
+    TextureCache::Desc desc;
+    desc.width  = (uint32_t)imgWidth;
+    desc.height = (uint32_t)imgHeight;
+    desc.wrapS = desc.wrapT = GL_CLAMP_TO_EDGE;
+    desc.minF  = desc.magF  = GL_LINEAR;
+
+    TextureHandle tex = TextureCache::getInstance().acquire(desc, data);
     stbi_image_free(data);
-    return texID;
+    return tex;
 }
 
 void Card::draw(Shader* uiShader) const {
@@ -130,9 +122,11 @@ void Card::draw(Shader* uiShader) const {
     // Ensure our static buffers are initialized.
     initCardBuffers();
 
+    auto& gl = GLStateCache::getInstance();
+
     // 🔥 Enable transparency
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    gl.enable(GL_BLEND);
+    gl.setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     // 🔶 Draw Pokémon image first (slightly smaller to fit inside the frame)
     const float padding = 6.0f;
@@ -143,11 +137,11 @@ void Card::draw(Shader* uiShader) const {
     imgModel = glm::scale(imgModel, glm::vec3(imgW, imgH, 1.0f));
 
     glUniformMatrix4fv(glGetUniformLocation(uiShader->getID(), "u_Model"), 1, GL_FALSE, glm::value_ptr(imgModel));
-    glBindTexture(GL_TEXTURE_2D, textureID);
+    gl.bindTexture(0, GL_TEXTURE_2D, texture.getID());
     glUniform1i(glGetUniformLocation(uiShader->getID(), "u_Texture"), 0);
     
     // Use our shared VAO for drawing.
-    glBindVertexArray(cardVAO);
+    gl.bindVertexArray(cardVAO);
     glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
 
     // 🟡 Draw the frame second (overlaid on top)
@@ -155,13 +149,12 @@ void Card::draw(Shader* uiShader) const {
     frameModel = glm::scale(frameModel, glm::vec3(rect.w, rect.h, 1.0f));
 
     glUniformMatrix4fv(glGetUniformLocation(uiShader->getID(), "u_Model"), 1, GL_FALSE, glm::value_ptr(frameModel));
-    glBindTexture(GL_TEXTURE_2D, frameTextureID);
+    gl.bindTexture(0, GL_TEXTURE_2D, frameTexture.getID());
     glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
 
-    glDisable(GL_BLEND);
+    gl.disable(GL_BLEND);
 
-    // Unbind the VAO.
-    glBindVertexArray(0);
+    // The shared VAO stays bound: the next card's bind is filtered out.
 }
 
 bool Card::isPointInside(int x, int y) const {
@@ -171,14 +164,15 @@ bool Card::isPointInside(int x, int y) const {
 
 void Card::loadFrameTexture() {
     int w, h, c;
-    unsigned char* data = stbi_load(framePath.c_str(), &w, &h, &c, 0);
+    unsigned char* data = stbi_load(framePath.c_str(), &w, &h, &c, 4);
     if (data) {
-        glGenTextures(1, &frameTextureID);
-        glBindTexture(GL_TEXTURE_2D, frameTextureID);
-        GLenum format = (c == 4) ? GL_RGBA : GL_RGB;
-        glTexImage2D(GL_TEXTURE_2D, 0, format, w, h, 0, format, GL_UNSIGNED_BYTE, data);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        TextureCache::Desc desc;
+        desc.width  = (uint32_t)w;
+        desc.height = (uint32_t)h;
+        desc.wrapS = desc.wrapT = GL_REPEAT;
+        desc.minF  = desc.magF  = GL_LINEAR;
+
+        frameTexture = TextureCache::getInstance().acquire(desc, data);
         frameLoaded = true;
         stbi_image_free(data);
     } else {
@@ -6,6 +6,8 @@
 #include <glm/glm.hpp>
 #include <string>
 
+#include "../render/TextureCache.h"
+
 class Shader;
 
 enum class CardType {
@@ -46,15 +48,15 @@ public:
 private:
     SDL_Rect rect;
     std::string imagePath;
-    unsigned int textureID;
+    TextureHandle texture;
     int imgWidth, imgHeight, imgChannels;
 
     CardData cardData;
 
     static std::string framePath;
-    static unsigned int frameTextureID;
+    static TextureHandle frameTexture;
     static bool frameLoaded;
 
-    unsigned int loadTexture(const std::string& path);
+    TextureHandle loadTexture(const std::string& path);
     static void loadFrameTexture();
 };
@@ -4,6 +4,7 @@
 #include <glad/glad.h>
 #include <glm/gtc/matrix_transform.hpp>
 #include "../utils/ShaderLibrary.h"
+#include "../render/GLStateCache.h"
 
 void HealthBarRenderer::init() {
     // Initialize shader after OpenGL is ready
@@ -15,15 +16,16 @@ void HealthBarRenderer::init() {
 void HealthBarRenderer::render(const std::vector<HealthBarData>& healthBars) {
     if (!shader) return;
 
-    glDisable(GL_DEPTH_TEST);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    auto& gl = GLStateCache::getInstance();
+    gl.disable(GL_DEPTH_TEST);
+    gl.enable(GL_BLEND);
+    gl.setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     shader->use();
 
     // Get viewport dimensions
     int viewport[4];
-    glGetIntegerv(GL_VIEWPORT, viewport);
+    gl.getViewport(viewport);
     float screenWidth = static_cast<float>(viewport[2]);
     float screenHeight = static_cast<float>(viewport[3]);
     glm::mat4 projection = glm::ortho(0.0f, screenWidth, screenHeight, 0.0f);
@@ -79,8 +81,8 @@ void HealthBarRenderer::render(const std::vector<HealthBarData>& healthBars) {
         renderQuad();
     }
 
-    glDisable(GL_BLEND);
-    glEnable(GL_DEPTH_TEST);
+    gl.disable(GL_BLEND);
+    gl.enable(GL_DEPTH_TEST);
 }
 
 void HealthBarRenderer::renderQuad() {
@@ -89,15 +91,15 @@ void HealthBarRenderer::renderQuad() {
         float vertices[] = {0.0f,0.0f, 1.0f,0.0f, 1.0f,1.0f, 0.0f,1.0f};
         glGenVertexArrays(1, &VAO);
         glGenBuffers(1, &VBO);
-        glBindVertexArray(VAO);
+        GLStateCache::getInstance().bindVertexArray(VAO);
         glBindBuffer(GL_ARRAY_BUFFER, VBO);
         glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
         glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2*sizeof(float), (void*)0);
         glEnableVertexAttribArray(0);
         glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindVertexArray(0);
+        GLStateCache::getInstance().bindVertexArray(0);
     }
-    glBindVertexArray(VAO);
+    // Left bound: consecutive quads skip the rebind.
+    GLStateCache::getInstance().bindVertexArray(VAO);
     glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-    glBindVertexArray(0);
 }
\ No newline at end of file
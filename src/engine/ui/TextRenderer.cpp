@@ -9,6 +9,7 @@
 #include <glm/gtc/type_ptr.hpp>
 
 #include "../utils/Shader.h"
+#include "../render/GLStateCache.h"
 #include "../utils/ShaderLibrary.h"
 
 TextRenderer::TextRenderer(const std::string& fontPath, int fontSize) {
@@ -41,7 +42,7 @@ TextRenderer::TextRenderer(const std::string& fontPath, int fontSize) {
     glGenBuffers(1, &VBO);
     glGenBuffers(1, &EBO);
 
-    glBindVertexArray(VAO);
+    GLStateCache::getInstance().bindVertexArray(VAO);
 
     glBindBuffer(GL_ARRAY_BUFFER, VBO);
     glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_DYNAMIC_DRAW);
@@ -55,18 +56,18 @@ TextRenderer::TextRenderer(const std::string& fontPath, int fontSize) {
     glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
     glEnableVertexAttribArray(1);
 
-    glBindVertexArray(0);
+    GLStateCache::getInstance().bindVertexArray(0);
 }
 
 TextRenderer::~TextRenderer() {
     for (auto& kv : glyphs) {
-        if (kv.second.textureID) glDeleteTextures(1, &kv.second.textureID);
+        if (kv.second.textureID) GLStateCache::getInstance().deleteTextures(1, &kv.second.textureID);
     }
     glyphs.clear();
 
     if (EBO) glDeleteBuffers(1, &EBO);
     if (VBO) glDeleteBuffers(1, &VBO);
-    if (VAO) glDeleteVertexArrays(1, &VAO);
+    if (VAO) GLStateCache::getInstance().deleteVertexArrays(1, &VAO);
 
     if (font) {
         TTF_CloseFont(font);
@@ -85,7 +86,7 @@ unsigned int TextRenderer::createTextureFromSurface(SDL_Surface* surface) {
 
     unsigned int textureID = 0;
     glGenTextures(1, &textureID);
-    glBindTexture(GL_TEXTURE_2D, textureID);
+    GLStateCache::getInstance().bindTexture(GL_TEXTURE_2D, textureID);
 
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
@@ -104,7 +105,7 @@ unsigned int TextRenderer::createTextureFromSurface(SDL_Surface* surface) {
                  GL_UNSIGNED_BYTE,
                  converted->pixels);
 
-    glBindTexture(GL_TEXTURE_2D, 0);
+    GLStateCache::getInstance().bindTexture(GL_TEXTURE_2D, 0);
     SDL_FreeSurface(converted);
 
     return textureID;
@@ -156,8 +157,10 @@ void TextRenderer::renderText(const std::string& text,
 {
     if (!font || !textShader || text.empty()) return;
 
+    auto& gl = GLStateCache::getInstance();
+
     int vp[4] = {0,0,0,0};
-    glGetIntegerv(GL_VIEWPORT, vp);
+    gl.getViewport(vp);
     const float screenW = static_cast<float>(vp[2]);
     const float screenH = static_cast<float>(vp[3]);
 
@@ -169,11 +172,11 @@ void TextRenderer::renderText(const std::string& text,
     if (locGlobalAlpha >= 0) glUniform1f(locGlobalAlpha, alpha);
     if (locTexture >= 0)     glUniform1i(locTexture, 0);
 
-    glActiveTexture(GL_TEXTURE0);
-    glBindVertexArray(VAO);
+    gl.setActiveTexture(0);
+    gl.bindVertexArray(VAO);
 
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    gl.enable(GL_BLEND);
+    gl.setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     float posX = x;
 
@@ -198,15 +201,15 @@ void TextRenderer::renderText(const std::string& text,
         glBindBuffer(GL_ARRAY_BUFFER, VBO);
         glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
 
-        glBindTexture(GL_TEXTURE_2D, g.textureID);
+        gl.bindTexture(GL_TEXTURE_2D, g.textureID);
         glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
 
         posX += (float)g.advance * scale;
     }
 
-    glDisable(GL_BLEND);
-    glBindVertexArray(0);
-    glBindTexture(GL_TEXTURE_2D, 0);
+    gl.disable(GL_BLEND);
+    gl.bindVertexArray(0);
+    gl.bindTexture(GL_TEXTURE_2D, 0);
 }
 
 float TextRenderer::measureTextWidth(const std::string& text, float scale) const {
@@ -2,6 +2,7 @@
 
 #pragma once
 #include <glad/glad.h>
+#include "../render/GLStateCache.h"
 
 // RAII wrapper for a Vertex Array Object
 class VertexArray {
@@ -10,7 +11,7 @@ public:
         glGenVertexArrays(1, &ID);
     }
     ~VertexArray() {
-        glDeleteVertexArrays(1, &ID);
+        GLStateCache::getInstance().deleteVertexArrays(1, &ID);
     }
     // Disable copy semantics
     VertexArray(const VertexArray&) = delete;
@@ -21,7 +22,7 @@ public:
     }
     VertexArray& operator=(VertexArray&& other) noexcept {
         if (this != &other) {
-            glDeleteVertexArrays(1, &ID);
+            GLStateCache::getInstance().deleteVertexArrays(1, &ID);
             ID = other.ID;
             other.ID = 0;
         }
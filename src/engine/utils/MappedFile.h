@@ -0,0 +1,40 @@
+// MappedFile.h
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/*  Read-only memory mapping of a whole file (mmap / MapViewOfFile).
+    The view stays valid until close() or destruction; move-only.   */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return data_ != nullptr; }
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+
+    // Asks the OS to drop the file's cached pages so the next read comes from disk
+    // (benchmarks). POSIX only (fdatasync + posix_fadvise DONTNEED); false elsewhere or
+    // when the file can't be opened.
+    static bool evictFromPageCache(const std::string& path);
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+
+#ifdef _WIN32
+    void* fileHandle_ = nullptr;
+    void* mappingHandle_ = nullptr;
+#endif
+};
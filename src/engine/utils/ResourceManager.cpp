@@ -8,28 +8,229 @@
 // NEW: optional fastgltf parsing/logging (does not change loader behavior)
 #include "../render/FastGltfValidator.h"
 
+#include <stb_image.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <iostream>
 
+struct ModelHandle::Slot {
+    enum class State { Queued, Staging, Staged, Ready, Failed };
+
+    std::string path;
+    std::atomic<State> state{State::Queued};
+
+    // Written by the staging thread, consumed by finishSlot on the main thread.
+    std::unique_ptr<Model> staged;
+    Model::StagedLoad payload;
+
+    // Main thread only.
+    std::shared_ptr<Model> model;
+};
+
+bool ModelHandle::isReady() const {
+    return slot && slot->state.load() == Slot::State::Ready;
+}
+
+bool ModelHandle::isFailed() const {
+    return slot && slot->state.load() == Slot::State::Failed;
+}
+
+std::shared_ptr<Model> ModelHandle::get() const {
+    return isReady() ? slot->model : nullptr;
+}
+
+const std::string& ModelHandle::getPath() const {
+    static const std::string empty;
+    return slot ? slot->path : empty;
+}
+
 ResourceManager& ResourceManager::getInstance() {
     static ResourceManager instance;
     return instance;
 }
 
-std::shared_ptr<Model> ResourceManager::getModel(const std::string& modelPath) {
+ResourceManager::~ResourceManager() {
+    shutdown();
+}
+
+void ResourceManager::startWorkers() {
+    if (!workers.empty() || stopping) return;
+
+    // Leave a core for the main thread; model loads are few, so a small pool is plenty.
+    const unsigned hw = std::max(2u, std::thread::hardware_concurrency());
+    const unsigned count = std::min(4u, hw - 1);
+
+    workers.reserve(count);
+    for (unsigned i = 0; i < count; ++i) {
+        workers.emplace_back([this] { workerMain(); });
+    }
+}
+
+void ResourceManager::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+        jobQueue.clear();
+    }
+    queueCv.notify_all();
+    stagedCv.notify_all();
+
+    for (auto& t : workers) {
+        if (t.joinable()) t.join();
+    }
+    workers.clear();
+}
+
+void ResourceManager::workerMain() {
+    // glTF images are never flipped; don't inherit whatever the UI last set globally.
+    stbi_set_flip_vertically_on_load_thread(0);
+
+    for (;;) {
+        std::shared_ptr<ModelHandle::Slot> slot;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueCv.wait(lock, [this] { return stopping || !jobQueue.empty(); });
+            if (stopping) return;
+            slot = std::move(jobQueue.front());
+            jobQueue.pop_front();
+            slot->state = ModelHandle::Slot::State::Staging;
+        }
+
+        stageSlot(slot);
+
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            stagedQueue.push_back(slot);
+        }
+        stagedCv.notify_all();
+    }
+}
+
+void ResourceManager::stageSlot(const std::shared_ptr<ModelHandle::Slot>& slot) {
+    // Optional fastgltf “shadow parse” for compatibility checking.
+    // Enabled only if you set: PAC_FASTGLTF_VALIDATE=1
+    pac::fastgltf_validator::logSummaryIfEnabled(slot->path);
+
+    slot->staged = Model::stageLoad(slot->path, slot->payload);
+    slot->state = ModelHandle::Slot::State::Staged;
+}
+
+void ResourceManager::finishSlot(const std::shared_ptr<ModelHandle::Slot>& slot) {
+    using State = ModelHandle::Slot::State;
+
+    if (slot->state.load() != State::Staged) return;
+
+    const bool ok = slot->payload.ok;
+    std::shared_ptr<Model> model(std::move(slot->staged));
+    model->finishLoad(slot->payload);
+
+    // A model that failed to parse is still cached (empty, draws nothing) so getModel keeps
+    // returning it as before; handles report it as failed.
+    slot->model = model;
+    loadedModels.emplace(slot->path, model);
+    pendingModels.erase(slot->path);
+
+    slot->state = ok ? State::Ready : State::Failed;
+
+#if defined(PAC_VERBOSE_STARTUP) && PAC_VERBOSE_STARTUP
+    const auto& t = model->getLoadTiming();
+    std::cout << "[ResourceManager] Ready: " << slot->path
+              << " (" << (t.fromCache ? "cache" : "glTF") << ", " << t.totalMs << " ms)\n";
+#endif
+}
+
+ModelHandle ResourceManager::requestModel(const std::string& modelPath) {
+    auto ready = std::make_shared<ModelHandle::Slot>();
+
     auto it = loadedModels.find(modelPath);
     if (it != loadedModels.end()) {
-        return it->second;
+        ready->path = modelPath;
+        ready->model = it->second;
+        ready->state = ModelHandle::Slot::State::Ready;
+        return ModelHandle(std::move(ready));
+    }
+
+    auto pending = pendingModels.find(modelPath);
+    if (pending != pendingModels.end()) {
+        return ModelHandle(pending->second);
     }
 
 #if defined(PAC_VERBOSE_STARTUP) && PAC_VERBOSE_STARTUP
-    std::cout << "[ResourceManager] Loading model: " << modelPath << "\n";
+    std::cout << "[ResourceManager] Streaming model: " << modelPath << "\n";
 #endif
 
-    // Optional fastgltf “shadow parse” for compatibility checking.
-    // Enabled only if you set: PAC_FASTGLTF_VALIDATE=1
-    pac::fastgltf_validator::logSummaryIfEnabled(modelPath);
+    ready->path = modelPath;
+    pendingModels.emplace(modelPath, ready);
+
+    startWorkers();
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        jobQueue.push_back(ready);
+    }
+    queueCv.notify_one();
+
+    return ModelHandle(std::move(ready));
+}
+
+int ResourceManager::pumpUploads(double budgetMs) {
+    using clock = std::chrono::steady_clock;
+    const auto t0 = clock::now();
+
+    int finished = 0;
+    for (;;) {
+        std::shared_ptr<ModelHandle::Slot> slot;
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            if (stagedQueue.empty()) break;
+            slot = std::move(stagedQueue.front());
+            stagedQueue.pop_front();
+        }
+
+        finishSlot(slot);
+        ++finished;
+
+        const double spent = std::chrono::duration<double, std::milli>(clock::now() - t0).count();
+        if (spent >= budgetMs) break;
+    }
+    return finished;
+}
+
+size_t ResourceManager::getPendingCount() const {
+    return pendingModels.size();
+}
+
+std::shared_ptr<Model> ResourceManager::getModel(const std::string& modelPath) {
+    using State = ModelHandle::Slot::State;
+
+    ModelHandle handle = requestModel(modelPath);
+    if (handle.isReady()) return handle.get();
+
+    auto slot = handle.slot;
+
+    // Still queued: take it back and stage it here instead of waiting for a worker.
+    bool stageHere = false;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        auto q = std::find(jobQueue.begin(), jobQueue.end(), slot);
+        if (q != jobQueue.end()) {
+            jobQueue.erase(q);
+            slot->state = State::Staging;
+            stageHere = true;
+        }
+    }
+
+    if (stageHere) {
+        stageSlot(slot);
+    } else {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        stagedCv.wait(lock, [&] { return stopping || slot->state.load() != State::Staging; });
+
+        auto q = std::find(stagedQueue.begin(), stagedQueue.end(), slot);
+        if (q != stagedQueue.end()) stagedQueue.erase(q);
+    }
 
-    auto modelPtr = std::make_shared<Model>(modelPath);
-    loadedModels.emplace(modelPath, modelPtr);
-    return modelPtr;
+    finishSlot(slot);
+    return slot->model;
 }
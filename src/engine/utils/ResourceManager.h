@@ -4,21 +4,78 @@
 #include <string>
 #include <unordered_map>
 #include <memory>
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 class Model; // Forward declaration
 
+// Handle to a model that may still be streaming in. Cheap to copy; get() returns nullptr
+// until ResourceManager::pumpUploads has finished the model on the GL thread.
+class ModelHandle {
+public:
+    ModelHandle() = default;
+
+    bool valid() const { return static_cast<bool>(slot); }
+    bool isReady() const;
+    bool isFailed() const;
+    std::shared_ptr<Model> get() const;
+    const std::string& getPath() const;
+
+private:
+    friend class ResourceManager;
+    struct Slot;
+    explicit ModelHandle(std::shared_ptr<Slot> s) : slot(std::move(s)) {}
+
+    std::shared_ptr<Slot> slot;
+};
+
 // This class centralizes loading & caching of models (GLTF, etc.)
 class ResourceManager {
 public:
     // Singleton pattern
     static ResourceManager& getInstance();
 
-    // Loads (if not already loaded) and returns a shared pointer to the Model
+    // Loads (if not already loaded) and returns a shared pointer to the Model.
+    // Blocks: a model already streaming is finished right away on this thread.
     std::shared_ptr<Model> getModel(const std::string& modelPath);
 
+    // Returns immediately. Cache read / glTF parse / texture decode run on worker threads,
+    // the GL upload happens in pumpUploads on the main thread.
+    ModelHandle requestModel(const std::string& modelPath);
+
+    // Main thread, once per frame: finishes staged models until budgetMs is spent
+    // (always at least one, so progress never stalls). Returns how many were finished.
+    int pumpUploads(double budgetMs);
+
+    // Requests neither finished nor failed yet.
+    size_t getPendingCount() const;
+
+    // Stops the workers (pending requests are dropped). Call before the GL context goes away.
+    void shutdown();
+
 private:
     ResourceManager() = default; // private constructor for Singleton
+    ~ResourceManager();
+
+    void startWorkers();
+    void workerMain();
+    void stageSlot(const std::shared_ptr<ModelHandle::Slot>& slot);
+    void finishSlot(const std::shared_ptr<ModelHandle::Slot>& slot);
 
     // key: filepath, value: shared_ptr to the loaded Model
     std::unordered_map<std::string, std::shared_ptr<Model>> loadedModels;
-};
\ No newline at end of file
+
+    // key: filepath, value: in-flight request (removed once finished)
+    std::unordered_map<std::string, std::shared_ptr<ModelHandle::Slot>> pendingModels;
+
+    mutable std::mutex queueMutex;
+    std::condition_variable queueCv;  // workers: new job or stop
+    std::condition_variable stagedCv; // getModel: a job finished staging
+    std::deque<std::shared_ptr<ModelHandle::Slot>> jobQueue;
+    std::deque<std::shared_ptr<ModelHandle::Slot>> stagedQueue;
+    std::vector<std::thread> workers;
+    bool stopping = false;
+};
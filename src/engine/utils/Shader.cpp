@@ -1,6 +1,7 @@
 // Shader.cpp
 
 #include "Shader.h"
+#include "../render/GLStateCache.h"
 #include <fstream>
 #include <sstream>
 #include <iostream>
@@ -144,17 +145,54 @@ Shader::Shader(const char* vertexPath, const char* fragmentPath) {
         glGetProgramInfoLog(ID, 512, nullptr, infoLog);
         std::cerr << "[Shader] Program linking error: " << infoLog << "\n";
     }
+    linked = success != 0;
 
     glDeleteShader(vertexShader);
     glDeleteShader(fragmentShader);
 }
 
+Shader::Shader(const char* vertexPath, const char* geometryPath,
+               const std::vector<const char*>& feedbackVaryings) {
+    std::string vertexCode = loadSource(vertexPath);
+    GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexCode.c_str());
+    if (vertexShader == 0) {
+        std::cerr << "[Shader] Failed to compile vertex shader from: " << vertexPath << "\n";
+    }
+    GLuint geometryShader = 0;
+    if (geometryPath) {
+        std::string geometryCode = loadSource(geometryPath);
+        geometryShader = compileShader(GL_GEOMETRY_SHADER, geometryCode.c_str());
+        if (geometryShader == 0) {
+            std::cerr << "[Shader] Failed to compile geometry shader from: " << geometryPath << "\n";
+        }
+    }
+
+    ID = glCreateProgram();
+    glAttachShader(ID, vertexShader);
+    if (geometryShader) glAttachShader(ID, geometryShader);
+    glTransformFeedbackVaryings(ID, (GLsizei)feedbackVaryings.size(), feedbackVaryings.data(),
+                                GL_INTERLEAVED_ATTRIBS);
+    glLinkProgram(ID);
+
+    GLint success;
+    glGetProgramiv(ID, GL_LINK_STATUS, &success);
+    if (!success) {
+        char infoLog[512];
+        glGetProgramInfoLog(ID, 512, nullptr, infoLog);
+        std::cerr << "[Shader] Program linking error: " << infoLog << "\n";
+    }
+    linked = success != 0 && vertexShader != 0 && (!geometryPath || geometryShader != 0);
+
+    glDeleteShader(vertexShader);
+    if (geometryShader) glDeleteShader(geometryShader);
+}
+
 Shader::~Shader() {
-    glDeleteProgram(ID);
+    GLStateCache::getInstance().deleteProgram(ID);
 }
 
 void Shader::use() const {
-    glUseProgram(ID);
+    GLStateCache::getInstance().useProgram(ID);
 }
 
 std::string Shader::loadSource(const char* filePath) {
@@ -175,7 +213,8 @@ GLuint Shader::compileShader(GLenum type, const char* source) {
     if (!success) {
         char infoLog[512];
         glGetShaderInfoLog(shader, 512, nullptr, infoLog);
-        std::cerr << "[Shader] " << (type == GL_VERTEX_SHADER ? "Vertex" : "Fragment")
+        std::cerr << "[Shader] " << (type == GL_VERTEX_SHADER   ? "Vertex"
+                                   : type == GL_GEOMETRY_SHADER ? "Geometry" : "Fragment")
                   << " shader compilation error: " << infoLog << "\n";
         glDeleteShader(shader);
         return 0;
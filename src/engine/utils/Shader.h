@@ -6,10 +6,15 @@
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 #include <unordered_map>
+#include <vector>
 
 class Shader {
 public:
     Shader(const char* vertexPath, const char* fragmentPath);
+    // Transform feedback program: vertex (+ optional geometry) shader, no fragment stage,
+    // capturing `feedbackVaryings` interleaved into one buffer. Use with GL_RASTERIZER_DISCARD.
+    Shader(const char* vertexPath, const char* geometryPath,
+           const std::vector<const char*>& feedbackVaryings);
     ~Shader();
 
     void use() const;
@@ -22,8 +27,11 @@ public:
     void setUniform(const std::string &name, const glm::vec3 &vec) const;
     void setUniform(const std::string &name, const glm::vec2 &vec) const;   // NEW
 
+    bool isLinked() const { return linked; }
+
 private:
     GLuint ID;
+    bool linked = false;
     std::string loadSource(const char* filePath);
     GLuint compileShader(GLenum type, const char* source);
 
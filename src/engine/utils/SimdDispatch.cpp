@@ -0,0 +1,77 @@
+// SimdDispatch.cpp
+
+#include "SimdDispatch.h"
+
+#if PAC_SIMD_X86 && defined(_MSC_VER) && !defined(__clang__)
+    #include <immintrin.h>
+    #include <intrin.h>
+#endif
+
+namespace pac_simd {
+
+namespace {
+
+#if PAC_SIMD_X86
+
+bool cpuHasAVX2FMA()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int regs[4] = {0, 0, 0, 0};
+    __cpuid(regs, 0);
+    if (regs[0] < 7) return false;
+
+    __cpuid(regs, 1);
+    const bool osxsave = (regs[2] & (1 << 27)) != 0;
+    const bool fma     = (regs[2] & (1 << 12)) != 0;
+    const bool avx     = (regs[2] & (1 << 28)) != 0;
+    if (!osxsave || !fma || !avx) return false;
+
+    // OS must save YMM state.
+    if ((_xgetbv(0) & 0x6) != 0x6) return false;
+
+    __cpuidex(regs, 7, 0);
+    return (regs[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+}
+
+#endif // PAC_SIMD_X86
+
+} // namespace
+
+bool isPathSupported(Path path)
+{
+    switch (path) {
+        case Path::Scalar: return true;
+#if PAC_SIMD_X86
+        case Path::SSE:    return true; // compiled in only where SSE2 is baseline
+        case Path::AVX2: {
+            static const bool has = cpuHasAVX2FMA();
+            return has;
+        }
+#endif
+        default: return false;
+    }
+}
+
+Path bestAvailablePath()
+{
+    static const Path best = isPathSupported(Path::AVX2) ? Path::AVX2
+                           : isPathSupported(Path::SSE)  ? Path::SSE
+                                                         : Path::Scalar;
+    return best;
+}
+
+const char* pathName(Path path)
+{
+    switch (path) {
+        case Path::Scalar: return "scalar";
+        case Path::SSE:    return "sse";
+        case Path::AVX2:   return "avx2";
+    }
+    return "?";
+}
+
+} // namespace pac_simd
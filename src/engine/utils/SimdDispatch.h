@@ -0,0 +1,62 @@
+// SimdDispatch.h
+//
+// Shared CPU dispatch for the SIMD kernels (joint palettes, particle integration): the
+// path enum, runtime detection, and 32-byte aligned storage for the streams they read.
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+// SIMD paths need SSE2 in the baseline ISA: always true on x86-64, only with
+// -msse2 / /arch:SSE2 on 32-bit x86. Everything else gets the scalar path.
+// Kernel files include <immintrin.h> themselves when PAC_SIMD_X86 is set.
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define PAC_SIMD_X86 1
+#else
+    #define PAC_SIMD_X86 0
+#endif
+
+// AVX2 kernels are compiled per-function so the rest of the engine keeps its baseline ISA.
+#if PAC_SIMD_X86 && (defined(__GNUC__) || defined(__clang__))
+    #define PAC_SIMD_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#else
+    #define PAC_SIMD_TARGET_AVX2
+#endif
+
+namespace pac_simd {
+
+enum class Path { Scalar, SSE, AVX2 };
+
+// Fastest path supported by this CPU (cached after the first call). AVX2 also requires
+// FMA and OS support for YMM state.
+Path bestAvailablePath();
+bool isPathSupported(Path path);
+const char* pathName(Path path);
+
+// Aligned storage for kernel inputs/outputs (32 bytes: one AVX2 register, and a mat4
+// never straddles more cache lines than it has to).
+template <typename T, std::size_t Alignment = 32>
+struct AlignedAllocator {
+    using value_type = T;
+
+    AlignedAllocator() noexcept = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    template <typename U>
+    struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+    }
+    void deallocate(T* p, std::size_t) noexcept {
+        ::operator delete(p, std::align_val_t(Alignment));
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept { return false; }
+};
+
+} // namespace pac_simd
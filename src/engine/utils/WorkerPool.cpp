@@ -0,0 +1,134 @@
+// WorkerPool.cpp
+
+#include "WorkerPool.h"
+
+#include <algorithm>
+#include <atomic>
+
+struct WorkerPool::Loop {
+    std::function<void(size_t)> fn;
+    size_t count = 0;
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> done{0};
+
+    std::mutex doneMutex;
+    std::condition_variable doneCv; // caller: last index finished
+};
+
+static thread_local bool t_isPoolWorker = false;
+
+WorkerPool& WorkerPool::getInstance() {
+    static WorkerPool instance;
+    return instance;
+}
+
+WorkerPool::~WorkerPool() {
+    shutdown();
+}
+
+void WorkerPool::setThreadCount(unsigned count) {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    threadCount = count;
+    threadCountSet = true;
+}
+
+unsigned WorkerPool::getThreadCount() const {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    if (threadCountSet) return threadCount;
+    return std::max(1u, std::thread::hardware_concurrency()) - 1;
+}
+
+bool WorkerPool::isWorkerThread() {
+    return t_isPoolWorker;
+}
+
+void WorkerPool::startWorkers() {
+    // queueMutex held by the caller.
+    if (!workers.empty() || stopping) return;
+
+    const unsigned count = threadCountSet ? threadCount
+                                          : std::max(1u, std::thread::hardware_concurrency()) - 1;
+    workers.reserve(count);
+    for (unsigned i = 0; i < count; ++i) {
+        workers.emplace_back([this] { workerMain(); });
+    }
+}
+
+void WorkerPool::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueCv.notify_all();
+
+    // Loops in flight still finish: their callers work through whatever is left.
+    for (auto& t : workers) {
+        if (t.joinable()) t.join();
+    }
+    workers.clear();
+
+    std::lock_guard<std::mutex> lock(queueMutex);
+    loopQueue.clear();
+    stopping = false;
+}
+
+void WorkerPool::runLoop(Loop& loop) {
+    for (size_t i = loop.next.fetch_add(1); i < loop.count; i = loop.next.fetch_add(1)) {
+        loop.fn(i);
+        if (loop.done.fetch_add(1) + 1 == loop.count) {
+            std::lock_guard<std::mutex> lock(loop.doneMutex);
+            loop.doneCv.notify_all();
+        }
+    }
+}
+
+void WorkerPool::workerMain() {
+    t_isPoolWorker = true;
+
+    for (;;) {
+        std::shared_ptr<Loop> loop;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueCv.wait(lock, [this] { return stopping || !loopQueue.empty(); });
+            if (stopping) return;
+            loop = loopQueue.front();
+        }
+
+        runLoop(*loop);
+
+        // Every index is claimed; stop handing this loop out.
+        std::lock_guard<std::mutex> lock(queueMutex);
+        if (!loopQueue.empty() && loopQueue.front() == loop) loopQueue.pop_front();
+    }
+}
+
+void WorkerPool::parallelFor(size_t count, const std::function<void(size_t)>& fn) {
+    if (count == 0) return;
+
+    auto loop = std::make_shared<Loop>();
+    loop->fn = fn;
+    loop->count = count;
+
+    bool queued = false;
+    if (count > 1) {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        startWorkers();
+        if (!workers.empty() && !stopping) {
+            loopQueue.push_back(loop);
+            queued = true;
+        }
+    }
+    if (queued) queueCv.notify_all();
+
+    runLoop(*loop);
+
+    if (queued) {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            auto it = std::find(loopQueue.begin(), loopQueue.end(), loop);
+            if (it != loopQueue.end()) loopQueue.erase(it);
+        }
+        std::unique_lock<std::mutex> lock(loop->doneMutex);
+        loop->doneCv.wait(lock, [&] { return loop->done.load() == loop->count; });
+    }
+}
@@ -0,0 +1,54 @@
+// WorkerPool.h
+
+#pragma once
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// Process-wide helper threads for data-parallel loops inside a load (image decode).
+// The threads are shared by every caller, so nested parallelism (ResourceManager
+// workers, pac_cook jobs) adds callers, not threads. The calling thread always works on
+// its own loop too, so a busy or empty pool only costs speed, never progress.
+class WorkerPool {
+public:
+    static WorkerPool& getInstance();
+
+    // Helper threads (not counting callers). Default: hardware_concurrency - 1. Takes
+    // effect when the pool next starts: call before the first parallelFor (or after
+    // shutdown). 0 runs every loop on its caller.
+    void setThreadCount(unsigned count);
+    unsigned getThreadCount() const;
+
+    // Runs fn(i) for every i in [0, count) on the caller and the pool; returns when all
+    // are done. fn must be safe to call concurrently for different i.
+    void parallelFor(size_t count, const std::function<void(size_t)>& fn);
+
+    // True on the pool's own threads (not on callers helping with their loop).
+    static bool isWorkerThread();
+
+    // Joins the threads; the next parallelFor starts them again.
+    void shutdown();
+
+private:
+    struct Loop;
+
+    WorkerPool() = default;
+    ~WorkerPool();
+
+    void startWorkers();
+    void workerMain();
+    static void runLoop(Loop& loop);
+
+    mutable std::mutex queueMutex;
+    std::condition_variable queueCv; // workers: new loop or stop
+    std::deque<std::shared_ptr<Loop>> loopQueue;
+    std::vector<std::thread> workers;
+    unsigned threadCount = 0;
+    bool threadCountSet = false;
+    bool stopping = false;
+};
@@ -0,0 +1,3 @@
+// stb_dxt_impl.cpp
+#define STB_DXT_IMPLEMENTATION
+#include <stb_dxt.h>
@@ -0,0 +1,189 @@
+// src/engine/vfx/ParticleGpuSim.cpp
+
+#include "ParticleGpuSim.h"
+
+#include "engine/utils/Shader.h"
+#include "engine/render/GLStateCache.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+
+#include <glad/glad.h>
+
+static_assert(sizeof(ParticleGpuSim::State) == 48, "State must match the interleaved feedback varyings");
+
+static constexpr const char* kSimVertPath = "assets/shaders/vfx/sim/particle_sim.vert";
+static constexpr const char* kSimGeomPath = "assets/shaders/vfx/sim/particle_sim.geom";
+
+// Every stepper uses the same program; built on first use.
+static std::shared_ptr<Shader> acquireSimProgram() {
+    static std::weak_ptr<Shader> shared;
+    if (auto p = shared.lock()) return p;
+
+    auto p = std::make_shared<Shader>(kSimVertPath, kSimGeomPath, std::vector<const char*>{
+        "oPos", "oDeathTime", "oVel", "oMaxLife", "oSizePx", "oSeed", "oAge01", "oColor"
+    });
+    if (!p->isLinked()) {
+        std::cerr << "[ParticleGpuSim] Transform feedback program unavailable; staying on the CPU\n";
+        return nullptr;
+    }
+    shared = p;
+    return p;
+}
+
+ParticleGpuSim::~ParticleGpuSim() {
+    shutdown();
+}
+
+bool ParticleGpuSim::init(uint32_t maxParticles) {
+    shutdown();
+
+    program = acquireSimProgram();
+    if (!program) return false;
+
+    const GLuint prog = program->getID();
+    locDt      = glGetUniformLocation(prog, "u_Dt");
+    locTime    = glGetUniformLocation(prog, "u_Time");
+    locAccel   = glGetUniformLocation(prog, "u_Accel");
+    locDamping = glGetUniformLocation(prog, "u_Damping");
+
+    capacity = std::max<uint32_t>(maxParticles, 1);
+    const GLsizeiptr bytes = (GLsizeiptr)capacity * (GLsizeiptr)sizeof(State);
+
+    auto& gl = GLStateCache::getInstance();
+    glGenBuffers(2, buffers);
+    glGenVertexArrays(2, simVaos);
+    glGenVertexArrays(2, renderVaos);
+
+    constexpr GLsizei stride = sizeof(State);
+    for (int i = 0; i < 2; ++i) {
+        glBindBuffer(GL_ARRAY_BUFFER, buffers[i]);
+        glBufferData(GL_ARRAY_BUFFER, bytes, nullptr, GL_DYNAMIC_COPY);
+
+        gl.bindVertexArray(simVaos[i]);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(State, pos));
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(1, 1, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(State, deathTime));
+        glEnableVertexAttribArray(2);
+        glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(State, vel));
+        glEnableVertexAttribArray(3);
+        glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(State, maxLife));
+        glEnableVertexAttribArray(4);
+        glVertexAttribPointer(4, 1, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(State, sizePx));
+        glEnableVertexAttribArray(5);
+        glVertexAttribPointer(5, 1, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(State, seed));
+        glEnableVertexAttribArray(7);
+        glVertexAttribIPointer(7, 1, GL_UNSIGNED_INT, stride, (void*)offsetof(State, color));
+
+        // Same attribute locations as ParticleSystem's vertex ring.
+        gl.bindVertexArray(renderVaos[i]);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(State, pos));
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(1, 1, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(State, age01));
+        glEnableVertexAttribArray(2);
+        glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(State, sizePx));
+        glEnableVertexAttribArray(3);
+        glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(State, seed));
+        glEnableVertexAttribArray(4);
+        glVertexAttribPointer(4, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, (void*)offsetof(State, color));
+    }
+    gl.bindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    deathTimes.reserve(capacity);
+    stagedState.reserve(std::min<uint32_t>(capacity, 1024));
+    current = 0;
+    ready = true;
+    return true;
+}
+
+void ParticleGpuSim::shutdown() {
+    if (!ready) return;
+
+    GLStateCache::getInstance().deleteVertexArrays(2, simVaos);
+    GLStateCache::getInstance().deleteVertexArrays(2, renderVaos);
+    glDeleteBuffers(2, buffers);
+    for (int i = 0; i < 2; ++i) buffers[i] = simVaos[i] = renderVaos[i] = 0;
+
+    program.reset();
+    deathTimes.clear();
+    stagedState.clear();
+    capacity = 0;
+    ready = false;
+}
+
+bool ParticleGpuSim::emit(const State& s) {
+    if (!ready || deathTimes.size() >= capacity) return false;
+    stagedState.push_back(s);
+    deathTimes.push_back(s.deathTime);
+    return true;
+}
+
+void ParticleGpuSim::flushStaged() {
+    if (stagedState.empty()) return;
+
+    const size_t live = deathTimes.size() - stagedState.size();
+    glBindBuffer(GL_ARRAY_BUFFER, buffers[current]);
+    glBufferSubData(GL_ARRAY_BUFFER,
+                    (GLintptr)(live * sizeof(State)),
+                    (GLsizeiptr)(stagedState.size() * sizeof(State)),
+                    stagedState.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    stagedState.clear();
+}
+
+void ParticleGpuSim::step(float dt, float timeSec, const glm::vec3& accel, float damping) {
+    if (!ready) return;
+    flushStaged();
+    if (deathTimes.empty()) return;
+
+    auto& gl = GLStateCache::getInstance();
+    const int next = 1 - current;
+
+    program->use();
+    glUniform1f(locDt, dt);
+    glUniform1f(locTime, timeSec);
+    glUniform3f(locAccel, accel.x, accel.y, accel.z);
+    glUniform1f(locDamping, damping);
+
+    // Not one of the caps GLStateCache shadows; always left disabled.
+    glEnable(GL_RASTERIZER_DISCARD);
+    gl.bindVertexArray(simVaos[current]);
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, buffers[next]);
+
+    glBeginTransformFeedback(GL_POINTS);
+    glDrawArrays(GL_POINTS, 0, (GLsizei)deathTimes.size());
+    glEndTransformFeedback();
+
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, 0);
+    gl.bindVertexArray(0);
+    glDisable(GL_RASTERIZER_DISCARD);
+
+    current = next;
+
+    // The geometry shader's test, on the same floats: keeps count and order in step.
+    deathTimes.erase(std::remove_if(deathTimes.begin(), deathTimes.end(),
+                                    [timeSec](float t) { return !(t > timeSec); }),
+                     deathTimes.end());
+}
+
+unsigned int ParticleGpuSim::getRenderVao() {
+    if (!ready) return 0;
+    flushStaged();
+    return renderVaos[current];
+}
+
+void ParticleGpuSim::readBack(std::vector<State>& out) {
+    out.clear();
+    if (!ready) return;
+    flushStaged();
+
+    out.resize(deathTimes.size());
+    if (out.empty()) return;
+    glBindBuffer(GL_ARRAY_BUFFER, buffers[current]);
+    glGetBufferSubData(GL_ARRAY_BUFFER, 0, (GLsizeiptr)(out.size() * sizeof(State)), out.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
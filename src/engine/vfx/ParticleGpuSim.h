@@ -0,0 +1,87 @@
+// src/engine/vfx/ParticleGpuSim.h
+//
+// GPU particle backend for ParticleSystem (SimBackend::GPU): particle state lives in two
+// GL buffers and each step is one transform feedback pass (GL 3.3) from one into the
+// other. The vertex shader integrates exactly like the CPU kernels; the geometry shader
+// drops dead particles and keeps the survivors in order.
+//
+// Particles store their absolute death time. The CPU keeps just those times and repeats
+// the geometry shader's compaction with the same float comparison, so the live count
+// (for drawing and appending) is exact without reading anything back.
+//
+// New particles are staged on the CPU and appended with one glBufferSubData before the
+// next step or draw. Needs a current GL context for everything except getCount().
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+class Shader;
+
+class ParticleGpuSim {
+public:
+    // One particle in the state buffers; matches the captured varyings of particle_sim.geom.
+    struct State {
+        glm::vec3 pos;
+        float deathTime;  // sim clock at which it dies
+        glm::vec3 vel;
+        float maxLife;
+        float sizePx;
+        float seed;
+        float age01;      // written by each step, read by the render shaders
+        uint32_t color;   // RGBA8
+    };
+
+public:
+    ParticleGpuSim() = default;
+    ~ParticleGpuSim();
+
+    ParticleGpuSim(const ParticleGpuSim&) = delete;
+    ParticleGpuSim& operator=(const ParticleGpuSim&) = delete;
+
+    // Creates the buffers and VAOs (dropping any live particles). False when the
+    // transform feedback program didn't build; the caller should stay on the CPU.
+    bool init(uint32_t capacity);
+    void shutdown();
+    bool isReady() const { return ready; }
+
+    // False (nothing staged) when the buffers are full.
+    bool emit(const State& s);
+
+    // timeSec is the sim clock after this step; damping is pow(dampingBase, dt).
+    void step(float dt, float timeSec, const glm::vec3& accel, float damping);
+
+    uint32_t getCount() const { return (uint32_t)deathTimes.size(); }
+    uint32_t getCapacity() const { return capacity; }
+
+    // VAO feeding the current state to the particle render attributes 0-4 (same layout as
+    // ParticleSystem's vertex ring). Appends staged particles first.
+    unsigned int getRenderVao();
+
+    // Copies the live state to the CPU (stalls; for checks, not per frame).
+    void readBack(std::vector<State>& out);
+
+private:
+    void flushStaged();
+
+private:
+    bool ready = false;
+    uint32_t capacity = 0;
+
+    std::shared_ptr<Shader> program;
+    int locDt = -1, locTime = -1, locAccel = -1, locDamping = -1;
+
+    // Ping-pong: state[current] holds the live particles.
+    unsigned int buffers[2] = {};
+    unsigned int simVaos[2] = {};    // transform feedback input
+    unsigned int renderVaos[2] = {}; // draw attributes
+    int current = 0;
+
+    // deathTimes[i] belongs to particle i of state[current]; the last `staged` entries
+    // are still only in stagedState.
+    std::vector<float> deathTimes;
+    std::vector<State> stagedState;
+};
@@ -0,0 +1,96 @@
+// src/engine/vfx/ParticleKernels.cpp
+
+#include "ParticleKernels.h"
+
+#if PAC_SIMD_X86
+    #include <immintrin.h>
+#endif
+
+namespace pac_particle_kernels {
+
+namespace {
+
+void integrateScalar(const Streams& s, std::size_t count, const glm::vec3& a, float damping, float dt)
+{
+    for (std::size_t i = 0; i < count; ++i) {
+        s.vx[i] = (s.vx[i] + a.x * dt) * damping;
+        s.vy[i] = (s.vy[i] + a.y * dt) * damping;
+        s.vz[i] = (s.vz[i] + a.z * dt) * damping;
+        s.px[i] += s.vx[i] * dt;
+        s.py[i] += s.vy[i] * dt;
+        s.pz[i] += s.vz[i] * dt;
+        s.life[i] -= dt;
+    }
+}
+
+#if PAC_SIMD_X86
+
+void integrateSSE(const Streams& s, std::size_t count, const glm::vec3& a, float damping, float dt)
+{
+    const __m128 vdt   = _mm_set1_ps(dt);
+    const __m128 vdamp = _mm_set1_ps(damping);
+    const __m128 adx   = _mm_set1_ps(a.x * dt);
+    const __m128 ady   = _mm_set1_ps(a.y * dt);
+    const __m128 adz   = _mm_set1_ps(a.z * dt);
+
+    auto axis = [&](float* p, float* v, std::size_t i, __m128 ad) {
+        const __m128 vel = _mm_mul_ps(_mm_add_ps(_mm_load_ps(v + i), ad), vdamp);
+        _mm_store_ps(v + i, vel);
+        _mm_store_ps(p + i, _mm_add_ps(_mm_load_ps(p + i), _mm_mul_ps(vel, vdt)));
+    };
+
+    for (std::size_t i = 0; i < count; i += 4) {
+        axis(s.px, s.vx, i, adx);
+        axis(s.py, s.vy, i, ady);
+        axis(s.pz, s.vz, i, adz);
+        _mm_store_ps(s.life + i, _mm_sub_ps(_mm_load_ps(s.life + i), vdt));
+    }
+}
+
+PAC_SIMD_TARGET_AVX2
+void integrateAVX2(const Streams& s, std::size_t count, const glm::vec3& a, float damping, float dt)
+{
+    const __m256 vdt   = _mm256_set1_ps(dt);
+    const __m256 vdamp = _mm256_set1_ps(damping);
+    const __m256 adx   = _mm256_set1_ps(a.x * dt);
+    const __m256 ady   = _mm256_set1_ps(a.y * dt);
+    const __m256 adz   = _mm256_set1_ps(a.z * dt);
+
+    for (std::size_t i = 0; i < count; i += 8) {
+        const __m256 vx = _mm256_mul_ps(_mm256_add_ps(_mm256_load_ps(s.vx + i), adx), vdamp);
+        const __m256 vy = _mm256_mul_ps(_mm256_add_ps(_mm256_load_ps(s.vy + i), ady), vdamp);
+        const __m256 vz = _mm256_mul_ps(_mm256_add_ps(_mm256_load_ps(s.vz + i), adz), vdamp);
+        _mm256_store_ps(s.vx + i, vx);
+        _mm256_store_ps(s.vy + i, vy);
+        _mm256_store_ps(s.vz + i, vz);
+        _mm256_store_ps(s.px + i, _mm256_fmadd_ps(vx, vdt, _mm256_load_ps(s.px + i)));
+        _mm256_store_ps(s.py + i, _mm256_fmadd_ps(vy, vdt, _mm256_load_ps(s.py + i)));
+        _mm256_store_ps(s.pz + i, _mm256_fmadd_ps(vz, vdt, _mm256_load_ps(s.pz + i)));
+        _mm256_store_ps(s.life + i, _mm256_sub_ps(_mm256_load_ps(s.life + i), vdt));
+    }
+}
+
+#endif // PAC_SIMD_X86
+
+} // namespace
+
+void integrate(Path path, const Streams& s, std::size_t count,
+               const glm::vec3& accel, float damping, float dt)
+{
+    if (count == 0) return;
+    count = (count + kStreamAlign - 1) / kStreamAlign * kStreamAlign;
+
+#if PAC_SIMD_X86
+    if (path == Path::AVX2 && pac_simd::isPathSupported(Path::AVX2)) {
+        integrateAVX2(s, count, accel, damping, dt);
+        return;
+    }
+    if (path == Path::SSE || path == Path::AVX2) {
+        integrateSSE(s, count, accel, damping, dt);
+        return;
+    }
+#endif
+    integrateScalar(s, count, accel, damping, dt);
+}
+
+} // namespace pac_particle_kernels
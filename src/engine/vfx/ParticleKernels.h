@@ -0,0 +1,49 @@
+// src/engine/vfx/ParticleKernels.h
+//
+// Batched particle integration over structure-of-arrays streams:
+//     vel = (vel + accel * dt) * damping
+//     pos += vel * dt
+//     life -= dt
+//
+// SSE and AVX2 kernels with a scalar fallback, picked at runtime through pac_simd
+// (engine/utils/SimdDispatch.h). Every path gives the same results up to FMA rounding.
+#pragma once
+
+#include "engine/utils/SimdDispatch.h"
+
+#include <cstddef>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace pac_particle_kernels {
+
+using pac_simd::Path;
+
+// 32-byte aligned float stream; pools keep capacity rounded up to a multiple of 8 so the
+// vector loops never need a masked tail.
+using FloatStream = std::vector<float, pac_simd::AlignedAllocator<float>>;
+
+constexpr std::size_t kStreamAlign = 8;
+
+struct Streams {
+    float* px;
+    float* py;
+    float* pz;
+    float* vx;
+    float* vy;
+    float* vz;
+    float* life;
+};
+
+// Integrates count particles (padded up to kStreamAlign; padding lanes are harmless).
+void integrate(Path path, const Streams& s, std::size_t count,
+               const glm::vec3& accel, float damping, float dt);
+
+inline void integrate(const Streams& s, std::size_t count,
+                      const glm::vec3& accel, float damping, float dt)
+{
+    integrate(pac_simd::bestAvailablePath(), s, count, accel, damping, dt);
+}
+
+} // namespace pac_particle_kernels
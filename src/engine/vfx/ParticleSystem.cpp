@@ -5,37 +5,29 @@
 #include "engine/utils/Shader.h"
 #include "engine/utils/ShaderLibrary.h"
 #include "engine/render/Camera3D.h"
+#include "engine/render/GLStateCache.h"
+#include "engine/render/TextureCache.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unordered_map>
 
 #include <glad/glad.h>
 
 // stb_image implementation is compiled in src/engine/utils/stb_image_impl.cpp.
 #include <stb_image.h>
 
-static GLuint create1x1WhiteTextureRGBA() {
-    GLuint tex = 0;
-    glGenTextures(1, &tex);
-    glBindTexture(GL_TEXTURE_2D, tex);
-
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-    unsigned char white[4] = { 255, 255, 255, 255 };
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, white);
-
-    return tex;
-}
-
-// If path is empty or load fails, returns 1x1 white.
-static unsigned int loadTextureRGBAOrWhite(const std::string& path) {
+// If path is empty or load fails, returns the shared 1x1 white.
+// Effects that use the same atlas share one texture through TextureCache.
+static TextureHandle loadTextureRGBAOrWhite(const std::string& path) {
+    auto& cache = TextureCache::getInstance();
     if (path.empty()) {
-        return create1x1WhiteTextureRGBA();
+        return cache.white();
     }
 
     int w = 0, h = 0, comp = 0;
@@ -46,21 +38,16 @@ static unsigned int loadTextureRGBAOrWhite(const std::string& path) {
     unsigned char* data = stbi_load(path.c_str(), &w, &h, &comp, 4);
     if (!data || w <= 0 || h <= 0) {
         if (data) stbi_image_free(data);
-        return create1x1WhiteTextureRGBA();
+        return cache.white();
     }
 
-    GLuint tex = 0;
-    glGenTextures(1, &tex);
-    glBindTexture(GL_TEXTURE_2D, tex);
-
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+    TextureCache::Desc desc;
+    desc.width  = (uint32_t)w;
+    desc.height = (uint32_t)h;
+    desc.wrapS = desc.wrapT = GL_CLAMP_TO_EDGE;
+    desc.minF  = desc.magF  = GL_LINEAR;
 
+    TextureHandle tex = cache.acquire(desc, data);
     stbi_image_free(data);
     return tex;
 }
@@ -70,12 +57,7 @@ ParticleSystem::~ParticleSystem() {
 }
 
 void ParticleSystem::ensureFlipbookLoaded() {
-    if (!flipbookDirty && flipbookTex != 0) return;
-
-    if (flipbookTex) {
-        glDeleteTextures(1, &flipbookTex);
-        flipbookTex = 0;
-    }
+    if (!flipbookDirty && flipbookTex) return;
 
     flipbookTex = loadTextureRGBAOrWhite(flipbookPath);
     flipbookDirty = false;
@@ -83,12 +65,7 @@ void ParticleSystem::ensureFlipbookLoaded() {
 
 void ParticleSystem::ensureSecondaryFlipbookLoaded() {
     if (!useSecondaryFlipbook) return;
-    if (!flipbookDirty2 && flipbookTex2 != 0) return;
-
-    if (flipbookTex2) {
-        glDeleteTextures(1, &flipbookTex2);
-        flipbookTex2 = 0;
-    }
+    if (!flipbookDirty2 && flipbookTex2) return;
 
     flipbookTex2 = loadTextureRGBAOrWhite(flipbookPath2);
     flipbookDirty2 = false;
@@ -101,6 +78,46 @@ void ParticleSystem::ensureShaderLoaded() {
     shaderDirty = false;
 }
 
+void ParticleSystem::ensureUniformLocations() {
+    if (!shader || uniformsProgram == shader->getID()) return;
+
+    const GLuint prog = shader->getID();
+    uniforms.viewProj     = glGetUniformLocation(prog, "u_ViewProj");
+    uniforms.time         = glGetUniformLocation(prog, "u_Time");
+    uniforms.pointScale   = glGetUniformLocation(prog, "u_PointScale");
+    uniforms.useFlipbook  = glGetUniformLocation(prog, "u_UseFlipbook");
+    uniforms.flipbook     = glGetUniformLocation(prog, "u_Flipbook");
+    uniforms.grid         = glGetUniformLocation(prog, "u_FlipbookGrid");
+    uniforms.frameCount   = glGetUniformLocation(prog, "u_FrameCount");
+    uniforms.fps          = glGetUniformLocation(prog, "u_Fps");
+    uniforms.hasFlipbook2 = glGetUniformLocation(prog, "u_HasFlipbook2");
+    uniforms.flipbook2    = glGetUniformLocation(prog, "u_Flipbook2");
+    uniforms.grid2        = glGetUniformLocation(prog, "u_FlipbookGrid2");
+    uniforms.frameCount2  = glGetUniformLocation(prog, "u_FrameCount2");
+    uniforms.fps2         = glGetUniformLocation(prog, "u_Fps2");
+    uniformsProgram = prog;
+}
+
+void ParticleSystem::bindVertexLayout() {
+    // Expects the VAO bound and the ring's buffer on GL_ARRAY_BUFFER.
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(GPUParticle), (void*)offsetof(GPUParticle, pos));
+
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 1, GL_FLOAT, GL_FALSE, sizeof(GPUParticle), (void*)offsetof(GPUParticle, age01));
+
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(GPUParticle), (void*)offsetof(GPUParticle, sizePx));
+
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(GPUParticle), (void*)offsetof(GPUParticle, seed));
+
+    glEnableVertexAttribArray(4);
+    glVertexAttribPointer(4, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(GPUParticle), (void*)offsetof(GPUParticle, color));
+
+    layoutBuffer = vertexRing.getBuffer();
+}
+
 void ParticleSystem::init() {
     if (initialized) return;
 
@@ -116,109 +133,410 @@ void ParticleSystem::init() {
     }
 
     glGenVertexArrays(1, &vao);
-    glGenBuffers(1, &vbo);
 
-    glBindVertexArray(vao);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    // Room for 1024 particles per ring segment up front; bigger frames grow the ring.
+    GLStateCache::getInstance().bindVertexArray(vao);
+    vertexRing.reserve(1024 * sizeof(GPUParticle));
+    bindVertexLayout();
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    GLStateCache::getInstance().bindVertexArray(0);
 
-    glBufferData(GL_ARRAY_BUFFER, 1024 * sizeof(GPUParticle), nullptr, GL_STREAM_DRAW);
+    initialized = true;
+}
 
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(GPUParticle), (void*)offsetof(GPUParticle, pos));
+void ParticleSystem::shutdown() {
+    // The GPU backend's buffers go with the context; come back up on the CPU.
+    if (gpuSim) setSimBackend(SimBackend::CPU);
+    if (!initialized) return;
 
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 1, GL_FLOAT, GL_FALSE, sizeof(GPUParticle), (void*)offsetof(GPUParticle, age01));
+    flipbookTex.reset();
+    flipbookTex2.reset();
 
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(GPUParticle), (void*)offsetof(GPUParticle, sizePx));
+    vertexRing.destroy();
+    if (vao) GLStateCache::getInstance().deleteVertexArrays(1, &vao);
 
-    glEnableVertexAttribArray(3);
-    glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(GPUParticle), (void*)offsetof(GPUParticle, seed));
+    vao = 0;
+    layoutBuffer = 0;
+    uniformsProgram = 0;
 
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    count = 0;
 
-    initialized = true;
+    initialized = false;
 }
 
-void ParticleSystem::shutdown() {
-    if (!initialized) return;
+void ParticleSystem::setCapacity(uint32_t maxParticles) {
+    capacity = maxParticles;
+    if (gpuSim) {
+        // Fresh buffers: the GPU backend drops its live particles instead of keeping a prefix.
+        if (!gpuSim->init(capacity)) setSimBackend(SimBackend::CPU);
+        return;
+    }
+    count = std::min(count, capacity);
 
-    if (flipbookTex) glDeleteTextures(1, &flipbookTex);
-    flipbookTex = 0;
+    const size_t padded = (capacity + pac_particle_kernels::kStreamAlign - 1)
+                        / pac_particle_kernels::kStreamAlign * pac_particle_kernels::kStreamAlign;
+    for (auto* stream : { &posX, &posY, &posZ, &velX, &velY, &velZ, &life, &maxLife, &sizePx, &seed }) {
+        stream->resize(padded, 0.0f);
+        stream->shrink_to_fit();
+    }
+    color.resize(capacity, 0xFFFFFFFFu);
+    color.shrink_to_fit();
+}
 
-    if (flipbookTex2) glDeleteTextures(1, &flipbookTex2);
-    flipbookTex2 = 0;
+static uint32_t packColor(const glm::vec4& c) {
+    auto channel = [](float v) { return (uint32_t)std::lround(std::clamp(v, 0.0f, 1.0f) * 255.0f); };
+    return channel(c.x) | (channel(c.y) << 8) | (channel(c.z) << 16) | (channel(c.w) << 24);
+}
 
-    if (vbo) glDeleteBuffers(1, &vbo);
-    if (vao) glDeleteVertexArrays(1, &vao);
+uint32_t ParticleSystem::getParticleCount() const {
+    return gpuSim ? gpuSim->getCount() : count;
+}
 
-    vbo = 0;
-    vao = 0;
+void ParticleSystem::setSimBackend(SimBackend backend) {
+    if (backend == simBackend) return;
+
+    if (backend == SimBackend::GPU) {
+        auto sim = std::make_unique<ParticleGpuSim>();
+        if (!sim->init(capacity ? capacity : kDefaultCapacity)) return;
+        gpuSim = std::move(sim);
+        capacity = gpuSim->getCapacity();
+        count = 0;
+        simBackend = SimBackend::GPU;
+        return;
+    }
 
-    particles.clear();
-    gpuBuffer.clear();
+    gpuSim.reset();
+    simBackend = SimBackend::CPU;
+    count = 0;
+    if (capacity > 0) setCapacity(capacity);
+}
 
-    initialized = false;
+ParticleSystem::SimBackend ParticleSystem::defaultSimBackend() {
+    static const SimBackend backend = [] {
+        const char* env = std::getenv("PAC_PARTICLE_SIM");
+        return (env && std::string(env) == "gpu") ? SimBackend::GPU : SimBackend::CPU;
+    }();
+    return backend;
 }
 
 void ParticleSystem::emit(const Particle& p) {
-    particles.push_back(p);
+    if (gpuSim) {
+        ParticleGpuSim::State s;
+        s.pos = p.pos;
+        s.deathTime = timeSec + p.lifeSec;
+        s.vel = p.vel;
+        s.maxLife = p.maxLifeSec;
+        s.sizePx = p.sizePx;
+        s.seed = p.seed;
+        s.age01 = std::clamp(1.0f - p.lifeSec / std::max(0.0001f, p.maxLifeSec), 0.0f, 1.0f);
+        s.color = packColor(p.color);
+        if (!gpuSim->emit(s)) ++droppedCount;
+        return;
+    }
+
+    if (capacity == 0) setCapacity(kDefaultCapacity);
+    if (count >= capacity) {
+        ++droppedCount;
+        return;
+    }
+
+    const uint32_t i = count++;
+    posX[i] = p.pos.x;  posY[i] = p.pos.y;  posZ[i] = p.pos.z;
+    velX[i] = p.vel.x;  velY[i] = p.vel.y;  velZ[i] = p.vel.z;
+    life[i] = p.lifeSec;
+    maxLife[i] = p.maxLifeSec;
+    sizePx[i] = p.sizePx;
+    seed[i] = p.seed;
+    color[i] = packColor(p.color);
 }
 
 void ParticleSystem::update(float dt) {
     if (!initialized) init();
+    step(dt);
+}
 
+void ParticleSystem::step(float dt) {
+    simulate(dt, pac_simd::bestAvailablePath());
+}
+
+void ParticleSystem::simulate(float dt, pac_particle_kernels::Path path) {
     dt = std::clamp(dt, 0.0f, 0.05f);
     timeSec += dt;
 
-    // Integrate + cull dead
-    for (auto& p : particles) {
-        p.vel += updateSettings.acceleration * dt;
+    // Exponential damping for framerate independence; the same factor for every particle.
+    if (gpuSim) {
+        if (gpuSim->getCount() > 0) {
+            gpuSim->step(dt, timeSec, updateSettings.acceleration, std::pow(updateSettings.dampingBase, dt));
+        }
+        return;
+    }
+    if (count == 0) return;
+
+    const float damp = std::pow(updateSettings.dampingBase, dt);
+    const pac_particle_kernels::Streams streams{
+        posX.data(), posY.data(), posZ.data(), velX.data(), velY.data(), velZ.data(), life.data()
+    };
+    pac_particle_kernels::integrate(path, streams, count, updateSettings.acceleration, damp, dt);
+
+    // Swap-with-last removal: order isn't preserved (render order never mattered here).
+    for (uint32_t i = 0; i < count;) {
+        if (life[i] > 0.0f) {
+            ++i;
+            continue;
+        }
+        const uint32_t last = --count;
+        posX[i] = posX[last];  posY[i] = posY[last];  posZ[i] = posZ[last];
+        velX[i] = velX[last];  velY[i] = velY[last];  velZ[i] = velZ[last];
+        life[i] = life[last];
+        maxLife[i] = maxLife[last];
+        sizePx[i] = sizePx[last];
+        seed[i] = seed[last];
+        color[i] = color[last];
+    }
+}
+
+std::vector<ParticleSystem::BenchResult> ParticleSystem::benchmarkUpdate(uint32_t particleCount, int frames) {
+    using clock = std::chrono::steady_clock;
+
+    std::vector<BenchResult> results;
+    if (particleCount == 0 || frames <= 0) return results;
+
+    constexpr float kDt = 1.0f / 60.0f;
+    UpdateSettings us;
+    us.acceleration = glm::vec3(0.0f, 1.2f, 0.0f);
+    us.dampingBase = 0.07f;
+
+    // Deterministic spawns with lifetimes of 0.25..1.25 s, so a few percent die every frame.
+    uint32_t serial = 0;
+    auto spawn = [&serial]() {
+        const uint32_t n = serial++;
+        auto h = [n](uint32_t k) { return (float)((n * 2654435761u + k * 40503u) % 1000u) / 1000.0f; };
+        Particle p;
+        p.pos = glm::vec3(h(1) - 0.5f, h(2), h(3) - 0.5f);
+        p.vel = glm::vec3(h(4) - 0.5f, h(5), h(6) - 0.5f) * 0.1f;
+        p.maxLifeSec = 0.25f + h(7);
+        p.lifeSec = p.maxLifeSec;
+        p.sizePx = 0.2f + 0.1f * h(8);
+        p.seed = h(9);
+        return p;
+    };
+
+    auto finish = [&](BenchResult r, clock::time_point t0) {
+        const double sec = std::chrono::duration<double>(clock::now() - t0).count();
+        r.supported = true;
+        r.msPerFrame = sec * 1000.0 / (double)frames;
+        r.particlesPerSec = (sec > 0.0) ? (double)particleCount * (double)frames / sec : 0.0;
+        results.push_back(r);
+    };
+
+    // The pre-pool update, kept here as the baseline.
+    {
+        serial = 0;
+        std::vector<Particle> particles;
+        for (uint32_t i = 0; i < particleCount; ++i) particles.push_back(spawn());
+
+        const auto t0 = clock::now();
+        for (int f = 0; f < frames; ++f) {
+            for (auto& p : particles) {
+                p.vel += us.acceleration * kDt;
+                p.vel *= std::pow(us.dampingBase, kDt);
+                p.pos += p.vel * kDt;
+                p.lifeSec -= kDt;
+            }
+            particles.erase(std::remove_if(particles.begin(), particles.end(),
+                                           [](const Particle& p) { return p.lifeSec <= 0.0f; }),
+                            particles.end());
+            while (particles.size() < particleCount) particles.push_back(spawn());
+        }
+        BenchResult r;
+        r.name = "aos";
+        finish(r, t0);
+    }
+
+    for (pac_particle_kernels::Path path : { pac_particle_kernels::Path::Scalar,
+                                             pac_particle_kernels::Path::SSE,
+                                             pac_particle_kernels::Path::AVX2 }) {
+        BenchResult r;
+        r.name = pac_simd::pathName(path);
+        if (!pac_simd::isPathSupported(path)) {
+            results.push_back(r);
+            continue;
+        }
+
+        serial = 0;
+        ParticleSystem ps; // never initialized: no GL
+        ps.setCapacity(particleCount);
+        ps.setUpdateSettings(us);
+        for (uint32_t i = 0; i < particleCount; ++i) ps.emit(spawn());
 
-        // Exponential damping for framerate independence
-        float damp = std::pow(updateSettings.dampingBase, dt);
-        p.vel *= damp;
+        const auto t0 = clock::now();
+        for (int f = 0; f < frames; ++f) {
+            ps.simulate(kDt, path);
+            while (ps.count < particleCount) ps.emit(spawn());
+        }
+        finish(r, t0);
+    }
+    return results;
+}
 
-        p.pos += p.vel * dt;
-        p.lifeSec -= dt;
+ParticleSystem::SimCheckResult ParticleSystem::checkGpuSimulation(int frames) {
+    SimCheckResult r;
+
+    constexpr float kDt = 1.0f / 60.0f;
+    constexpr uint32_t kPerFrame = 40;
+    constexpr float kTolerance = 1e-4f;
+
+    UpdateSettings us;
+    us.acceleration = glm::vec3(0.3f, 1.2f, -0.4f);
+    us.dampingBase = 0.07f;
+
+    ParticleSystem cpu; // neither is initialized: no render resources needed
+    ParticleSystem gpu;
+    gpu.setSimBackend(SimBackend::GPU);
+    if (gpu.getSimBackend() != SimBackend::GPU) return r;
+    r.gpuAvailable = true;
+
+    const uint32_t cap = kPerFrame * 64;
+    cpu.setCapacity(cap);
+    gpu.setCapacity(cap);
+    cpu.setUpdateSettings(us);
+    gpu.setUpdateSettings(us);
+
+    // Lifetimes sit half a step off the frame grid, so both backends agree on which
+    // frame each particle dies in. Seeds are exact and unique: they pair the survivors.
+    uint32_t serial = 0;
+    auto spawn = [&serial]() {
+        const uint32_t n = serial++;
+        auto h = [n](uint32_t k) { return (float)((n * 2654435761u + k * 40503u) % 1000u) / 1000.0f; };
+        Particle p;
+        p.pos = glm::vec3(h(1) - 0.5f, h(2), h(3) - 0.5f);
+        p.vel = glm::vec3(h(4) - 0.5f, h(5), h(6) - 0.5f);
+        p.maxLifeSec = ((float)(12 + n % 48) + 0.5f) * kDt;
+        p.lifeSec = p.maxLifeSec;
+        p.sizePx = 0.2f;
+        p.seed = (float)n / 65536.0f;
+        return p;
+    };
+
+    for (int f = 0; f < frames; ++f) {
+        for (uint32_t i = 0; i < kPerFrame; ++i) {
+            const Particle p = spawn();
+            cpu.emit(p);
+            gpu.emit(p);
+        }
+        cpu.simulate(kDt, pac_simd::bestAvailablePath());
+        gpu.simulate(kDt, pac_simd::bestAvailablePath());
     }
 
-    particles.erase(
-        std::remove_if(particles.begin(), particles.end(),
-                       [](const Particle& p) { return p.lifeSec <= 0.0f; }),
-        particles.end()
-    );
+    std::vector<ParticleGpuSim::State> states;
+    gpu.gpuSim->readBack(states);
+    r.cpuCount = cpu.count;
+    r.gpuCount = (uint32_t)states.size();
+
+    std::unordered_map<float, uint32_t> cpuBySeed;
+    for (uint32_t i = 0; i < cpu.count; ++i) cpuBySeed[cpu.seed[i]] = i;
+
+    uint32_t matched = 0;
+    for (const auto& s : states) {
+        auto it = cpuBySeed.find(s.seed);
+        if (it == cpuBySeed.end()) {
+            ++r.unmatched;
+            continue;
+        }
+        const uint32_t i = it->second;
+        ++matched;
+        r.maxPosError = std::max(r.maxPosError, glm::length(s.pos - glm::vec3(cpu.posX[i], cpu.posY[i], cpu.posZ[i])));
+        r.maxVelError = std::max(r.maxVelError, glm::length(s.vel - glm::vec3(cpu.velX[i], cpu.velY[i], cpu.velZ[i])));
+    }
+    r.unmatched += cpu.count - matched;
+    r.passed = r.unmatched == 0 && r.maxPosError <= kTolerance && r.maxVelError <= kTolerance;
+    return r;
+}
+
+static bool particleSortDisabled() {
+    static const bool disabled = [] {
+        const char* env = std::getenv("PAC_DISABLE_PARTICLE_SORT");
+        return env && *env && std::string(env) != "0";
+    }();
+    return disabled;
+}
+
+// Float bits -> uint32 with the same ordering (negatives flipped entirely, positives get the
+// sign bit), inverted so an ascending sort puts the farthest particle first.
+static uint32_t backToFrontKey(float viewDepth) {
+    uint32_t bits;
+    std::memcpy(&bits, &viewDepth, sizeof(bits));
+    const uint32_t ordered = (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+    return ~ordered;
+}
+
+// Stable LSD radix sort of (keys, order) pairs, 8 bits per pass. A pass whose byte is the
+// same for every key is skipped. The result may end up in either buffer; returns the one.
+static const uint32_t* radixSortPairs(uint32_t* keys, uint32_t* order,
+                                      uint32_t* keysTmp, uint32_t* orderTmp, uint32_t n) {
+    for (int shift = 0; shift < 32; shift += 8) {
+        uint32_t offsets[256] = {};
+        for (uint32_t i = 0; i < n; ++i) ++offsets[(keys[i] >> shift) & 0xFFu];
+        if (offsets[(keys[0] >> shift) & 0xFFu] == n) continue;
+
+        uint32_t sum = 0;
+        for (uint32_t& o : offsets) {
+            const uint32_t c = o;
+            o = sum;
+            sum += c;
+        }
+        for (uint32_t i = 0; i < n; ++i) {
+            const uint32_t dst = offsets[(keys[i] >> shift) & 0xFFu]++;
+            keysTmp[dst] = keys[i];
+            orderTmp[dst] = order[i];
+        }
+        std::swap(keys, keysTmp);
+        std::swap(order, orderTmp);
+    }
+    return order;
 }
 
 static void applyBlendMode(ParticleSystem::BlendMode mode) {
-    glEnable(GL_BLEND);
+    auto& gl = GLStateCache::getInstance();
+    gl.enable(GL_BLEND);
 
     switch (mode) {
         case ParticleSystem::BlendMode::Alpha:
-            glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA,
-                                GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+            gl.setBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA,
+                                    GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
             break;
         case ParticleSystem::BlendMode::Additive:
-            glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE, GL_ONE, GL_ONE);
+            gl.setBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE, GL_ONE, GL_ONE);
             break;
         case ParticleSystem::BlendMode::Premultiplied:
-            glBlendFuncSeparate(GL_ONE, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+            gl.setBlendFuncSeparate(GL_ONE, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
             break;
     }
 }
 
 void ParticleSystem::render(const Camera3D& camera) {
+    render(camera, { this });
+}
+
+void ParticleSystem::render(const Camera3D& camera, const std::vector<const ParticleSystem*>& sources) {
     if (!initialized) init();
     ensureShaderLoaded();
 
+    lastRenderStats = RenderStats{};
     if (!shader || vao == 0) return;
-    if (particles.empty()) return;
+
+    uint32_t total = 0;    // CPU-simulated: culled and uploaded through the ring
+    uint32_t gpuTotal = 0; // GPU-simulated: drawn from their own state buffers
+    for (const ParticleSystem* src : sources) {
+        if (src->gpuSim) gpuTotal += src->gpuSim->getCount();
+        else total += src->count;
+    }
+    if (total == 0 && gpuTotal == 0) return;
 
     // Only require flipbook texture when enabled
     if (useFlipbook) {
         ensureFlipbookLoaded();
-        if (flipbookTex == 0) return;
+        if (!flipbookTex) return;
     }
 
     if (useFlipbook && useSecondaryFlipbook) {
@@ -226,118 +544,153 @@ void ParticleSystem::render(const Camera3D& camera) {
         // Secondary can fall back to white; do not early-out on missing tex2.
     }
 
-    // Build GPU buffer
-    gpuBuffer.resize(particles.size());
-    for (size_t i = 0; i < particles.size(); ++i) {
-        const Particle& p = particles[i];
-
-        float age01 = 1.0f - (p.lifeSec / std::max(0.0001f, p.maxLifeSec));
-        age01 = std::clamp(age01, 0.0f, 1.0f);
-
-        gpuBuffer[i] = GPUParticle{ p.pos, age01, p.sizePx, p.seed };
+    // Sprites are sizePx * u_PointScale / w pixels across, so their world-space radius is
+    // the same at any depth: sizePx * pointScale / (viewportHeight * proj[1][1]). (The
+    // shader's min point size can make far sprites a little bigger; they're tiny anyway.)
+    auto& gl = GLStateCache::getInstance();
+    GLint viewport[4];
+    gl.getViewport(viewport);
+    const float projScaleY = camera.getProjectionMatrix()[1][1];
+    const bool cull = Frustum::isCullingEnabled() && viewport[3] > 0 && projScaleY > 0.0f;
+    const float radiusPerScale = cull ? 1.0f / ((float)viewport[3] * projScaleY) : 0.0f;
+    const Frustum& frustum = camera.getFrustum();
+
+    // Build the vertices straight into the ring (visible particles only). Sizes are rescaled
+    // to this system's u_PointScale so every source keeps its on-screen size.
+    bool sort = false;
+    if (renderSettings.blend != BlendMode::Additive && !particleSortDisabled()) {
+        sort = renderSettings.sortBackToFront;
+        for (const ParticleSystem* src : sources) sort = sort || src->renderSettings.sortBackToFront;
     }
+    uint32_t drawn = 0;
+    uint32_t culled = 0;
+    GLint first = 0;
+    if (total > 0) {
+        gl.bindVertexArray(vao);
+        if (auto* out = static_cast<GPUParticle*>(vertexRing.map((size_t)total * sizeof(GPUParticle)))) {
+            if (layoutBuffer != vertexRing.getBuffer()) bindVertexLayout(); // the ring grew
+
+            // Sorted draws stage the visible vertices first and copy them over in depth order.
+            GPUParticle* dst = out;
+            if (sort) {
+                if (sortVertices.size() < total) sortVertices.resize(total);
+                dst = sortVertices.data();
+            }
 
-    // Save GL state
-    GLboolean wasBlend = glIsEnabled(GL_BLEND);
-    GLboolean wasDepth = glIsEnabled(GL_DEPTH_TEST);
-    GLboolean wasProgPoint = glIsEnabled(GL_PROGRAM_POINT_SIZE);
+            for (const ParticleSystem* src : sources) {
+                if (src->gpuSim) continue;
+                const float sizeScale = (pointScale > 0.0f) ? src->pointScale / pointScale : 1.0f;
+                const float radiusPerSize = src->pointScale * radiusPerScale;
+                for (uint32_t i = 0; i < src->count; ++i) {
+                    const glm::vec3 pos(src->posX[i], src->posY[i], src->posZ[i]);
+                    if (cull && !frustum.intersectsSphere(pos, src->sizePx[i] * radiusPerSize)) continue;
+
+                    const float age01 = std::clamp(1.0f - src->life[i] / std::max(0.0001f, src->maxLife[i]), 0.0f, 1.0f);
+                    dst[drawn++] = GPUParticle{ pos, age01, src->sizePx[i] * sizeScale, src->seed[i], src->color[i] };
+                }
+            }
 
-    GLint prevBlendSrcRGB = 0, prevBlendDstRGB = 0, prevBlendSrcA = 0, prevBlendDstA = 0;
-    glGetIntegerv(GL_BLEND_SRC_RGB, &prevBlendSrcRGB);
-    glGetIntegerv(GL_BLEND_DST_RGB, &prevBlendDstRGB);
-    glGetIntegerv(GL_BLEND_SRC_ALPHA, &prevBlendSrcA);
-    glGetIntegerv(GL_BLEND_DST_ALPHA, &prevBlendDstA);
+            if (sort && drawn > 0) {
+                const auto t0 = std::chrono::steady_clock::now();
+                if (sortKeys.size() < drawn) {
+                    sortKeys.resize(drawn);
+                    sortKeysTmp.resize(drawn);
+                    sortOrder.resize(drawn);
+                    sortOrderTmp.resize(drawn);
+                }
+                // View depth along the camera's forward axis (row 2 of the view matrix, negated).
+                const glm::mat4& view = camera.getViewMatrix();
+                const glm::vec3 zRow(view[0][2], view[1][2], view[2][2]);
+                const float zOffset = view[3][2];
+                for (uint32_t i = 0; i < drawn; ++i) {
+                    sortKeys[i] = backToFrontKey(-(glm::dot(zRow, dst[i].pos) + zOffset));
+                    sortOrder[i] = i;
+                }
+                const uint32_t* order = radixSortPairs(sortKeys.data(), sortOrder.data(),
+                                                       sortKeysTmp.data(), sortOrderTmp.data(), drawn);
+                for (uint32_t i = 0; i < drawn; ++i) out[i] = dst[order[i]];
+
+                lastRenderStats.sorted = drawn;
+                lastRenderStats.sortMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+            }
+            first = vertexRing.unmap((size_t)drawn * sizeof(GPUParticle));
+            culled = total - drawn;
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        gl.bindVertexArray(0);
+    }
 
-    GLint prevBlendEqRGB = 0, prevBlendEqA = 0;
-    glGetIntegerv(GL_BLEND_EQUATION_RGB, &prevBlendEqRGB);
-    glGetIntegerv(GL_BLEND_EQUATION_ALPHA, &prevBlendEqA);
+    // GPU-simulated particles never come back to the CPU, so they aren't frustum tested.
+    // A failed ring map draws none of the CPU particles, but they weren't culled either.
+    lastRenderStats.drawn  = drawn + gpuTotal;
+    lastRenderStats.culled = culled;
+    if (drawn == 0 && gpuTotal == 0) return;
 
-    GLboolean prevDepthMask = GL_TRUE;
-    glGetBooleanv(GL_DEPTH_WRITEMASK, &prevDepthMask);
+    // Save GL state (shadow copy, no glGet)
+    const GLStateCache::Snapshot savedState = gl.capture();
 
     // Apply render settings (effect-owned)
-    if (renderSettings.programPointSize) glEnable(GL_PROGRAM_POINT_SIZE);
-    else glDisable(GL_PROGRAM_POINT_SIZE);
+    gl.setEnabled(GL_PROGRAM_POINT_SIZE, renderSettings.programPointSize);
 
     applyBlendMode(renderSettings.blend);
 
-    if (renderSettings.depthTest) glEnable(GL_DEPTH_TEST);
-    else glDisable(GL_DEPTH_TEST);
-
-    glDepthMask(renderSettings.depthWrite ? GL_TRUE : GL_FALSE);
+    gl.setEnabled(GL_DEPTH_TEST, renderSettings.depthTest);
+    gl.setDepthMask(renderSettings.depthWrite);
 
     shader->use();
+    ensureUniformLocations();
 
-    glm::mat4 viewProj = camera.getProjectionMatrix() * camera.getViewMatrix();
-    shader->setUniform("u_ViewProj", viewProj);
-    shader->setUniform("u_Time", timeSec);
-    shader->setUniform("u_PointScale", pointScale);
+    glUniformMatrix4fv(uniforms.viewProj, 1, GL_FALSE, &camera.getViewProjectionMatrix()[0][0]);
+    glUniform1f(uniforms.time, timeSec);
+    glUniform1f(uniforms.pointScale, pointScale);
 
-    // Tell shaders that support it whether flipbook sampling is valid (no warning spam)
-    {
-        GLint loc = glGetUniformLocation(shader->getID(), "u_UseFlipbook");
-        if (loc != -1) glUniform1i(loc, useFlipbook ? 1 : 0);
-    }    // Flipbook uniforms + bind only if enabled
-    if (useFlipbook) {
-        shader->setUniform("u_Flipbook", 0);
-        shader->setUniform("u_FlipbookGrid", glm::vec2((float)flipbookCols, (float)flipbookRows));
-        shader->setUniform("u_FrameCount", (float)flipbookFrames);
-        shader->setUniform("u_Fps", flipbookFps);
-
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, flipbookTex);
-
-        // Secondary atlas (optional) — only set if the shader declares the uniforms.
-        int has2 = (useSecondaryFlipbook && flipbookTex2 != 0) ? 1 : 0;
-        {
-            GLint locHas2 = glGetUniformLocation(shader->getID(), "u_HasFlipbook2");
-            if (locHas2 != -1) glUniform1i(locHas2, has2);
-        }
+    // Tell shaders that support it whether flipbook sampling is valid
+    glUniform1i(uniforms.useFlipbook, useFlipbook ? 1 : 0);
 
-        if (has2) {
-            GLint locSampler2 = glGetUniformLocation(shader->getID(), "u_Flipbook2");
-            if (locSampler2 != -1) {
-                glUniform1i(locSampler2, 1);
+    // Flipbook uniforms + bind only if enabled
+    if (useFlipbook) {
+        glUniform1i(uniforms.flipbook, 0);
+        glUniform2f(uniforms.grid, (float)flipbookCols, (float)flipbookRows);
+        glUniform1f(uniforms.frameCount, (float)flipbookFrames);
+        glUniform1f(uniforms.fps, flipbookFps);
 
-                GLint locGrid2 = glGetUniformLocation(shader->getID(), "u_FlipbookGrid2");
-                if (locGrid2 != -1) glUniform2f(locGrid2, (float)flipbookCols2, (float)flipbookRows2);
+        gl.bindTexture(0, GL_TEXTURE_2D, flipbookTex.getID());
 
-                GLint locFrames2 = glGetUniformLocation(shader->getID(), "u_FrameCount2");
-                if (locFrames2 != -1) glUniform1f(locFrames2, (float)flipbookFrames2);
+        // Secondary atlas (optional) — only for shaders that declare it.
+        const int has2 = (useSecondaryFlipbook && flipbookTex2) ? 1 : 0;
+        glUniform1i(uniforms.hasFlipbook2, has2);
 
-                GLint locFps2 = glGetUniformLocation(shader->getID(), "u_Fps2");
-                if (locFps2 != -1) glUniform1f(locFps2, flipbookFps2);
+        if (has2 && uniforms.flipbook2 != -1) {
+            glUniform1i(uniforms.flipbook2, 1);
+            glUniform2f(uniforms.grid2, (float)flipbookCols2, (float)flipbookRows2);
+            glUniform1f(uniforms.frameCount2, (float)flipbookFrames2);
+            glUniform1f(uniforms.fps2, flipbookFps2);
 
-                glActiveTexture(GL_TEXTURE1);
-                glBindTexture(GL_TEXTURE_2D, flipbookTex2);
+            gl.bindTexture(1, GL_TEXTURE_2D, flipbookTex2.getID());
 
-                // Restore active texture to 0 for safety.
-                glActiveTexture(GL_TEXTURE0);
-            }
+            // Restore active texture to 0 for safety.
+            gl.setActiveTexture(0);
         }
     }
 
-    glBindVertexArray(vao);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-
-    glBufferData(GL_ARRAY_BUFFER,
-                 (GLsizeiptr)(gpuBuffer.size() * sizeof(GPUParticle)),
-                 gpuBuffer.data(),
-                 GL_STREAM_DRAW);
+    if (drawn > 0) {
+        gl.bindVertexArray(vao);
+        glDrawArrays(GL_POINTS, first, (GLsizei)drawn);
+        vertexRing.fence();
+        ++lastRenderStats.drawCalls;
+    }
 
-    glDrawArrays(GL_POINTS, 0, (GLsizei)gpuBuffer.size());
+    // One draw per GPU source, at its own point scale.
+    for (const ParticleSystem* src : sources) {
+        if (!src->gpuSim || src->gpuSim->getCount() == 0) continue;
+        glUniform1f(uniforms.pointScale, src->pointScale);
+        gl.bindVertexArray(src->gpuSim->getRenderVao());
+        glDrawArrays(GL_POINTS, 0, (GLsizei)src->gpuSim->getCount());
+        ++lastRenderStats.drawCalls;
+    }
 
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    gl.bindVertexArray(0);
 
     // Restore GL state
-    glDepthMask(prevDepthMask);
-
-    if (!wasDepth) glDisable(GL_DEPTH_TEST);
-    if (!wasBlend) glDisable(GL_BLEND);
-
-    glBlendEquationSeparate(prevBlendEqRGB, prevBlendEqA);
-    glBlendFuncSeparate(prevBlendSrcRGB, prevBlendDstRGB, prevBlendSrcA, prevBlendDstA);
-
-    if (!wasProgPoint) glDisable(GL_PROGRAM_POINT_SIZE);
+    gl.restore(savedState);
 }
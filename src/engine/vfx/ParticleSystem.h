@@ -2,11 +2,17 @@
 // src/engine/vfx/ParticleSystem.h
 #pragma once
 
+#include <cstdint>
 #include <vector>
 #include <memory>
 #include <string>
 #include <glm/glm.hpp>
 
+#include "engine/render/StreamBuffer.h"
+#include "engine/render/TextureCache.h"
+#include "engine/vfx/ParticleGpuSim.h"
+#include "engine/vfx/ParticleKernels.h"
+
 class Shader;
 class Camera3D;
 
@@ -24,6 +30,9 @@ public:
 
         // 0..1 random seed per particle
         float seed = 0.0f;
+
+        // Tint, passed to shaders as vertex attribute 4 (RGBA8). Shaders may ignore it.
+        glm::vec4 color{1.0f};
     };
 
     enum class BlendMode {
@@ -39,6 +48,12 @@ public:
         bool depthWrite = true;
         bool programPointSize = true;
 
+        // Back-to-front by view depth (radix sort) before the upload, across every source of
+        // the draw; set on the rendering system or on any source, it sorts the whole draw.
+        // Ignored for Additive, where order doesn't change the result, and for GPU-simulated
+        // sources. PAC_DISABLE_PARTICLE_SORT=1 turns it off everywhere.
+        bool sortBackToFront = false;
+
         // Reserved for future (shader would need to clamp)
         float pointSizeMin = 3.0f;
         float pointSizeMax = 160.0f;
@@ -53,6 +68,46 @@ public:
         float dampingBase = 1.0f;
     };
 
+    // Last render(): particles uploaded vs dropped by the frustum test, draw calls, and
+    // the depth sort.
+    struct RenderStats {
+        uint32_t drawn = 0;
+        uint32_t culled = 0;
+        uint32_t drawCalls = 0; // the ring draw plus one per GPU-simulated source
+        uint32_t sorted = 0;  // particles reordered back-to-front
+        double   sortMs = 0.0; // keys + radix sort + ordered copy into the ring
+    };
+
+    // update() cost per implementation (benchmarkUpdate). "aos" is the old vector<Particle>
+    // loop (pow per particle, erase/remove_if); the others are the pool per kernel path.
+    struct BenchResult {
+        const char* name = "";
+        bool   supported = false;
+        double particlesPerSec = 0.0;
+        double msPerFrame = 0.0;
+    };
+
+    // Where update() integrates. GPU keeps the particles in GL buffers and steps them with
+    // transform feedback (see ParticleGpuSim); emit/update then need a current GL context.
+    // Both backends apply UpdateSettings the same way.
+    enum class SimBackend {
+        CPU,
+        GPU
+    };
+
+    // checkGpuSimulation(): the same emissions simulated on both backends.
+    struct SimCheckResult {
+        bool gpuAvailable = false;
+        uint32_t cpuCount = 0;
+        uint32_t gpuCount = 0;
+        uint32_t unmatched = 0;   // particles present on one side only
+        float maxPosError = 0.0f; // world units
+        float maxVelError = 0.0f;
+        bool passed = false;
+    };
+
+    static constexpr uint32_t kDefaultCapacity = 4096;
+
 public:
     ParticleSystem() = default;
     ~ParticleSystem();
@@ -66,10 +121,43 @@ public:
     void update(float dt);
     void render(const Camera3D& camera);
 
+    // update() without touching GL, for systems that only simulate and are drawn through
+    // another system's render (see below). Also advances the shader clock of render-only ones.
+    void step(float dt);
+
+    // Draws the particles of every source with this system's shader, blend, flipbooks and
+    // clock, in one upload and one draw call. Each source keeps its own point scale.
+    // Vertices are written straight into this system's StreamBuffer ring, or staged and
+    // copied in depth order when RenderSettings::sortBackToFront applies.
+    void render(const Camera3D& camera, const std::vector<const ParticleSystem*>& sources);
+
+    // Dropped (and counted, see getDroppedCount) once the pool is full.
     void emit(const Particle& p);
 
+    // Particles live in a fixed-capacity structure-of-arrays pool, allocated up front so
+    // update/emit/render never allocate. Shrinking keeps the first maxParticles particles.
+    void setCapacity(uint32_t maxParticles);
+    uint32_t getCapacity() const { return capacity; }
+    uint32_t getParticleCount() const;
+    uint64_t getDroppedCount() const { return droppedCount; }
+
+    // CPU only: particleCount particles kept alive (dead ones re-emitted) for `frames`
+    // 60 Hz steps, on the old AoS loop and on every kernel path.
+    static std::vector<BenchResult> benchmarkUpdate(uint32_t particleCount, int frames);
+
+    // Live particles are dropped when the backend changes. Falls back to CPU if the GPU
+    // backend can't be set up. defaultSimBackend() is GPU with PAC_PARTICLE_SIM=gpu.
+    void setSimBackend(SimBackend backend);
+    SimBackend getSimBackend() const { return simBackend; }
+    static SimBackend defaultSimBackend();
+
+    // Needs a GL context: runs `frames` 60 Hz steps of identical emissions on a CPU and a
+    // GPU system and compares the survivors (matched by seed) within a small tolerance.
+    static SimCheckResult checkGpuSimulation(int frames);
+
     // ----- Configuration (effect-level) -----
     void setPointScale(float s) { pointScale = s; }
+    float getPointScale() const { return pointScale; }
 
     void setShaderPaths(const std::string& vertPath, const std::string& fragPath) {
         shaderVertPath = vertPath;
@@ -111,12 +199,15 @@ public:
     void setUseFlipbook(bool enabled) { useFlipbook = enabled; }
     bool getUseFlipbook() const { return useFlipbook; }
 
+    const RenderStats& getLastRenderStats() const { return lastRenderStats; }
+
 private:
     struct GPUParticle {
         glm::vec3 pos;
         float age01;
         float sizePx;
         float seed;
+        uint32_t color; // RGBA8
     };
 
 private:
@@ -128,19 +219,47 @@ private:
     bool shaderDirty = true;
 
     unsigned int vao = 0;
-    unsigned int vbo = 0;
-
-    std::vector<Particle> particles;
-    std::vector<GPUParticle> gpuBuffer;
+    StreamBuffer vertexRing{ sizeof(GPUParticle) };
+    unsigned int layoutBuffer = 0; // ring buffer the VAO's attributes point at
+
+    // Looked up once per linked program (optional ones may be -1; GL ignores those).
+    struct UniformLocations {
+        int viewProj = -1, time = -1, pointScale = -1, useFlipbook = -1;
+        int flipbook = -1, grid = -1, frameCount = -1, fps = -1;
+        int hasFlipbook2 = -1, flipbook2 = -1, grid2 = -1, frameCount2 = -1, fps2 = -1;
+    };
+    UniformLocations uniforms;
+    unsigned int uniformsProgram = 0;
+
+    // Depth sort scratch (grown, never shrunk): staged vertices and ping-pong key/index pairs.
+    std::vector<GPUParticle> sortVertices;
+    std::vector<uint32_t> sortKeys, sortKeysTmp;
+    std::vector<uint32_t> sortOrder, sortOrderTmp;
+
+    // GPU backend state (null on the CPU backend); the SoA pool below stays empty then.
+    SimBackend simBackend = SimBackend::CPU;
+    std::unique_ptr<ParticleGpuSim> gpuSim;
+
+    // Structure-of-arrays pool: [0, count) are live. Streams are sized to capacity rounded
+    // up to the kernel width; dead particles are overwritten by the last live one.
+    pac_particle_kernels::FloatStream posX, posY, posZ;
+    pac_particle_kernels::FloatStream velX, velY, velZ;
+    pac_particle_kernels::FloatStream life, maxLife, sizePx, seed;
+    std::vector<uint32_t> color; // RGBA8, not touched by the kernels
+    uint32_t count = 0;
+    uint32_t capacity = 0;
+    uint64_t droppedCount = 0;
 
     float timeSec = 0.0f;
     float pointScale = 220.0f;
 
+    RenderStats lastRenderStats{};
+
     RenderSettings renderSettings{};
     UpdateSettings updateSettings{};
 
     // Flipbook texture (optional)
-    unsigned int flipbookTex = 0;
+    TextureHandle flipbookTex;
     std::string flipbookPath = ""; // generic default: no file => 1x1 white tex
     int   flipbookCols = 1;
     int   flipbookRows = 1;
@@ -149,7 +268,7 @@ private:
     bool  flipbookDirty = true;
 
     // Secondary flipbook texture (optional)
-    unsigned int flipbookTex2 = 0;
+    TextureHandle flipbookTex2;
     std::string  flipbookPath2 = "";
     int   flipbookCols2 = 1;
     int   flipbookRows2 = 1;
@@ -161,7 +280,12 @@ private:
     bool useSecondaryFlipbook = false;
 
 private:
+    // update() without the GL init: integrate on the given kernel path, then drop the dead.
+    void simulate(float dt, pac_particle_kernels::Path path);
+
     void ensureFlipbookLoaded();
     void ensureSecondaryFlipbookLoaded();
     void ensureShaderLoaded();
+    void ensureUniformLocations();
+    void bindVertexLayout(); // VAO attributes -> the ring's current buffer
 };
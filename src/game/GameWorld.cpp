@@ -16,8 +16,10 @@
 #include "MovesConfigLoader.h"
 
 #include <cmath>
+#include <cstdlib>
 #include <limits>
 #include <algorithm>
+#include <iterator>
 
 // ✅ NEW: animset v2/v3 parser (drop-in)
 #include "AnimSetLoader.h"
@@ -36,6 +38,27 @@ void GameWorld::applyLevelScaling(PokemonInstance& inst, int level) const {
     inst.movementSpeed = inst.baseMovementSpeed * mult;
 }
 
+namespace {
+
+// Which units read poses from a Model's baked atlas (instanced path only).
+// PAC_ANIM_EVAL=live | baked | auto (default): auto bakes everything except board units
+// mid-attack, which are few and get the exact keyframed one-shot.
+enum class AnimEvalMode { Auto, Live, Baked };
+
+AnimEvalMode animEvalMode()
+{
+    static const AnimEvalMode mode = [] {
+        const char* env = std::getenv("PAC_ANIM_EVAL");
+        const std::string v = env ? env : "";
+        if (v == "live")  return AnimEvalMode::Live;
+        if (v == "baked") return AnimEvalMode::Baked;
+        return AnimEvalMode::Auto;
+    }();
+    return mode;
+}
+
+} // namespace
+
 static const LoadoutEntry* pickLoadoutForLevel(const PokemonStats& ps, int level) {
     const LoadoutEntry* best = nullptr;
 
@@ -87,13 +110,14 @@ void GameWorld::spawnPokemon(const std::string& pokemonName,
     }
 
     std::string path = "assets/models/" + stats->model;
-    auto sharedModel = ResourceManager::getInstance().getModel(path);
+    ModelHandle handle = ResourceManager::getInstance().requestModel(path);
 
     PokemonInstance inst;
     inst.id = PokemonInstance::getNextUnitID();
     inst.name = pokemonName;
     inst.position = startPos;
-    inst.model = sharedModel;
+    inst.modelHandle = handle;
+    inst.model = handle.get(); // null while streaming; resolveStreamedModels picks it up
 
     inst.rotation = glm::vec3(0.0f, (side == PokemonSide::Player ? 180.0f : 0.0f), 0.0f);
     inst.side = side;
@@ -108,6 +132,7 @@ void GameWorld::spawnPokemon(const std::string& pokemonName,
     inst.animTimeSec = 0.0f;
 
     // ✅ NEW: animset-v2/v3 roles/groups/categories support (optional file)
+    // (re-applied by resolveStreamedModels if the model is still streaming)
     AnimSet::applyAnimSetOverrides(inst, path);
 
     // Start looped animations in sync across all units
@@ -151,12 +176,13 @@ void GameWorld::addToBench(const std::string& pokemonName)
     }
 
     std::string path = "assets/models/" + stats->model;
-    auto sharedModel = ResourceManager::getInstance().getModel(path);
+    ModelHandle handle = ResourceManager::getInstance().requestModel(path);
 
     PokemonInstance inst;
     inst.id = PokemonInstance::getNextUnitID();
     inst.name = pokemonName;
-    inst.model = sharedModel;
+    inst.modelHandle = handle;
+    inst.model = handle.get(); // null while streaming; resolveStreamedModels picks it up
 
     inst.rotation = glm::vec3(0.0f, 180.0f, 0.0f);
     inst.side = PokemonSide::Player;
@@ -177,6 +203,7 @@ void GameWorld::addToBench(const std::string& pokemonName)
     inst.animTimeSec = 0.0f;
 
     // ✅ NEW: animset-v2/v3 roles/groups/categories support (optional file)
+    // (re-applied by resolveStreamedModels if the model is still streaming)
     AnimSet::applyAnimSetOverrides(inst, path);
 
     // Start looped animations in sync across all units
@@ -202,8 +229,24 @@ const PokemonInstance* GameWorld::getPokemonByName(const std::string& name) cons
 std::vector<PokemonInstance>& GameWorld::getPokemons() { return pokemons; }
 std::vector<PokemonInstance>& GameWorld::getBenchPokemons() { return benchPokemons; }
 
+void GameWorld::resolveStreamedModels()
+{
+    auto resolve = [&](PokemonInstance& p) {
+        if (p.model || !p.modelHandle.isReady()) return;
+
+        p.model = p.modelHandle.get();
+        AnimSet::applyAnimSetOverrides(p, p.modelHandle.getPath());
+        p.animTimeSec = sharedLoopAnimTimeSec;
+    };
+
+    for (auto& p : pokemons) resolve(p);
+    for (auto& p : benchPokemons) resolve(p);
+}
+
 void GameWorld::update(float dt)
 {
+    resolveStreamedModels();
+
     // Shared clock so all units loop idle/walk in sync
     sharedLoopAnimTimeSec += dt;
 
@@ -254,8 +297,8 @@ void GameWorld::update(float dt)
     for (auto& p : pokemons) tickPokemonAnim(p);
     for (auto& p : benchPokemons) tickPokemonAnim(p);
 
-    // tail fire particle update
-    charmanderTailFireVfx.update(dt, pokemons, benchPokemons);
+    // particle effects (attached emitters follow their units)
+    vfx.update(dt, pokemons, benchPokemons);
 }
 
 void GameWorld::drawAll(const Camera3D& camera, BoardRenderer& boardRenderer)
@@ -263,44 +306,131 @@ void GameWorld::drawAll(const Camera3D& camera, BoardRenderer& boardRenderer)
     boardRenderer.draw(camera);
     boardRenderer.drawBench(camera);
 
-    auto drawPokemonList = [&](const std::vector<PokemonInstance>& list) {
-        for (const auto& instance : list) {
-            if (!instance.alive || !instance.model) continue;
-
-            float scaleFactor = instance.model->getScaleFactor();
+    auto makeInstanceTransform = [](const PokemonInstance& instance) {
+        float scaleFactor = instance.model->getScaleFactor();
 
-            glm::mat4 scale = glm::scale(glm::mat4(1.0f), glm::vec3(scaleFactor));
-            glm::mat4 rotationX = glm::rotate(glm::mat4(1.0f), glm::radians(instance.rotation.x), glm::vec3(1, 0, 0));
-            glm::mat4 rotationY = glm::rotate(glm::mat4(1.0f), glm::radians(instance.rotation.y), glm::vec3(0, 1, 0));
-            glm::mat4 rotationZ = glm::rotate(glm::mat4(1.0f), glm::radians(instance.rotation.z), glm::vec3(0, 0, 1));
-            glm::mat4 translation = glm::translate(glm::mat4(1.0f), instance.position);
+        glm::mat4 scale = glm::scale(glm::mat4(1.0f), glm::vec3(scaleFactor));
+        glm::mat4 rotationX = glm::rotate(glm::mat4(1.0f), glm::radians(instance.rotation.x), glm::vec3(1, 0, 0));
+        glm::mat4 rotationY = glm::rotate(glm::mat4(1.0f), glm::radians(instance.rotation.y), glm::vec3(0, 1, 0));
+        glm::mat4 rotationZ = glm::rotate(glm::mat4(1.0f), glm::radians(instance.rotation.z), glm::vec3(0, 0, 1));
+        glm::mat4 translation = glm::translate(glm::mat4(1.0f), instance.position);
 
-            glm::mat4 instanceTransform = translation * rotationY * rotationX * rotationZ * scale;
+        return translation * rotationY * rotationX * rotationZ * scale;
+    };
 
-            instance.model->drawAnimated(camera, instanceTransform, instance.animTimeSec, instance.activeAnimIndex);
-        }
+    cullStats.unitsDrawn = cullStats.unitsCulled = 0;
+    animEvalStats = AnimEvalStats{};
+    const Frustum& frustum = camera.getFrustum();
+    const bool cull = Frustum::isCullingEnabled();
+
+    // Empty bounds (nothing computed for this model) always draw.
+    auto isVisible = [&](const PokemonInstance& instance, const glm::mat4& transform) {
+        if (!cull) return true;
+        const Aabb bounds = instance.model->getWorldBounds(transform, instance.activeAnimIndex);
+        if (bounds.isEmpty() || frustum.intersectsAabb(bounds)) return true;
+        ++cullStats.unitsCulled;
+        return false;
     };
 
-    drawPokemonList(pokemons);
-    drawPokemonList(benchPokemons);
+    if (!Model::isInstancingEnabled()) {
+        auto drawPokemonList = [&](const std::vector<PokemonInstance>& list) {
+            for (const auto& instance : list) {
+                if (!instance.alive || !instance.model) continue;
+                const glm::mat4 transform = makeInstanceTransform(instance);
+                if (!isVisible(instance, transform)) continue;
+
+                ++cullStats.unitsDrawn;
+                instance.model->drawAnimated(camera, transform, instance.animTimeSec, instance.activeAnimIndex);
+            }
+        };
+
+        drawPokemonList(pokemons);
+        drawPokemonList(benchPokemons);
+    } else {
+        // Group by Model so draw calls scale with species count, not unit count.
+        for (auto& batch : modelDrawBatches) batch.second.clear();
+
+        const AnimEvalMode evalMode = animEvalMode();
+
+        auto collect = [&](const std::vector<PokemonInstance>& list, bool bench) {
+            for (const auto& instance : list) {
+                if (!instance.alive || !instance.model) continue;
+                const glm::mat4 transform = makeInstanceTransform(instance);
+                if (!isVisible(instance, transform)) continue;
+                ++cullStats.unitsDrawn;
+
+                const Model* model = instance.model.get();
+                auto it = std::find_if(modelDrawBatches.begin(), modelDrawBatches.end(),
+                                       [&](const auto& b) { return b.first == model; });
+                if (it == modelDrawBatches.end()) {
+                    modelDrawBatches.emplace_back(model, std::vector<Model::DrawInstance>{});
+                    it = std::prev(modelDrawBatches.end());
+                }
+
+                Model::DrawInstance di;
+                di.transform   = transform;
+                di.animTimeSec = instance.animTimeSec;
+                di.animIndex   = instance.activeAnimIndex;
+                di.baked       = model->hasBakedAnimation() &&
+                                 (evalMode == AnimEvalMode::Baked ||
+                                  (evalMode == AnimEvalMode::Auto && (bench || instance.attackTimerSec <= 0.0f)));
+                ++(di.baked ? animEvalStats.baked : animEvalStats.live);
+                it->second.push_back(di);
+            }
+        };
+
+        collect(pokemons, false);
+        collect(benchPokemons, true);
+
+        // Species that left the board drop their batch (and its stale Model pointer).
+        modelDrawBatches.erase(std::remove_if(modelDrawBatches.begin(), modelDrawBatches.end(),
+                                              [](const auto& b) { return b.second.empty(); }),
+                               modelDrawBatches.end());
+
+        // One sorted list across all models: every opaque draw, then blended back-to-front.
+        renderQueue.begin(camera);
+        for (const auto& batch : modelDrawBatches)
+            batch.first->submitInstanced(renderQueue, batch.second);
+        renderQueue.flush();
+    }
 
     // draw particles AFTER opaque models
-    charmanderTailFireVfx.render(camera);
+    vfx.render(camera);
+    cullStats.particlesDrawn  = vfx.getStats().drawn;
+    cullStats.particlesCulled = vfx.getStats().culled;
+}
+
+void GameWorld::playMoveHitVfx(const std::string& moveName, int targetId)
+{
+    auto it = std::find_if(pokemons.begin(), pokemons.end(),
+                           [&](const PokemonInstance& p) { return p.id == targetId; });
+    if (it == pokemons.end()) return;
+    vfx.triggerMoveHit(moveName, *it);
 }
 
 std::vector<HealthBarData> GameWorld::getHealthBarData(const Camera3D& camera, int screenWidth, int screenHeight) const
 {
     std::vector<HealthBarData> data;
+    cullStats.healthBarsDrawn = cullStats.healthBarsCulled = 0;
+
+    const Frustum& frustum = camera.getFrustum();
+    const glm::mat4& viewProj = camera.getViewProjectionMatrix();
 
     auto process = [&](const PokemonInstance& instance) {
         if (!instance.alive) return;
 
+        // Anchor inside the frustum <=> on screen and between the near and far planes.
         glm::vec3 worldPos = instance.position + glm::vec3(0.0f, 1.0f, 0.0f);
-        glm::vec4 viewport(0.0f, 0.0f, screenWidth, screenHeight);
-        glm::vec3 screenPos = glm::project(worldPos, camera.getViewMatrix(), camera.getProjectionMatrix(), viewport);
-
-        if (screenPos.z > 1.0f || screenPos.x < 0 || screenPos.x > screenWidth || screenPos.y < 0 || screenPos.y > screenHeight)
+        if (!frustum.containsPoint(worldPos)) {
+            ++cullStats.healthBarsCulled;
             return;
+        }
+        ++cullStats.healthBarsDrawn;
+
+        const glm::vec4 clip = viewProj * glm::vec4(worldPos, 1.0f);
+        const glm::vec2 ndc = glm::vec2(clip.x, clip.y) / clip.w;
+        const glm::vec2 screenPos((ndc.x * 0.5f + 0.5f) * (float)screenWidth,
+                                  (ndc.y * 0.5f + 0.5f) * (float)screenHeight);
 
         HealthBarData hb;
         hb.screenPosition = glm::vec2(screenPos.x, screenHeight - screenPos.y);
@@ -3,13 +3,15 @@
 
 #include <vector>
 #include <string>
+#include <utility>
 #include <glm/glm.hpp>
 
 #include "PokemonInstance.h"
 #include "./engine/ui/HealthBarData.h"
+#include "./engine/render/Model.h"
 
-// Charmander tail fire particle VFX
-#include "vfx/CharmanderTailFireVFX.h"
+// Data-driven particle effects (config/vfx_config.json)
+#include "vfx/VfxManager.h"
 
 class Camera3D;
 class BoardRenderer;
@@ -41,6 +43,33 @@ public:
 
     glm::vec3 getNearestEnemyPosition(const PokemonInstance& unit) const;
 
+    // Hit burst for `moveName` on the target (no-op for moves without a hit effect).
+    void playMoveHitVfx(const std::string& moveName, int targetId);
+
+    const VfxManager::Stats& getVfxStats() const { return vfx.getStats(); }
+
+    // Last flushed frame of the instanced unit pass (draw items, triangles after LOD).
+    const RenderQueue::Stats& getRenderStats() const { return renderQueue.getLastStats(); }
+
+    // Last frame's frustum culling (drawAll + getHealthBarData). Units are tested with their
+    // clip's skinned AABB, health bars at their anchor, VFX particles as spheres.
+    struct CullStats {
+        uint32_t unitsDrawn = 0;
+        uint32_t unitsCulled = 0;
+        uint32_t healthBarsDrawn = 0;
+        uint32_t healthBarsCulled = 0;
+        uint32_t particlesDrawn = 0;
+        uint32_t particlesCulled = 0;
+    };
+    const CullStats& getCullStats() const { return cullStats; }
+
+    // Last frame's instanced units by pose source (see PAC_ANIM_EVAL in GameWorld.cpp).
+    struct AnimEvalStats {
+        uint32_t baked = 0; // atlas lookup in model.vert, no CPU sampling
+        uint32_t live = 0;  // shared pose cache
+    };
+    const AnimEvalStats& getAnimEvalStats() const { return animEvalStats; }
+
 private:
     std::vector<PokemonInstance> pokemons;
     std::vector<PokemonInstance> benchPokemons;
@@ -49,11 +78,22 @@ private:
 
     void applyLevelScaling(PokemonInstance& inst, int level) const;
     void applyLoadoutForLevel(PokemonInstance& inst) const;
+    // Units spawned while their model was streaming get it (and their animset) once ready.
+    void resolveStreamedModels();
 
 private:
     // Shared loop clock: keeps idle/walk animations in sync across all units.
     float sharedLoopAnimTimeSec = 0.0f;
 
-    // Tail fire particles (drawn after opaque models)
-    CharmanderTailFireVFX charmanderTailFireVfx;
+    // Per-frame instanced draw batches, one per distinct Model (first-seen order).
+    // Vectors are reused across frames to avoid reallocating every draw.
+    std::vector<std::pair<const Model*, std::vector<Model::DrawInstance>>> modelDrawBatches;
+    RenderQueue renderQueue;
+
+    // Health bar counters are filled by the const getHealthBarData.
+    mutable CullStats cullStats;
+    AnimEvalStats animEvalStats;
+
+    // Every particle effect, one draw per shader/blend/atlas batch (drawn after opaque models)
+    VfxManager vfx;
 };
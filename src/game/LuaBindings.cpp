@@ -243,7 +243,9 @@ void registerLuaBindings(sol::state& lua, GameWorld* world, GameStateManager* ma
         return arr;
     });
 
-    lua.set_function("world_apply_damage", [world](int attackerId, int targetId, int amount) {
+    // Optional moveName plays that move's hit effect on the target (config/vfx_config.json).
+    lua.set_function("world_apply_damage", [world](int attackerId, int targetId, int amount,
+                                                   sol::optional<std::string> moveName) {
         if (!world) return -1;
 
         auto& list = world->getPokemons();
@@ -265,6 +267,8 @@ void registerLuaBindings(sol::state& lua, GameWorld* world, GameStateManager* ma
             A->activeAnimIndex = A->animAttack1Index;
         }
 
+        if (moveName) world->playMoveHitVfx(*moveName, targetId);
+
         T->hp = std::max(0, T->hp - std::max(0, amount));
         if (T->hp == 0) {
             T->alive = false;
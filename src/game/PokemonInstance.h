@@ -6,6 +6,8 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 
+#include "engine/utils/ResourceManager.h"
+
 class Model;
 
 enum class PokemonSide {
@@ -17,7 +19,8 @@ struct PokemonInstance {
     // identity
     int id = 0;
     std::string name;
-    std::shared_ptr<Model> model;
+    std::shared_ptr<Model> model;  // null until modelHandle is ready (unit is skipped)
+    ModelHandle modelHandle;
 
     // transform (world)
     glm::vec3 position{0.0f};
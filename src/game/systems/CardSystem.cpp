@@ -3,6 +3,7 @@
 #include "CardSystem.h"
 #include "../../engine/ui/UIManager.h"
 #include "../../engine/utils/Shader.h"
+#include "../../engine/render/GLStateCache.h"
 
 #include <glad/glad.h>
 #include <glm/gtc/matrix_transform.hpp>
@@ -31,8 +32,9 @@ void CardSystem::render(int screenWidth, int screenHeight) {
 
     // --- Ensure UI renders on top of the 3D scene ---
     // We temporarily disable depth testing for 2D overlay draw.
-    GLboolean wasDepthTestEnabled = glIsEnabled(GL_DEPTH_TEST);
-    if (wasDepthTestEnabled) glDisable(GL_DEPTH_TEST);
+    auto& gl = GLStateCache::getInstance();
+    const bool wasDepthTestEnabled = gl.isEnabled(GL_DEPTH_TEST);
+    gl.disable(GL_DEPTH_TEST);
 
     glm::mat4 ortho = glm::ortho(
         0.0f, static_cast<float>(screenWidth),
@@ -47,10 +49,10 @@ void CardSystem::render(int screenWidth, int screenHeight) {
         card.draw(cardShader);
     }
 
-    glUseProgram(0);
+    gl.useProgram(0);
 
     // Restore previous depth state
-    if (wasDepthTestEnabled) glEnable(GL_DEPTH_TEST);
+    gl.setEnabled(GL_DEPTH_TEST, wasDepthTestEnabled);
 }
 
 std::optional<CardData> CardSystem::handleMouseClick(int mouseX, int mouseY) {
@@ -0,0 +1,355 @@
+// src/game/vfx/VfxManager.cpp
+#include "VfxManager.h"
+
+#include "engine/render/Model.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+static float hash01(float x) {
+    float s = std::sin(x * 12.9898f) * 43758.5453f;
+    return s - std::floor(s);
+}
+
+static float hashSigned(float x) {
+    return hash01(x) * 2.0f - 1.0f;
+}
+
+static std::string toLowerAscii(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(),
+        [](unsigned char c) { return (char)std::tolower(c); });
+    return s;
+}
+
+static glm::mat4 computeInstanceTransform(const PokemonInstance& instance) {
+    float scaleFactor = 1.0f;
+    if (instance.model) scaleFactor = instance.model->getScaleFactor();
+
+    glm::mat4 scale = glm::scale(glm::mat4(1.0f), glm::vec3(scaleFactor));
+    glm::mat4 rotationX = glm::rotate(glm::mat4(1.0f), glm::radians(instance.rotation.x), glm::vec3(1, 0, 0));
+    glm::mat4 rotationY = glm::rotate(glm::mat4(1.0f), glm::radians(instance.rotation.y), glm::vec3(0, 1, 0));
+    glm::mat4 rotationZ = glm::rotate(glm::mat4(1.0f), glm::radians(instance.rotation.z), glm::vec3(0, 0, 1));
+    glm::mat4 translation = glm::translate(glm::mat4(1.0f), instance.position);
+
+    return translation * rotationY * rotationX * rotationZ * scale;
+}
+
+// ---- JSON helpers (missing or malformed fields keep the default) ----
+
+static glm::vec2 readVec2(const nlohmann::json& j, const char* key, glm::vec2 def) {
+    if (!j.contains(key)) return def;
+    const auto& v = j[key];
+    if (v.is_number()) return glm::vec2(v.get<float>());
+    if (v.is_array() && v.size() == 2) return glm::vec2(v[0].get<float>(), v[1].get<float>());
+    return def;
+}
+
+static glm::vec3 readVec3(const nlohmann::json& j, const char* key, glm::vec3 def) {
+    if (!j.contains(key)) return def;
+    const auto& v = j[key];
+    if (v.is_array() && v.size() == 3) return glm::vec3(v[0].get<float>(), v[1].get<float>(), v[2].get<float>());
+    return def;
+}
+
+static glm::vec4 readColor(const nlohmann::json& j, const char* key, glm::vec4 def) {
+    if (!j.contains(key)) return def;
+    const auto& v = j[key];
+    if (v.is_array() && v.size() == 3) return glm::vec4(v[0].get<float>(), v[1].get<float>(), v[2].get<float>(), 1.0f);
+    if (v.is_array() && v.size() == 4) return glm::vec4(v[0].get<float>(), v[1].get<float>(), v[2].get<float>(), v[3].get<float>());
+    return def;
+}
+
+static std::vector<std::string> readNames(const nlohmann::json& j, const char* key) {
+    std::vector<std::string> out;
+    if (!j.contains(key) || !j[key].is_array()) return out;
+    for (const auto& n : j[key]) {
+        if (n.is_string()) out.push_back(toLowerAscii(n.get<std::string>()));
+    }
+    return out;
+}
+
+static ParticleSystem::BlendMode readBlend(const std::string& s) {
+    if (s == "additive") return ParticleSystem::BlendMode::Additive;
+    if (s == "premultiplied") return ParticleSystem::BlendMode::Premultiplied;
+    return ParticleSystem::BlendMode::Alpha;
+}
+
+static VfxManager::EmitterDef parseEmitter(const nlohmann::json& e) {
+    VfxManager::EmitterDef d;
+    d.name = e.value("name", "");
+    d.trigger = (e.value("trigger", "attached") == "moveHit") ? VfxManager::Trigger::MoveHit
+                                                               : VfxManager::Trigger::Attached;
+    d.species = readNames(e, "species");
+    d.moves = readNames(e, "moves");
+    d.node = e.value("node", -1);
+    d.clip = e.value("clip", -1);
+    d.offset = readVec3(e, "offset", d.offset);
+    d.worldYOffset = e.value("worldYOffset", d.worldYOffset);
+
+    d.ratePerSec = e.value("rate", d.ratePerSec);
+    d.burstCount = e.value("count", d.burstCount);
+    d.spawnRadius = e.value("spawnRadius", d.spawnRadius);
+    d.spawnScale = readVec3(e, "spawnScale", d.spawnScale);
+    d.velocityMin = readVec3(e, "velocityMin", d.velocityMin);
+    d.velocityMax = readVec3(e, "velocityMax", d.velocityMin);
+    d.radialSpeed = readVec2(e, "radialSpeed", d.radialSpeed);
+    d.lifeSec = readVec2(e, "life", d.lifeSec);
+    d.size = readVec2(e, "size", d.size);
+    d.sizeScalesWithModel = e.value("sizeScalesWithModel", d.sizeScalesWithModel);
+    d.color = readColor(e, "color", d.color);
+
+    d.vertShaderPath = e.value("vert", d.vertShaderPath);
+    d.fragShaderPath = e.value("frag", d.fragShaderPath);
+    if (e.contains("flipbook") && e["flipbook"].is_object()) {
+        const auto& f = e["flipbook"];
+        d.useFlipbook = true;
+        d.flipbookPath = f.value("path", "");
+        d.flipbookCols = f.value("cols", 1);
+        d.flipbookRows = f.value("rows", 1);
+        d.flipbookFrames = f.value("frames", 1);
+        d.flipbookFps = f.value("fps", 0.0f);
+    }
+    if (d.useFlipbook && e.contains("flipbook2") && e["flipbook2"].is_object()) {
+        const auto& f = e["flipbook2"];
+        d.flipbook2Path = f.value("path", "");
+        d.flipbook2Cols = f.value("cols", 1);
+        d.flipbook2Rows = f.value("rows", 1);
+        d.flipbook2Frames = f.value("frames", 1);
+        d.flipbook2Fps = f.value("fps", 0.0f);
+    }
+    d.render.blend = readBlend(e.value("blend", "alpha"));
+    d.render.depthTest = e.value("depthTest", d.render.depthTest);
+    d.render.depthWrite = e.value("depthWrite", d.render.depthWrite);
+    d.render.sortBackToFront = e.value("sort", d.render.sortBackToFront);
+
+    const std::string sim = e.value("simulation", "");
+    if (sim == "gpu") d.simBackend = ParticleSystem::SimBackend::GPU;
+    else if (sim == "cpu") d.simBackend = ParticleSystem::SimBackend::CPU;
+
+    d.update.acceleration = readVec3(e, "acceleration", d.update.acceleration);
+    d.update.dampingBase = e.value("dampingBase", d.update.dampingBase);
+    d.pointScale = e.value("pointScale", d.pointScale);
+    d.capacity = e.value("capacity", d.capacity);
+    return d;
+}
+
+std::string VfxManager::batchKey(const EmitterDef& d) {
+    std::ostringstream k;
+    k << d.vertShaderPath << '|' << d.fragShaderPath
+      << '|' << (int)d.render.blend << d.render.depthTest << d.render.depthWrite << d.render.programPointSize
+      << '|' << d.useFlipbook;
+    if (d.useFlipbook) {
+        k << '|' << d.flipbookPath << ' ' << d.flipbookCols << 'x' << d.flipbookRows
+          << ' ' << d.flipbookFrames << '@' << d.flipbookFps
+          << '|' << d.flipbook2Path << ' ' << d.flipbook2Cols << 'x' << d.flipbook2Rows
+          << ' ' << d.flipbook2Frames << '@' << d.flipbook2Fps;
+    }
+    return k.str();
+}
+
+bool VfxManager::loadConfig(const std::string& filePath) {
+    loadAttempted = true;
+
+    std::ifstream file(filePath);
+    if (!file.is_open()) {
+        std::cerr << "[VfxManager] Failed to open: " << filePath << "\n";
+        return false;
+    }
+    nlohmann::json j = nlohmann::json::parse(file, nullptr, false);
+    if (j.is_discarded() || !j.contains("emitters") || !j["emitters"].is_array()) {
+        std::cerr << "[VfxManager] No \"emitters\" list in: " << filePath << "\n";
+        return false;
+    }
+
+    emitters.clear();
+    batches.clear();
+    moveHitEmitters.clear();
+    stats = Stats{};
+
+    for (const auto& e : j["emitters"]) {
+        if (!e.is_object()) continue;
+
+        auto state = std::make_unique<EmitterState>();
+        state->def = parseEmitter(e);
+        const EmitterDef& d = state->def;
+
+        state->sim.setSimBackend(d.simBackend);
+        state->sim.setCapacity(d.capacity);
+        state->sim.setUpdateSettings(d.update);
+        state->sim.setPointScale(d.pointScale);
+        state->sim.setRenderSettings(d.render); // only sortBackToFront is read from sources
+
+        const std::string key = batchKey(d);
+        auto it = std::find_if(batches.begin(), batches.end(),
+                               [&](const auto& b) { return b->key == key; });
+        if (it == batches.end()) {
+            auto batch = std::make_unique<Batch>();
+            batch->key = key;
+
+            ParticleSystem& r = batch->renderer;
+            r.setShaderPaths(d.vertShaderPath, d.fragShaderPath);
+            r.setUseFlipbook(d.useFlipbook);
+            if (d.useFlipbook) {
+                r.setFlipbook(d.flipbookPath, d.flipbookCols, d.flipbookRows, d.flipbookFrames, d.flipbookFps);
+            }
+            r.setSecondaryFlipbook(d.flipbook2Path, d.flipbook2Cols, d.flipbook2Rows, d.flipbook2Frames, d.flipbook2Fps);
+            r.setRenderSettings(d.render);
+            r.setPointScale(d.pointScale);
+
+            batches.push_back(std::move(batch));
+            it = batches.end() - 1;
+        }
+        state->batch = (int)(it - batches.begin());
+        (*it)->sources.push_back(&state->sim);
+
+        const int index = (int)emitters.size();
+        if (d.trigger == Trigger::MoveHit) {
+            for (const auto& m : d.moves) moveHitEmitters[m].push_back(index);
+        }
+        emitters.push_back(std::move(state));
+    }
+
+    stats.emitters = (uint32_t)emitters.size();
+    stats.batches = (uint32_t)batches.size();
+    std::cout << "[VfxManager] Loaded " << emitters.size() << " emitters in "
+              << batches.size() << " batches\n";
+    return true;
+}
+
+void VfxManager::update(float dt,
+                        const std::vector<PokemonInstance>& boardUnits,
+                        const std::vector<PokemonInstance>& benchUnits)
+{
+    if (!loadAttempted) loadConfig(kDefaultConfigPath);
+
+    // Renderers only carry the shader clock.
+    for (auto& b : batches) b->renderer.step(dt);
+
+    stats.particles = 0;
+    stats.dropped = 0;
+    for (auto& e : emitters) {
+        e->sim.step(dt);
+        if (e->def.trigger == Trigger::Attached) {
+            emitAttached(dt, *e, boardUnits);
+            emitAttached(dt, *e, benchUnits);
+        }
+        stats.particles += e->sim.getParticleCount();
+        stats.dropped += e->sim.getDroppedCount();
+    }
+}
+
+void VfxManager::emitAttached(float dt, EmitterState& e, const std::vector<PokemonInstance>& list) {
+    const EmitterDef& d = e.def;
+    dt = std::clamp(dt, 0.0f, 0.05f);
+
+    for (const auto& u : list) {
+        if (!u.alive || !u.model) continue;
+        if (!d.species.empty() &&
+            std::find(d.species.begin(), d.species.end(), toLowerAscii(u.name)) == d.species.end()) continue;
+
+        float& acc = e.emitAccumulator[u.id];
+        acc += dt * d.ratePerSec;
+
+        int spawnCount = (int)std::floor(acc);
+        if (spawnCount <= 0) continue;
+        acc -= (float)spawnCount;
+
+        glm::mat4 instM = computeInstanceTransform(u);
+
+        glm::mat4 nodeGlobal(1.0f);
+        glm::vec3 anchor(0.0f);
+
+        const int socket = (d.node >= 0) ? u.model->getSocket(d.node) : -1;
+        const int clip = (d.clip >= 0) ? d.clip : u.activeAnimIndex;
+        if (socket >= 0 && u.model->evaluateSocket(socket, u.animTimeSec, clip, nodeGlobal)) {
+            anchor = glm::vec3(instM * nodeGlobal * glm::vec4(0, 0, 0, 1));
+        } else {
+            anchor = glm::vec3(instM * glm::vec4(d.offset, 1.0f));
+        }
+        anchor.y += d.worldYOffset;
+
+        const float scale = d.sizeScalesWithModel ? u.model->getScaleFactor() : 1.0f;
+
+        uint32_t& serial = e.spawnSerial[u.id];
+        spawn(e, anchor, scale, (float)u.id * 100000.0f + (float)serial, spawnCount);
+        serial += (uint32_t)spawnCount;
+    }
+}
+
+void VfxManager::spawn(EmitterState& e, const glm::vec3& anchor, float scale, float base, int count) {
+    const EmitterDef& d = e.def;
+
+    for (int i = 0; i < count; ++i, base += 1.0f) {
+        const glm::vec3 r = glm::vec3(hashSigned(base + 1.0f),
+                                      hash01(base + 2.0f),
+                                      hashSigned(base + 3.0f)) * d.spawnScale * d.spawnRadius;
+
+        ParticleSystem::Particle p;
+        p.pos = anchor + r;
+
+        p.vel = glm::mix(d.velocityMin, d.velocityMax,
+                         glm::vec3(hash01(base + 4.0f), hash01(base + 5.0f), hash01(base + 6.0f)));
+        if (d.radialSpeed.y > 0.0f) {
+            const float len = glm::length(r);
+            if (len > 1e-6f) {
+                p.vel += (r / len) * glm::mix(d.radialSpeed.x, d.radialSpeed.y, hash01(base + 10.0f));
+            }
+        }
+
+        p.maxLifeSec = glm::mix(d.lifeSec.x, d.lifeSec.y, hash01(base + 7.0f));
+        p.lifeSec = p.maxLifeSec;
+        p.sizePx = glm::mix(d.size.x, d.size.y, hash01(base + 8.0f)) * scale;
+        p.seed = hash01(base + 9.0f);
+        p.color = d.color;
+
+        e.sim.emit(p);
+    }
+}
+
+void VfxManager::triggerMoveHit(const std::string& moveName, const PokemonInstance& target) {
+    if (!loadAttempted) loadConfig(kDefaultConfigPath);
+
+    auto it = moveHitEmitters.find(toLowerAscii(moveName));
+    if (it == moveHitEmitters.end()) return;
+
+    for (int index : it->second) {
+        EmitterState& e = *emitters[(size_t)index];
+        const EmitterDef& d = e.def;
+
+        glm::vec3 anchor = target.model ? glm::vec3(computeInstanceTransform(target) * glm::vec4(d.offset, 1.0f))
+                                        : target.position;
+        anchor.y += d.worldYOffset;
+
+        const float scale = (d.sizeScalesWithModel && target.model) ? target.model->getScaleFactor() : 1.0f;
+        const int count = std::max(0, d.burstCount);
+
+        // Keep hash inputs small (float precision) and distinct per emitter.
+        spawn(e, anchor, scale, (float)(e.burstSerial % 100000u) + 7919.0f * (float)index, count);
+        e.burstSerial += (uint32_t)count;
+    }
+}
+
+void VfxManager::render(const Camera3D& camera) {
+    stats.drawn = 0;
+    stats.culled = 0;
+    stats.drawCalls = 0;
+    stats.sorted = 0;
+    stats.sortMs = 0.0;
+
+    for (auto& b : batches) {
+        b->renderer.render(camera, b->sources);
+        const auto& rs = b->renderer.getLastRenderStats();
+        stats.drawn += rs.drawn;
+        stats.culled += rs.culled;
+        stats.sorted += rs.sorted;
+        stats.sortMs += rs.sortMs;
+        stats.drawCalls += rs.drawCalls;
+    }
+}
@@ -0,0 +1,148 @@
+// src/game/vfx/VfxManager.h
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <string>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "game/PokemonInstance.h"
+#include "engine/vfx/ParticleSystem.h"
+
+class Camera3D;
+
+// Every particle effect in the game, defined in config/vfx_config.json.
+//
+// Each emitter simulates into its own CPU-only ParticleSystem (no GL objects). Emitters
+// whose shaders, blend/depth state and flipbooks match form a batch: one renderer
+// ParticleSystem that uploads all of their particles into its vertex buffer and draws
+// them with a single call. Adding emitters or effect instances adds no draw calls unless
+// it introduces a new batch key.
+class VfxManager {
+public:
+    enum class Trigger {
+        Attached, // continuous, follows every matching unit (optionally a joint)
+        MoveHit   // one burst on the target when a listed move lands
+    };
+
+    struct EmitterDef {
+        std::string name;
+        Trigger trigger = Trigger::Attached;
+
+        // Attached: species filter (lower case, empty = every unit) and anchor.
+        // The anchor is the origin of node `node` sampled from clip `clip` (-1 = the unit's
+        // current clip); `offset` (model space) is used when there's no such node.
+        std::vector<std::string> species;
+        int node = -1;
+        int clip = -1;
+        glm::vec3 offset = glm::vec3(0.0f);
+
+        // MoveHit: move names from moves_config.json.
+        std::vector<std::string> moves;
+
+        float worldYOffset = 0.0f;
+
+        float ratePerSec = 0.0f; // Attached
+        int   burstCount = 0;    // MoveHit
+
+        // Spawn offset per axis: spawnRadius * spawnScale * (signed, 0..1, signed) hash.
+        float spawnRadius = 0.0f;
+        glm::vec3 spawnScale = glm::vec3(1.0f);
+
+        // World-space velocity, uniform per axis, plus speed away from the anchor.
+        glm::vec3 velocityMin = glm::vec3(0.0f);
+        glm::vec3 velocityMax = glm::vec3(0.0f);
+        glm::vec2 radialSpeed = glm::vec2(0.0f);
+
+        glm::vec2 lifeSec = glm::vec2(0.5f);
+        glm::vec2 size = glm::vec2(0.2f);
+        bool sizeScalesWithModel = true;
+        glm::vec4 color = glm::vec4(1.0f);
+
+        // Batch key
+        std::string vertShaderPath = "assets/shaders/vfx/particle.vert";
+        std::string fragShaderPath = "assets/shaders/vfx/particle.frag";
+        bool useFlipbook = false;
+        std::string flipbookPath;
+        int   flipbookCols = 1;
+        int   flipbookRows = 1;
+        int   flipbookFrames = 1;
+        float flipbookFps = 0.0f;
+        std::string flipbook2Path; // empty = no secondary atlas
+        int   flipbook2Cols = 1;
+        int   flipbook2Rows = 1;
+        int   flipbook2Frames = 1;
+        float flipbook2Fps = 0.0f;
+        ParticleSystem::RenderSettings render{};
+
+        // Per emitter (not part of the batch key)
+        ParticleSystem::SimBackend simBackend = ParticleSystem::defaultSimBackend();
+        ParticleSystem::UpdateSettings update{};
+        float pointScale = 220.0f;
+        uint32_t capacity = ParticleSystem::kDefaultCapacity;
+    };
+
+    struct Stats {
+        uint32_t emitters = 0;
+        uint32_t batches = 0;   // renderers (one per render-settings key)
+        uint32_t drawCalls = 0; // issued by the last render(): GPU-simulated emitters draw alone
+        uint32_t particles = 0; // live, all emitters
+        uint32_t drawn = 0;
+        uint32_t culled = 0;
+        uint32_t sorted = 0;    // depth-sorted by the last render()
+        double   sortMs = 0.0;
+        uint64_t dropped = 0;   // emits lost to full pools, since load
+    };
+
+    static constexpr const char* kDefaultConfigPath = "config/vfx_config.json";
+
+public:
+    VfxManager() = default;
+
+    // Replaces every emitter (and its live particles). Called lazily with
+    // kDefaultConfigPath by the first update() when nothing was loaded.
+    bool loadConfig(const std::string& filePath);
+
+    void update(float dt,
+                const std::vector<PokemonInstance>& boardUnits,
+                const std::vector<PokemonInstance>& benchUnits);
+
+    void render(const Camera3D& camera);
+
+    // Bursts every MoveHit emitter listing `moveName` on the target (at its `offset`).
+    void triggerMoveHit(const std::string& moveName, const PokemonInstance& target);
+
+    const Stats& getStats() const { return stats; }
+
+private:
+    struct EmitterState {
+        EmitterDef def;
+        ParticleSystem sim; // never initialized: simulated here (CPU or GPU backend), drawn by its batch
+        int batch = -1;
+
+        std::unordered_map<int, float> emitAccumulator; // per unit id
+        std::unordered_map<int, uint32_t> spawnSerial;  // per unit id
+        uint32_t burstSerial = 0;
+    };
+
+    struct Batch {
+        std::string key;
+        ParticleSystem renderer; // owns the VAO/VBO, shader and flipbooks; never emits
+        std::vector<const ParticleSystem*> sources;
+    };
+
+    void emitAttached(float dt, EmitterState& e, const std::vector<PokemonInstance>& list);
+    void spawn(EmitterState& e, const glm::vec3& anchor, float scale, float base, int count);
+    static std::string batchKey(const EmitterDef& def);
+
+private:
+    std::vector<std::unique_ptr<EmitterState>> emitters;
+    std::vector<std::unique_ptr<Batch>> batches;
+
+    std::unordered_map<std::string, std::vector<int>> moveHitEmitters; // move name -> emitters
+
+    bool loadAttempted = false;
+    Stats stats{};
+};
@@ -0,0 +1,71 @@
+// src/tools/HeadlessGL.cpp
+
+#include "HeadlessGL.h"
+
+#include "engine/render/GLStateCache.h"
+
+#define SDL_MAIN_HANDLED
+#include <SDL2/SDL.h>
+#include <glad/glad.h>
+
+#include <iostream>
+#include <string>
+
+namespace {
+
+bool tryCreate(SDL_Window*& window, SDL_GLContext& context)
+{
+    if (SDL_Init(SDL_INIT_VIDEO) < 0) return false;
+
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 3);
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 3);
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
+
+    window = SDL_CreateWindow("pac headless", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
+                              64, 64, SDL_WINDOW_OPENGL | SDL_WINDOW_HIDDEN);
+    if (window) context = SDL_GL_CreateContext(window);
+    if (context) return true;
+
+    if (window) SDL_DestroyWindow(window);
+    window = nullptr;
+    SDL_Quit();
+    return false;
+}
+
+} // namespace
+
+HeadlessGL::~HeadlessGL() {
+    if (context) SDL_GL_DeleteContext(context);
+    if (window) SDL_DestroyWindow(window);
+    if (sdlInitialized) SDL_Quit();
+}
+
+bool HeadlessGL::create(const char* tag) {
+    if (context) return true;
+
+    SDL_GLContext ctx = nullptr;
+    if (!tryCreate(window, ctx)) {
+        // No display (CI, ssh): SDL's offscreen driver still creates EGL contexts.
+        const std::string firstError = SDL_GetError();
+        SDL_SetHint(SDL_HINT_VIDEODRIVER, "offscreen");
+        if (!tryCreate(window, ctx)) {
+            std::cerr << "[" << tag << "] no GL 3.3 context: " << firstError
+                      << " / offscreen: " << SDL_GetError() << "\n";
+            return false;
+        }
+    }
+    context = ctx;
+    sdlInitialized = true;
+
+    SDL_GL_MakeCurrent(window, ctx);
+    if (!gladLoadGLLoader((GLADloadproc)SDL_GL_GetProcAddress)) {
+        std::cerr << "[" << tag << "] failed to initialize GLAD\n";
+        return false;
+    }
+
+    GLStateCache::getInstance().syncFromGL();
+
+    std::cout << "[" << tag << "] GL " << (const char*)glGetString(GL_VERSION)
+              << " / " << (const char*)glGetString(GL_RENDERER) << "\n";
+    return true;
+}
@@ -0,0 +1,28 @@
+// src/tools/HeadlessGL.h
+//
+// GL 3.3 core context behind a hidden SDL window, for command-line tools that need GL
+// but no game (pac_particle_check, pac_bench). Without a display, SDL's offscreen driver
+// is tried next, so the tools also run on headless Mesa (llvmpipe) machines.
+#pragma once
+
+struct SDL_Window;
+
+class HeadlessGL {
+public:
+    HeadlessGL() = default;
+    ~HeadlessGL();
+
+    HeadlessGL(const HeadlessGL&) = delete;
+    HeadlessGL& operator=(const HeadlessGL&) = delete;
+
+    // Creates the context, loads GL through glad and seeds GLStateCache. On failure prints
+    // the reason to stderr (prefixed with tag) and returns false.
+    bool create(const char* tag);
+
+    bool isCreated() const { return context != nullptr; }
+
+private:
+    SDL_Window* window = nullptr;
+    void* context = nullptr; // SDL_GLContext
+    bool sdlInitialized = false;
+};
@@ -0,0 +1,258 @@
+// src/tools/PacBench.cpp
+//
+// pac_bench: engine microbenchmarks, outside the game.
+//
+//   pac_bench [--root <dir>] [anim] [cache] [vertex] [particle]
+//
+// With no names every benchmark runs. Run it from (or point --root at) the directory the
+// game runs from; models are resolved through config/pokemon_config.json like the game does.
+//
+//   anim      keyframe sampling (original vs cursor path) on rattata and pidgey, then the
+//             joint palette kernels for 64 joints
+//   cache     staging time of the starter/route1 models, and the .pacmdl read: pre-v6
+//             readPod reader vs the mapped one, cold (page cache dropped, POSIX) and warm
+//   vertex    full vs packed vertex layout for every model under assets/models, with VBO
+//             upload timings (the only one that needs GL: hidden window, see HeadlessGL)
+//   particle  ParticleSystem::update for 100k particles: the old AoS loop and every
+//             kernel path
+
+#include "HeadlessGL.h"
+
+#include "engine/render/JointPalette.h"
+#include "engine/render/Model.h"
+#include "engine/vfx/ParticleSystem.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <initializer_list>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr const char* kModelDir   = "assets/models";
+constexpr const char* kPokemonCfg = "config/pokemon_config.json";
+
+struct Options {
+    std::string root = ".";
+    bool anim = false;
+    bool cache = false;
+    bool vertex = false;
+    bool particle = false;
+};
+
+bool parseArgs(int argc, char** argv, Options& opt)
+{
+    bool any = false;
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        if (a == "--root" && i + 1 < argc) {
+            opt.root = argv[++i];
+            continue;
+        }
+        if (a == "anim")          opt.anim = true;
+        else if (a == "cache")    opt.cache = true;
+        else if (a == "vertex")   opt.vertex = true;
+        else if (a == "particle") opt.particle = true;
+        else {
+            std::cerr << "usage: pac_bench [--root <dir>] [anim] [cache] [vertex] [particle]\n";
+            return false;
+        }
+        any = true;
+    }
+    if (!any) opt.anim = opt.cache = opt.vertex = opt.particle = true;
+    return true;
+}
+
+// "assets/models/<model>" for each pokemon name found in the config (same default as
+// PokemonConfigLoader: <name>.glb).
+std::vector<std::string> modelPaths(std::initializer_list<const char*> names)
+{
+    std::vector<std::string> out;
+
+    nlohmann::json j;
+    std::ifstream cfg(kPokemonCfg);
+    if (!cfg.is_open()) {
+        std::cerr << "[pac_bench] " << kPokemonCfg << " not found\n";
+        return out;
+    }
+    try {
+        cfg >> j;
+    } catch (const std::exception& e) {
+        std::cerr << "[pac_bench] failed to parse " << kPokemonCfg << ": " << e.what() << "\n";
+        return out;
+    }
+
+    for (const char* name : names) {
+        const auto it = j.find(name);
+        if (it == j.end() || !it->is_object()) continue;
+        out.push_back(std::string(kModelDir) + "/" + it->value("model", std::string(name) + ".glb"));
+    }
+    return out;
+}
+
+void runAnimationBenchmark()
+{
+    constexpr int kFramesPerClip = 20000;
+
+    for (const auto& path : modelPaths({ "rattata", "pidgey" })) {
+        Model::StagedLoad staged;
+        auto model = Model::stageLoad(path, staged);
+        if (!staged.ok) {
+            std::cout << "[AnimBench] " << path << " failed to load\n";
+            continue;
+        }
+
+        const auto r = model->benchmarkSampling(kFramesPerClip);
+        const double legacyRate = (r.legacySec > 0.0) ? (double)r.channels / r.legacySec : 0.0;
+        const double cursorRate = (r.cursorSec > 0.0) ? (double)r.channels / r.cursorSec : 0.0;
+
+        std::cout << "[AnimBench] " << path
+                  << " channels=" << r.channels
+                  << " legacy=" << (legacyRate / 1e6) << " Mch/s"
+                  << " cursor=" << (cursorRate / 1e6) << " Mch/s"
+                  << " speedup=" << ((legacyRate > 0.0) ? cursorRate / legacyRate : 0.0) << "x"
+                  << " (checksum " << r.checksum << ")\n";
+    }
+
+    // Joint palette kernels (64 joints ~ a typical Pokemon rig).
+    for (const auto& r : pac_joint_palette::benchmark(64, 50000)) {
+        std::cout << "[AnimBench] joint palette " << pac_simd::pathName(r.path);
+        if (r.supported) std::cout << " " << (r.matricesPerSec / 1e6) << " Mmat/s";
+        else             std::cout << " unsupported";
+        if (r.path == pac_simd::bestAvailablePath()) std::cout << " (active)";
+        std::cout << "\n";
+    }
+}
+
+void runModelCacheBenchmark()
+{
+    constexpr int kWarmIterations = 20;
+
+    for (const auto& path : modelPaths({ "bulbasaur", "charmander", "squirtle", "pidgey", "rattata" })) {
+        // What a loader thread does before the GL upload (no GL here).
+        Model::StagedLoad staged;
+        auto model = Model::stageLoad(path, staged);
+        if (!staged.ok) {
+            std::cout << "[CacheBench] " << path << " failed to load\n";
+            continue;
+        }
+        const auto& t = model->getLoadTiming();
+        std::cout << "[CacheBench] " << path
+                  << " stage=" << staged.stageMs << " ms"
+                  << (staged.fromCache ? " (cache: read " : " (glTF parse)");
+        if (staged.fromCache) std::cout << t.cacheReadMs << " ms)";
+        std::cout << "\n";
+
+        const auto r = Model::benchmarkCacheRead(path, kWarmIterations);
+        if (!r.ok) {
+            std::cout << "[CacheBench] " << path << " no .pacmdl cache to read\n";
+            continue;
+        }
+        std::cout << "[CacheBench] " << path
+                  << " " << (r.fileBytes / 1024) << " KiB";
+        if (r.coldMeasured) {
+            std::cout << " cold legacy/mmap=" << r.legacyColdMs << "/" << r.mmapColdMs << " ms";
+        } else {
+            std::cout << " cold n/a (page cache can't be dropped)";
+        }
+        std::cout << " warm legacy/mmap=" << r.legacyWarmMs << "/" << r.mmapWarmMs << " ms\n";
+    }
+}
+
+bool runVertexLayoutBenchmark()
+{
+    constexpr int kUploadIterations = 20;
+
+    HeadlessGL gl;
+    if (!gl.create("VertexBench")) return false;
+
+    std::vector<std::string> paths;
+    std::error_code ec;
+    for (const auto& e : fs::recursive_directory_iterator(kModelDir, ec)) {
+        const std::string ext = e.path().extension().string();
+        if (e.is_regular_file() && (ext == ".glb" || ext == ".gltf")) paths.push_back(e.path().generic_string());
+    }
+    std::sort(paths.begin(), paths.end());
+
+    uint64_t fullTotal = 0, packedTotal = 0;
+    double fullMsTotal = 0.0, packedMsTotal = 0.0;
+
+    for (const auto& path : paths) {
+        const auto r = Model::benchmarkVertexLayouts(path, kUploadIterations);
+        if (!r.ok) {
+            std::cout << "[VertexBench] " << path << " failed to parse\n";
+            continue;
+        }
+
+        std::cout << "[VertexBench] " << path << " " << r.vertexCount << " verts"
+                  << " full " << (r.fullBytes / 1024) << " KiB / " << r.fullUploadMs << " ms";
+        if (r.packable) {
+            std::cout << " | packed " << (r.packedBytes / 1024) << " KiB / " << r.packedUploadMs << " ms"
+                      << ", max pos error " << r.maxPositionError;
+            packedTotal += r.packedBytes;
+            packedMsTotal += r.packedUploadMs;
+        } else {
+            std::cout << " | packed n/a (joint index > 255)";
+            packedTotal += r.fullBytes;
+            packedMsTotal += r.fullUploadMs;
+        }
+        std::cout << "\n";
+
+        fullTotal += r.fullBytes;
+        fullMsTotal += r.fullUploadMs;
+    }
+
+    std::cout << "[VertexBench] " << paths.size() << " models: full " << (fullTotal / 1024) << " KiB / "
+              << fullMsTotal << " ms, packed " << (packedTotal / 1024) << " KiB / " << packedMsTotal << " ms\n";
+    return true;
+}
+
+void runParticleBenchmark()
+{
+    constexpr uint32_t kParticles = 100000;
+    constexpr int      kFrames    = 600;
+
+    const auto results = ParticleSystem::benchmarkUpdate(kParticles, kFrames);
+    const double baseline = results.empty() ? 0.0 : results.front().msPerFrame;
+    for (const auto& r : results) {
+        std::cout << "[ParticleBench] " << kParticles << " particles " << r.name;
+        if (r.supported) {
+            std::cout << " " << r.msPerFrame << " ms/frame " << (r.particlesPerSec / 1e6) << " Mp/s";
+            if (r.msPerFrame > 0.0) std::cout << " (" << (baseline / r.msPerFrame) << "x vs aos)";
+        } else {
+            std::cout << " unsupported";
+        }
+        std::cout << "\n";
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) return 2;
+
+    std::error_code ec;
+    fs::current_path(opt.root, ec);
+    if (ec) {
+        std::cerr << "[pac_bench] cannot enter " << opt.root << ": " << ec.message() << "\n";
+        return 2;
+    }
+
+    int failed = 0;
+    if (opt.anim)     runAnimationBenchmark();
+    if (opt.cache)    runModelCacheBenchmark();
+    if (opt.vertex && !runVertexLayoutBenchmark()) ++failed;
+    if (opt.particle) runParticleBenchmark();
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,375 @@
+// src/tools/PacCook.cpp
+//
+// pac_cook: builds every .pacmdl cache offline, without a window or GL context.
+//
+//   pac_cook [--root <dir>] [--jobs <n>] [--force] [--no-bc] [--full-vertices] [--no-index-opt] [--no-lods] [--no-anim-bake] [--no-anim-compress]
+//   pac_cook [--root <dir>] [--jobs <n>] --mesh-stats
+//
+// Run it from (or point --root at) the directory the game runs from: cache files are
+// keyed by the model path string ("assets/models/<file>") relative to that directory,
+// exactly as ResourceManager::getModel sees it.
+// The build runs it only when configured with -DPAC_COOK_ON_BUILD=ON. --jobs is capped
+// at the hardware thread count.
+//
+// Textures are written with mip chains and BC1/BC3-compressed; --no-bc keeps them RGBA8.
+// Vertices use the packed 20-byte layout where possible; --full-vertices keeps floats.
+// Triangles and vertices are reordered for the GPU vertex caches; --no-index-opt keeps the
+// source order. --mesh-stats writes nothing and prints per-model ACMR (average cache miss
+// ratio) before/after that reordering, plus index buffer sizes. Up to three simplified
+// LODs are generated per submesh; --no-lods writes full resolution only. Clips are baked
+// into a 30 Hz joint palette atlas for crowd rendering; --no-anim-bake leaves it out.
+// Clip keyframes are compressed (constant tracks stripped, keys reduced within tolerance,
+// rotations stored in 48 bits) and each clip's size and worst joint error is printed;
+// --no-anim-compress stores them as loaded.
+
+#include "engine/render/Model.h"
+#include "engine/utils/WorkerPool.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr const char* kModelDir   = "assets/models";
+constexpr const char* kPokemonCfg = "config/pokemon_config.json";
+
+struct Options {
+    std::string root = ".";
+    unsigned    jobs = 0; // 0 => hardware_concurrency (also the cap)
+    Model::CookOptions cook;
+    bool        meshStats = false;
+};
+
+bool parseArgs(int argc, char** argv, Options& opt)
+{
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        if (a == "--force") {
+            opt.cook.force = true;
+        } else if (a == "--no-bc") {
+            opt.cook.compressTextures = false;
+        } else if (a == "--full-vertices") {
+            opt.cook.packVertices = false;
+        } else if (a == "--no-index-opt") {
+            opt.cook.optimizeIndices = false;
+        } else if (a == "--no-lods") {
+            opt.cook.generateLods = false;
+        } else if (a == "--no-anim-bake") {
+            opt.cook.bakeAnimations = false;
+        } else if (a == "--no-anim-compress") {
+            opt.cook.compressAnimations = false;
+        } else if (a == "--mesh-stats") {
+            opt.meshStats = true;
+        } else if (a == "--root" && i + 1 < argc) {
+            opt.root = argv[++i];
+        } else if (a == "--jobs" && i + 1 < argc) {
+            opt.jobs = (unsigned)std::max(1, std::atoi(argv[++i]));
+        } else {
+            std::cerr << "usage: pac_cook [--root <dir>] [--jobs <n>] [--force] [--no-bc] [--full-vertices] [--no-index-opt] [--no-lods] [--no-anim-bake] [--no-anim-compress]\n"
+                         "       pac_cook [--root <dir>] [--jobs <n>] --mesh-stats\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+// Models referenced by the pokemon config first (same path strings the game builds),
+// then anything else found under assets/models.
+std::vector<std::string> collectModels()
+{
+    std::vector<std::string> out;
+    std::unordered_set<std::string> seen;
+
+    auto add = [&](const std::string& path) {
+        if (seen.insert(path).second) out.push_back(path);
+    };
+
+    std::ifstream cfg(kPokemonCfg);
+    if (cfg.is_open()) {
+        try {
+            nlohmann::json j;
+            cfg >> j;
+            for (auto it = j.begin(); it != j.end(); ++it) {
+                const auto model = it.value().find("model");
+                if (model == it.value().end() || !model->is_string()) continue;
+
+                const std::string path = std::string(kModelDir) + "/" + model->get<std::string>();
+                if (fs::exists(path)) add(path);
+                else std::cerr << "[pac_cook] " << it.key() << ": missing model " << path << "\n";
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "[pac_cook] failed to parse " << kPokemonCfg << ": " << e.what() << "\n";
+        }
+    } else {
+        std::cerr << "[pac_cook] " << kPokemonCfg << " not found, scanning " << kModelDir << " only\n";
+    }
+
+    std::vector<std::string> scanned;
+    std::error_code ec;
+    for (const auto& e : fs::recursive_directory_iterator(kModelDir, ec)) {
+        if (!e.is_regular_file()) continue;
+        std::string ext = e.path().extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+        if (ext != ".glb" && ext != ".gltf") continue;
+        scanned.push_back((fs::path(kModelDir) / fs::relative(e.path(), kModelDir)).generic_string());
+    }
+    std::sort(scanned.begin(), scanned.end());
+    for (const auto& p : scanned) add(p);
+
+    return out;
+}
+
+const char* statusName(Model::CookResult::Status s)
+{
+    switch (s) {
+        case Model::CookResult::Status::Cooked:   return "cooked";
+        case Model::CookResult::Status::UpToDate: return "up-to-date";
+        case Model::CookResult::Status::Failed:
+        default:                                  return "FAILED";
+    }
+}
+
+// Runs fn(i) for every model index on `jobs` threads.
+template <typename Fn>
+void runParallel(size_t count, unsigned jobs, Fn&& fn)
+{
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+        for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) fn(i);
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(jobs);
+    for (unsigned t = 0; t < jobs; ++t) threads.emplace_back(worker);
+    for (auto& t : threads) t.join();
+}
+
+int printMeshStats(const std::vector<std::string>& models, unsigned jobs)
+{
+    std::vector<Model::MeshStats> stats(models.size());
+    runParallel(models.size(), jobs, [&](size_t i) { stats[i] = Model::analyzeMesh(models[i]); });
+
+    size_t nameWidth = 5;
+    for (const auto& m : models) nameWidth = std::max(nameWidth, m.size());
+
+    int failed = 0;
+    double trisTotal = 0.0, missesBefore = 0.0, missesAfter = 0.0;
+    uint64_t idxBefore = 0, idxAfter = 0;
+
+    std::printf("\n%-*s  %8s  %8s  %9s  %11s  %10s  %10s  %12s  %12s\n", (int)nameWidth,
+                "asset", "verts", "tris", "submeshes", "16-bit", "ACMR src", "ACMR opt", "idx KiB src", "idx KiB opt");
+    for (size_t i = 0; i < models.size(); ++i) {
+        const auto& s = stats[i];
+        if (!s.ok) {
+            std::printf("%-*s  FAILED\n", (int)nameWidth, models[i].c_str());
+            ++failed;
+            continue;
+        }
+        std::printf("%-*s  %8u  %8u  %9u  %5u/%-5u  %10.3f  %10.3f  %12.1f  %12.1f\n", (int)nameWidth, models[i].c_str(),
+                    s.vertexCount, s.triangleCount, s.submeshCount, s.submeshes16, s.submeshCount,
+                    s.acmrBefore, s.acmrAfter,
+                    (double)s.indexBytesBefore / 1024.0, (double)s.indexBytesAfter / 1024.0);
+
+        trisTotal    += s.triangleCount;
+        missesBefore += (double)s.acmrBefore * s.triangleCount;
+        missesAfter  += (double)s.acmrAfter * s.triangleCount;
+        idxBefore    += s.indexBytesBefore;
+        idxAfter     += s.indexBytesAfter;
+    }
+
+    if (trisTotal > 0.0) {
+        std::printf("\n%zu assets, %.0f triangles: ACMR %.3f -> %.3f (16-entry FIFO), indices %.1f KiB -> %.1f KiB\n",
+                    models.size(), trisTotal, missesBefore / trisTotal, missesAfter / trisTotal,
+                    (double)idxBefore / 1024.0, (double)idxAfter / 1024.0);
+    }
+    return failed ? 1 : 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) return 2;
+
+    std::error_code ec;
+    fs::current_path(opt.root, ec);
+    if (ec) {
+        std::cerr << "[pac_cook] cannot enter " << opt.root << ": " << ec.message() << "\n";
+        return 2;
+    }
+
+    const std::vector<std::string> models = collectModels();
+    if (models.empty()) {
+        std::cerr << "[pac_cook] no models found under " << fs::absolute(kModelDir) << "\n";
+        return 1;
+    }
+
+    // Jobs and the image decode pool share one budget of hardware threads; each job also
+    // decodes on its own thread, so nested parallelism never oversubscribes the machine.
+    const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+    const unsigned jobs = std::min({ opt.jobs ? opt.jobs : hw, hw, (unsigned)models.size() });
+    WorkerPool::getInstance().setThreadCount(hw - jobs);
+
+    if (opt.meshStats) return printMeshStats(models, jobs);
+
+    fs::create_directories(fs::path("cache") / "models", ec);
+
+    std::vector<Model::CookResult> results(models.size());
+
+    const auto t0 = std::chrono::steady_clock::now();
+
+    runParallel(models.size(), jobs, [&](size_t i) { results[i] = Model::cookCache(models[i], opt.cook); });
+
+    const double wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+
+    // ---- Timing table ----
+    size_t nameWidth = 5;
+    for (const auto& m : models) nameWidth = std::max(nameWidth, m.size());
+
+    int cooked = 0, upToDate = 0, failed = 0;
+    double cpuMs = 0.0, decodeWallMs = 0.0, decodeSerialMs = 0.0;
+    uint64_t texRgbaBytes = 0, texStoredBytes = 0;
+    uint64_t vtxFullBytes = 0, vtxStoredBytes = 0;
+    uint64_t idxFullBytes = 0, idxStoredBytes = 0;
+    uint64_t lodTriangles[pac_model_types::kMaxMeshLods] = {};
+    uint32_t lodLevels = 1;
+    uint64_t bakedFrames = 0, bakedBytes = 0;
+
+    std::printf("\n%-*s  %-10s  %10s  %10s  %10s  %6s  %10s  %7s  %10s  %-6s  %10s  %s\n", (int)nameWidth,
+                "asset", "status", "parse ms", "write ms", "cache KiB", "images", "decode ms", "speedup", "tex KiB",
+                "vtx", "vtx KiB", "tris per LOD");
+    for (size_t i = 0; i < models.size(); ++i) {
+        const auto& r = results[i];
+        const auto& im = r.import;
+        const double speedup = (im.decodeWallMs > 0.0) ? im.decodeSerialMs / im.decodeWallMs : 0.0;
+        const bool packed = (r.vertexLayout == pac_model_types::VertexLayout::Packed);
+
+        std::string lods = "-";
+        if (r.status == Model::CookResult::Status::Cooked) {
+            lods.clear();
+            for (uint32_t l = 0; l < r.lodCount; ++l) {
+                if (l) lods += "/";
+                lods += std::to_string(r.lodTriangles[l]);
+            }
+        }
+
+        std::printf("%-*s  %-10s  %10.1f  %10.1f  %10.1f  %6u  %10.1f  %6.2fx  %10.1f  %-6s  %10.1f  %s\n", (int)nameWidth, models[i].c_str(),
+                    statusName(r.status), r.parseMs, r.writeMs, (double)r.cacheBytes / 1024.0,
+                    im.imageCount, im.decodeWallMs, speedup, (double)r.textures.storedBytes / 1024.0,
+                    r.vertexBytes ? (packed ? "packed" : "full") : "-", (double)r.vertexBytes / 1024.0, lods.c_str());
+
+        cpuMs += r.parseMs + r.writeMs;
+        decodeWallMs += im.decodeWallMs;
+        decodeSerialMs += im.decodeSerialMs;
+        texRgbaBytes += r.textures.rgbaBytes;
+        texStoredBytes += r.textures.storedBytes;
+        vtxFullBytes += r.fullVertexBytes;
+        vtxStoredBytes += r.vertexBytes;
+        idxFullBytes += r.fullIndexBytes;
+        idxStoredBytes += r.indexBytes;
+        bakedFrames += r.bakedFrames;
+        bakedBytes += r.bakedBytes;
+        if (r.status == Model::CookResult::Status::Cooked) {
+            lodLevels = std::max(lodLevels, r.lodCount);
+            for (uint32_t l = 0; l < pac_model_types::kMaxMeshLods; ++l) lodTriangles[l] += r.lodTriangles[l];
+        }
+        switch (r.status) {
+            case Model::CookResult::Status::Cooked:   ++cooked; break;
+            case Model::CookResult::Status::UpToDate: ++upToDate; break;
+            default:                                  ++failed; break;
+        }
+    }
+
+    std::printf("\n%zu assets: %d cooked, %d up-to-date, %d failed | %u threads, wall %.1f ms, summed %.1f ms\n",
+                models.size(), cooked, upToDate, failed, jobs, wallMs, cpuMs);
+    if (decodeWallMs > 0.0) {
+        std::printf("image decode: wall %.1f ms, serial %.1f ms, speedup %.2fx\n",
+                    decodeWallMs, decodeSerialMs, decodeSerialMs / decodeWallMs);
+    }
+
+    if (texRgbaBytes > 0) {
+        std::printf("textures: %.1f KiB stored vs %.1f KiB as RGBA8 mip chains (%.1f%%)\n",
+                    (double)texStoredBytes / 1024.0, (double)texRgbaBytes / 1024.0,
+                    100.0 * (double)texStoredBytes / (double)texRgbaBytes);
+    }
+
+    if (vtxFullBytes > 0) {
+        std::printf("vertices: %.1f KiB stored vs %.1f KiB in the full layout (%.1f%%)\n",
+                    (double)vtxStoredBytes / 1024.0, (double)vtxFullBytes / 1024.0,
+                    100.0 * (double)vtxStoredBytes / (double)vtxFullBytes);
+    }
+
+    if (idxFullBytes > 0) {
+        std::printf("indices: %.1f KiB stored vs %.1f KiB as uint32 (%.1f%%)\n",
+                    (double)idxStoredBytes / 1024.0, (double)idxFullBytes / 1024.0,
+                    100.0 * (double)idxStoredBytes / (double)idxFullBytes);
+    }
+
+    if (lodLevels > 1 && lodTriangles[0] > 0) {
+        std::printf("LODs (triangles, %% of LOD0):");
+        for (uint32_t l = 0; l < lodLevels; ++l) {
+            std::printf(" %s%llu (%.0f%%)", l ? "/ " : "", (unsigned long long)lodTriangles[l],
+                        100.0 * (double)lodTriangles[l] / (double)lodTriangles[0]);
+        }
+        std::printf("\n");
+    }
+
+    if (bakedFrames > 0) {
+        std::printf("baked animation: %llu frames, %.1f KiB\n",
+                    (unsigned long long)bakedFrames, (double)bakedBytes / 1024.0);
+    }
+
+    // ---- Animation compression, per clip ----
+    uint64_t clipRawBytes = 0, clipStoredBytes = 0, clipKeysBefore = 0, clipKeysAfter = 0;
+    uint32_t clipCount = 0, channelsRemoved = 0;
+    float worstError = 0.0f;
+    for (size_t i = 0; i < models.size(); ++i) {
+        const auto& clips = results[i].clips;
+        if (clips.empty()) continue;
+        if (clipCount == 0) {
+            std::printf("\n%-*s  %-24s  %15s  %9s  %9s  %6s  %10s\n", (int)nameWidth,
+                        "asset", "clip", "keys", "KiB src", "KiB out", "const", "max err");
+        }
+        for (const auto& c : clips) {
+            std::printf("%-*s  %-24s  %7u->%-6u  %9.1f  %9.1f  %6u  %10.6f\n", (int)nameWidth, models[i].c_str(),
+                        c.name.empty() ? "(unnamed)" : c.name.c_str(), c.keysBefore, c.keysAfter,
+                        (double)c.rawBytes / 1024.0, (double)c.compressedBytes / 1024.0,
+                        c.constantTracks, c.maxJointError);
+            clipRawBytes    += c.rawBytes;
+            clipStoredBytes += c.compressedBytes;
+            clipKeysBefore  += c.keysBefore;
+            clipKeysAfter   += c.keysAfter;
+            channelsRemoved += c.channelsRemoved;
+            worstError = std::max(worstError, c.maxJointError);
+            ++clipCount;
+        }
+    }
+
+    if (clipRawBytes > 0) {
+        std::printf("\nanimation: %u clips, %.1f KiB stored vs %.1f KiB as loaded (%.1f%%, %.1f KiB saved), "
+                    "keys %llu -> %llu, %u channels dropped, max joint error %.6f\n",
+                    clipCount, (double)clipStoredBytes / 1024.0, (double)clipRawBytes / 1024.0,
+                    100.0 * (double)clipStoredBytes / (double)clipRawBytes,
+                    (double)(clipRawBytes - clipStoredBytes) / 1024.0,
+                    (unsigned long long)clipKeysBefore, (unsigned long long)clipKeysAfter,
+                    channelsRemoved, worstError);
+    }
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,63 @@
+// src/tools/PacParticleCheck.cpp
+//
+// pac_particle_check: simulates the same particle emissions on the CPU kernels and on the
+// transform feedback backend and compares the survivors (ParticleSystem::checkGpuSimulation).
+//
+//   pac_particle_check [--root <dir>] [--frames <n>]
+//
+// --root is the directory holding assets/ (the sim shaders load from there). Exit code 0
+// when every particle matches within tolerance, 1 on a mismatch or when the GPU backend
+// can't be built, 2 when there is no GL context. Registered with ctest; runs on Mesa
+// llvmpipe without a display (see HeadlessGL).
+
+#include "HeadlessGL.h"
+
+#include "engine/vfx/ParticleSystem.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+namespace fs = std::filesystem;
+
+int main(int argc, char** argv)
+{
+    std::string root = ".";
+    int frames = 120;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        if (a == "--root" && i + 1 < argc) {
+            root = argv[++i];
+        } else if (a == "--frames" && i + 1 < argc) {
+            frames = std::max(1, std::atoi(argv[++i]));
+        } else {
+            std::cerr << "usage: pac_particle_check [--root <dir>] [--frames <n>]\n";
+            return 2;
+        }
+    }
+
+    std::error_code ec;
+    fs::current_path(root, ec);
+    if (ec) {
+        std::cerr << "[pac_particle_check] cannot enter " << root << ": " << ec.message() << "\n";
+        return 2;
+    }
+
+    HeadlessGL gl;
+    if (!gl.create("pac_particle_check")) return 2;
+
+    const auto r = ParticleSystem::checkGpuSimulation(frames);
+    if (!r.gpuAvailable) {
+        std::cerr << "[pac_particle_check] FAIL: GPU backend unavailable (transform feedback program failed)\n";
+        return 1;
+    }
+
+    std::cout << "[pac_particle_check] " << (r.passed ? "PASS" : "FAIL")
+              << " " << frames << " frames, cpu/gpu particles " << r.cpuCount << "/" << r.gpuCount
+              << " unmatched " << r.unmatched
+              << " max pos/vel error " << r.maxPosError << "/" << r.maxVelError << "\n";
+    return r.passed ? 0 : 1;
+}